@@ -0,0 +1,19 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+/// DirectXMath includes `sal.h`, which only ships with MSVC. Annotations it uses are empty outside of the analyzer.
+/// Only on the include path of non-MSVC builds, see `Base/CMakeLists.txt`.
+
+#define _Analysis_assume_(x)
+#define _In_
+#define _In_reads_(x)
+#define _In_reads_bytes_(x)
+#define _Out_
+#define _Out_opt_
+#define _Out_writes_(x)
+#define _Out_writes_bytes_(x)
+#define _Success_(x)
+#define _Use_decl_annotations_
\ No newline at end of file
@@ -4,15 +4,11 @@
 
 namespace lr
 {
-    BufferStreamMemoyWatcher *g_pBSWatcher;
-
     bool BaseApp::InitApp(ApplicationDesc const &desc)
     {
         Logger::Init();
         LOG_TRACE("Initializing Lorr...");
 
-        g_pBSWatcher = new BufferStreamMemoyWatcher(false);
-
         //* Core features
         m_Window.Init(desc.Title, 0, desc.Width, desc.Height, desc.Flags);
 
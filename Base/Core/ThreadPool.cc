@@ -0,0 +1,145 @@
+#include "ThreadPool.hh"
+
+namespace lr
+{
+    ThreadPool::~ThreadPool()
+    {
+        Shutdown();
+    }
+
+    void ThreadPool::Init(u32 threadCount)
+    {
+        if (threadCount == 0) threadCount = EA::Thread::GetProcessorCount();
+        if (threadCount == 0) threadCount = 1;
+
+        LOG_TRACE("Initializing ThreadPool with {} threads...", threadCount);
+
+        m_Exit = false;
+        m_pRanges.reset(new ChunkRange[threadCount]);
+
+        // Calling thread is always the last worker
+        for (u32 i = 0; i < threadCount - 1; i++)
+        {
+            Worker *pWorker = m_Workers.emplace_back(new Worker).get();
+            pWorker->pPool = this;
+            pWorker->ID = i;
+            pWorker->Thread.Begin(WorkerEntry, pWorker);
+        }
+    }
+
+    void ThreadPool::Shutdown()
+    {
+        if (m_Workers.empty()) return;
+
+        m_Exit = true;
+        for (u32 i = 0; i < m_Workers.size(); i++) m_WakeSema.Post();
+        for (auto &pWorker : m_Workers) pWorker->Thread.WaitForEnd();
+
+        m_Workers.clear();
+    }
+
+    void ThreadPool::ParallelFor(u32 count, u32 grainSize, const RangeFunc &func)
+    {
+        if (count == 0) return;
+
+        EA::Thread::AutoMutex lock(m_JobMutex);
+
+        m_pJobFunc = &func;
+        m_JobCount = count;
+        m_JobGrain = eastl::max(grainSize, 1u);
+
+        u32 chunkCount = (count + m_JobGrain - 1) / m_JobGrain;
+        u32 threadCount = GetThreadCount();
+
+        for (u32 i = 0; i < threadCount; i++)
+        {
+            u64 begin = ((u64)chunkCount * i) / threadCount;
+            u64 end = ((u64)chunkCount * (i + 1)) / threadCount;
+            m_pRanges[i].Range = begin | (end << 32);
+        }
+
+        // Don't wake up threads that won't have anything to do, their share gets stolen
+        u32 wakeCount = eastl::min<u32>(chunkCount - 1, m_Workers.size());
+
+        for (u32 i = 0; i < wakeCount; i++) m_WakeSema.Post();
+
+        RunJob(m_Workers.size());
+
+        for (u32 i = 0; i < wakeCount; i++) m_DoneSema.Wait();
+
+        m_pJobFunc = nullptr;
+    }
+
+    intptr_t ThreadPool::WorkerEntry(void *pContext)
+    {
+        Worker *pWorker = (Worker *)pContext;
+        ThreadPool *pPool = pWorker->pPool;
+
+        while (true)
+        {
+            pPool->m_WakeSema.Wait();
+            if (pPool->m_Exit) break;
+
+            pPool->RunJob(pWorker->ID);
+            pPool->m_DoneSema.Post();
+        }
+
+        return 0;
+    }
+
+    void ThreadPool::RunJob(u32 workerID)
+    {
+        eastl::atomic<u64> &ownRange = m_pRanges[workerID].Range;
+
+        while (true)
+        {
+            u64 range = ownRange.load();
+            u32 begin = range & 0xffffffff;
+            u32 end = range >> 32;
+
+            if (begin >= end)
+            {
+                if (!StealChunks(workerID)) break;
+                continue;
+            }
+
+            if (!ownRange.compare_exchange_weak(range, (u64)(begin + 1) | ((u64)end << 32))) continue;
+
+            u32 itemBegin = begin * m_JobGrain;
+            u32 itemEnd = eastl::min(itemBegin + m_JobGrain, m_JobCount);
+            (*m_pJobFunc)(itemBegin, itemEnd, workerID);
+        }
+    }
+
+    bool ThreadPool::StealChunks(u32 workerID)
+    {
+        u32 threadCount = GetThreadCount();
+
+        for (u32 i = 1; i < threadCount; i++)
+        {
+            eastl::atomic<u64> &victimRange = m_pRanges[(workerID + i) % threadCount].Range;
+
+            u64 range = victimRange.load();
+            u32 begin = range & 0xffffffff;
+            u32 end = range >> 32;
+
+            while (begin < end)
+            {
+                u32 mid = end - (end - begin + 1) / 2;
+
+                if (victimRange.compare_exchange_weak(range, (u64)begin | ((u64)mid << 32)))
+                {
+                    // Our range is empty, nobody else can write to it
+                    m_pRanges[workerID].Range = (u64)mid | ((u64)end << 32);
+                    return true;
+                }
+
+                begin = range & 0xffffffff;
+                end = range >> 32;
+            }
+        }
+
+        return false;
+    }
+
+}  // namespace lr
\ No newline at end of file
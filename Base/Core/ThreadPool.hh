@@ -0,0 +1,73 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <EASTL/functional.h>
+#include <EASTL/unique_ptr.h>
+
+#include <eathread/eathread_thread.h>
+#include <eathread/eathread_semaphore.h>
+#include <eathread/eathread_mutex.h>
+
+namespace lr
+{
+    class ThreadPool
+    {
+    public:
+        /// `begin` and `end` are item indices, `workerID` is in [0, GetThreadCount())
+        using RangeFunc = eastl::function<void(u32 begin, u32 end, u32 workerID)>;
+
+        ~ThreadPool();
+
+        /// 0 means one thread per logical processor, calling thread counts as a worker
+        void Init(u32 threadCount = 0);
+        void Shutdown();
+
+        /// Splits [0, count) into `grainSize` sized chunks and blocks until all of them are processed.
+        /// Every thread starts with an even share of chunks and steals half of a busy thread's
+        /// remaining chunks once it runs dry. Calling thread joins the work.
+        /// Not reentrant, do not call from inside `func`.
+        void ParallelFor(u32 count, u32 grainSize, const RangeFunc &func);
+
+    public:
+        u32 GetThreadCount()
+        {
+            return m_Workers.size() + 1;
+        }
+
+    private:
+        static intptr_t WorkerEntry(void *pContext);
+        void RunJob(u32 workerID);
+        bool StealChunks(u32 workerID);
+
+        struct Worker
+        {
+            ThreadPool *pPool = nullptr;
+            u32 ID = 0;
+            EA::Thread::Thread Thread;
+        };
+
+        /// Chunk range [begin, end) of each worker packed as `begin | end << 32`,
+        /// owner pops from the front, thieves cut from the back
+        struct alignas(64) ChunkRange
+        {
+            eastl::atomic<u64> Range = 0;
+        };
+
+        eastl::vector<eastl::unique_ptr<Worker>> m_Workers;
+        eastl::unique_ptr<ChunkRange[]> m_pRanges;
+
+        EA::Thread::Semaphore m_WakeSema{ 0 };
+        EA::Thread::Semaphore m_DoneSema{ 0 };
+        EA::Thread::Mutex m_JobMutex;
+
+        const RangeFunc *m_pJobFunc = nullptr;
+        u32 m_JobCount = 0;
+        u32 m_JobGrain = 1;
+
+        bool m_Exit = false;
+    };
+
+}  // namespace lr
\ No newline at end of file
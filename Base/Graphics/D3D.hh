@@ -30,6 +30,10 @@ namespace lr::D3D
             case TextureFormat::DEPTH32F: return DXGI_FORMAT_D32_FLOAT;
             case TextureFormat::DEPTH24_STENCIL8: return DXGI_FORMAT_D24_UNORM_S8_UINT;
 
+            case TextureFormat::RGBA16F: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case TextureFormat::R11G11B10F: return DXGI_FORMAT_R11G11B10_FLOAT;
+            case TextureFormat::RGB9E5: return DXGI_FORMAT_R9G9B9E5_SHAREDEXP;
+
             default: return DXGI_FORMAT_UNKNOWN;
         }
     }
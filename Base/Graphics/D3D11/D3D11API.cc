@@ -439,6 +439,39 @@ namespace lr
         m_pContext->CopyResource(pCPUTexture->GetHandle(), pGPUTexture->GetHandle());
     }
 
+    void D3D11API::ReadGPUTexture(Texture *pTexture, u8 *pOutput)
+    {
+        D3D11_TEXTURE2D_DESC textureDesc = {};
+        pTexture->GetHandle()->GetDesc(&textureDesc);
+
+        textureDesc.Usage = D3D11_USAGE_STAGING;
+        textureDesc.BindFlags = 0;
+        textureDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+        textureDesc.MiscFlags = 0;
+
+        ID3D11Texture2D *pStaging = nullptr;
+
+        HRESULT hr;
+        HRCall(m_pDevice->CreateTexture2D(&textureDesc, nullptr, &pStaging), "Failed to create staging Texture2D!");
+
+        m_pContext->CopyResource(pStaging, pTexture->GetHandle());
+
+        D3D11_MAPPED_SUBRESOURCE mappedResc = {};
+        if (SUCCEEDED(m_pContext->Map(pStaging, 0, D3D11_MAP_READ, 0, &mappedResc)))
+        {
+            u32 rowSize = TextureFormatToSize(pTexture->GetFormat()) * textureDesc.Width;
+
+            for (u32 y = 0; y < textureDesc.Height; y++)
+            {
+                memcpy(pOutput + y * rowSize, (u8 *)mappedResc.pData + y * mappedResc.RowPitch, rowSize);
+            }
+
+            m_pContext->Unmap(pStaging, 0);
+        }
+
+        SAFE_RELEASE(pStaging);
+    }
+
     void D3D11API::SetShader(Shader *pShader)
     {
         ShaderType type = pShader->GetType();
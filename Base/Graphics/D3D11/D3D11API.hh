@@ -68,6 +68,9 @@ namespace lr
 
         void MapBuffer(RenderBuffer *pBuffer, void *pData, u32 dataSize);
         void GetGPUTexture(Texture *pCPUTexture, Texture *pGPUTexture);
+        /// Copies first mip of `pTexture` through a staging texture, blocks until GPU is done.
+        /// Rows are tightly packed, `pOutput` has to hold `width * height * TextureFormatToSize(format)` bytes.
+        void ReadGPUTexture(Texture *pTexture, u8 *pOutput);
 
         /// SHADERS  ///
         void SetShader(Shader *pShader);
@@ -0,0 +1,53 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+namespace lr
+{
+    enum class TextureFormat : u16
+    {
+        Unidentified,  //! Throw error
+        BC1,
+
+        RGBA8,    /// Each channel is u8, packed into normalized u32
+        RGBA16,   ///
+        RGBA32F,  /// Each channel is float
+        BGRA8,
+        R24TG8T,           /// R channel is 24 bits, G channel is 8 bits
+        R32T,              /// R channel is 32 bits typeless
+        R32U,              /// R channel is 32 bits u32
+        R32F,              /// R channel is 32 bits float
+        DEPTH32F,          /// Depth format, A channel is float
+        DEPTH24_STENCIL8,  /// Z-Buffer format, 24 bits for depth, 8 bits for stencil
+
+        // Packed HDR formats, appended so stored format values stay valid
+        RGBA16F,     /// Each channel is half float
+        R11G11B10F,  /// Unsigned floats packed into u32, 6/6/5 bit mantissas and 5 bit exponents, no alpha
+        RGB9E5,      /// 9 bit mantissas with a shared 5 bit exponent packed into u32, no alpha
+    };
+
+    constexpr u32 TextureFormatToSize(TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::BC1: return sizeof(u8);
+            case TextureFormat::BGRA8: return sizeof(u8) * 4;
+            case TextureFormat::RGBA8: return sizeof(u8) * 4;
+            case TextureFormat::RGBA16: return sizeof(u16) * 4;
+            case TextureFormat::RGBA32F: return sizeof(float) * 4;
+            case TextureFormat::R24TG8T: return sizeof(u32);
+            case TextureFormat::R32T:
+            case TextureFormat::R32U: return sizeof(u32);
+            case TextureFormat::R32F: return sizeof(float);
+            case TextureFormat::DEPTH32F: return sizeof(float);
+            case TextureFormat::DEPTH24_STENCIL8: return sizeof(u32);
+            case TextureFormat::RGBA16F: return sizeof(u16) * 4;
+            case TextureFormat::R11G11B10F: return sizeof(u32);
+            case TextureFormat::RGB9E5: return sizeof(u32);
+            default: return 0;
+        }
+    }
+
+}  // namespace lr
\ No newline at end of file
@@ -5,6 +5,10 @@
 
 namespace lr
 {
+    // Lives here rather than in `BaseApp` so tools without an app can use streams
+    static BufferStreamMemoyWatcher s_BSWatcher(false);
+    BufferStreamMemoyWatcher *g_pBSWatcher = &s_BSWatcher;
+
     void BufferStreamMemoyWatcher::Allocated(size_t size)
     {
         if (m_Log)
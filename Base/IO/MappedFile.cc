@@ -0,0 +1,110 @@
+#include "MappedFile.hh"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lr
+{
+    MappedFile::MappedFile(eastl::string_view path)
+    {
+        Open(path);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(eastl::string_view path)
+    {
+        if (IsOK()) Close();
+
+        HANDLE file = CreateFileA(path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        m_File = file;
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_Mapping)
+        {
+            Close();
+            return false;
+        }
+
+        m_pData = (const u8 *)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!m_pData)
+        {
+            Close();
+            return false;
+        }
+
+        m_Size = fileSize.QuadPart;
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_pData) UnmapViewOfFile(m_pData);
+        if (m_Mapping) CloseHandle(m_Mapping);
+        if (m_File) CloseHandle(m_File);
+
+        m_pData = nullptr;
+        m_Size = 0;
+        m_Mapping = nullptr;
+        m_File = nullptr;
+    }
+#else
+    bool MappedFile::Open(eastl::string_view path)
+    {
+        if (IsOK()) Close();
+
+        m_File = open(path.data(), O_RDONLY);
+        if (m_File < 0) return false;
+
+        struct stat fileStat = {};
+        if (fstat(m_File, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            Close();
+            return false;
+        }
+
+        void *pData = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, m_File, 0);
+        if (pData == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+
+        m_pData = (const u8 *)pData;
+        m_Size = fileStat.st_size;
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_pData) munmap((void *)m_pData, m_Size);
+        if (m_File >= 0) close(m_File);
+
+        m_pData = nullptr;
+        m_Size = 0;
+        m_File = -1;
+    }
+#endif
+
+}  // namespace lr
\ No newline at end of file
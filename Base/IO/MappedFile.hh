@@ -0,0 +1,49 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+namespace lr
+{
+    /// Read-only memory mapped file, pages are loaded by the OS on first access
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(eastl::string_view path);
+        ~MappedFile();
+
+        bool Open(eastl::string_view path);
+        void Close();
+
+    public:
+        const u8 *GetData() const
+        {
+            return m_pData;
+        }
+
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+        bool IsOK() const
+        {
+            return m_pData;
+        }
+
+    private:
+        const u8 *m_pData = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        // HANDLEs, kept opaque so the header doesn't need Windows.h
+        void *m_File = nullptr;
+        void *m_Mapping = nullptr;
+#else
+        int m_File = -1;
+#endif
+    };
+
+}  // namespace lr
\ No newline at end of file
@@ -1,42 +1,50 @@
 #include "ffd.hh"
 #include "IO/FileStream.hh"
 
+#include "ffdParser.hh"
+
 #include "ffd/ffd.skeleton.hh"
 #include "ffd/ffd.lexer.hh"
 
-static eastl::vector<lr::ffd::Category *> pCategories;
-static eastl::string CurrentVar;
-static eastl::string CurrentArray;
+/// State of a single parse, the scanner and the parser don't keep any globals so files can be parsed from
+/// multiple threads at once.
+struct ffdParseContext
+{
+    lr::Arena *pArena = nullptr;
+
+    eastl::vector<lr::ffd::Category *> Categories;
+    eastl::string CurrentVar;
+    eastl::string CurrentArray;
+};
 
-void ffd_push_category(char *var)
+void ffd_push_category(ffdParseContext *pContext, char *var)
 {
-    auto categoryIt = pCategories.back()->m_Childeren.emplace(eastl::string(var), new lr::ffd::Category);
-    pCategories.push_back(categoryIt.first->second);
+    pContext->Categories.push_back(lr::ffdParser::GetChild(*pContext->Categories.back(), var, *pContext->pArena));
 
     free(var);
 }
 
-void ffd_pop_category()
+void ffd_pop_category(ffdParseContext *pContext)
 {
-    pCategories.pop_back();
+    pContext->Categories.pop_back();
 }
 
-void ffd_push_array(char *var)
+void ffd_push_array(ffdParseContext *pContext, char *var)
 {
-    CurrentArray = var;
+    pContext->CurrentArray = var;
 
     free(var);
 }
 
-void ffd_pop_array()
+void ffd_pop_array(ffdParseContext *pContext)
 {
-    CurrentArray = "";
+    pContext->CurrentArray = "";
 }
 
-void ffd_array_str(char *val)
+void ffd_array_str(ffdParseContext *pContext, char *val)
 {
-    lr::ffd::Category *pCurrentCategory = pCategories.back();
-    auto &strArr = pCurrentCategory->m_ArrayString[CurrentArray];
+    lr::ffd::Category *pCurrentCategory = pContext->Categories.back();
+    auto &strArr = pCurrentCategory->m_ArrayString[pContext->CurrentArray];
 
     eastl::string actualString = val;
     strArr.push_back(actualString.substr(1, actualString.length() - 2));
@@ -44,52 +52,45 @@ void ffd_array_str(char *val)
     free(val);
 }
 
-void ffd_array_num(double val)
+void ffd_array_num(ffdParseContext *pContext, double val)
 {
-    lr::ffd::Category *pCurrentCategory = pCategories.back();
-    auto &numArr = pCurrentCategory->m_ArrayNumbers[CurrentArray];
+    lr::ffd::Category *pCurrentCategory = pContext->Categories.back();
+    auto &numArr = pCurrentCategory->m_ArrayNumbers[pContext->CurrentArray];
     numArr.push_back(val);
 }
 
-void ffd_var(char *var)
+void ffd_var(ffdParseContext *pContext, char *var)
 {
-    CurrentVar = var;
+    pContext->CurrentVar = var;
     free(var);
 }
 
-void ffd_num(double num)
+void ffd_num(ffdParseContext *pContext, double num)
 {
-    lr::ffd::Category *pCurrentCategory = pCategories.back();
-    pCurrentCategory->m_Numbers.emplace(CurrentVar, num);
+    lr::ffd::Category *pCurrentCategory = pContext->Categories.back();
+    pCurrentCategory->m_Numbers.emplace(pContext->CurrentVar, num);
 
-    CurrentVar = "";
+    pContext->CurrentVar = "";
 }
 
-void ffd_str(char *str)
+void ffd_str(ffdParseContext *pContext, char *str)
 {
-    lr::ffd::Category *pCurrentCategory = pCategories.back();
+    lr::ffd::Category *pCurrentCategory = pContext->Categories.back();
 
     eastl::string actualString = str;
-    pCurrentCategory->m_Strings.emplace(CurrentVar, actualString.substr(1, actualString.length() - 2));  // Remove "<str>"
+    pCurrentCategory->m_Strings.emplace(pContext->CurrentVar, actualString.substr(1, actualString.length() - 2));  // Remove "<str>"
 
     free(str);
 
-    CurrentVar = "";
+    pContext->CurrentVar = "";
 }
 
-void ffd_bool(bool b)
+void ffd_bool(ffdParseContext *pContext, bool b)
 {
-    lr::ffd::Category *pCurrentCategory = pCategories.back();
-    pCurrentCategory->m_Bools.emplace(CurrentVar, b);
-
-    CurrentVar = "";
-}
+    lr::ffd::Category *pCurrentCategory = pContext->Categories.back();
+    pCurrentCategory->m_Bools.emplace(pContext->CurrentVar, b);
 
-int yyerror(const char *s)
-{
-    char tmp_str[1024];
-    sprintf_s(tmp_str, sizeof(tmp_str), "%s at line %i", s, yylineno);
-    return 1;
+    pContext->CurrentVar = "";
 }
 
 namespace lr
@@ -109,16 +110,6 @@ namespace lr
         return valIt->second;
     }
 
-    static void DeleteCategoryRecursive(ffd::Category *pStartCategory)
-    {
-        for (auto &v : pStartCategory->m_Childeren)
-        {
-            DeleteCategoryRecursive(v.second);
-
-            delete v.second;
-        }
-    }
-
     static void PrintDepth(u32 depth)
     {
         eastl::string s = "";
@@ -319,30 +310,31 @@ namespace lr
         return kInvalidCat;
     }
 
-    ffd::ffd()
-    {
-        pCategories.push_back(&m_GlobalCategory);
-    }
-
-    ffd::~ffd()
+    void ffd::FromMemory(const char *pCode, u32 len)
     {
-        DeleteCategoryRecursive(&m_GlobalCategory);
+        ffdParser parser(eastl::string_view(pCode, len), m_Arena);
+        parser.Parse(m_GlobalCategory);
     }
 
-    void ffd::FromMemory(const char *pCode, u32 len)
+    void ffd::FromMemoryBison(const char *pCode, u32 len)
     {
-        YY_BUFFER_STATE state = yy_scan_bytes(pCode, len);
-        yyparse();
-        yylex_destroy();
+        ffdParseContext context;
+        context.pArena = &m_Arena;
+        context.Categories.push_back(&m_GlobalCategory);
 
-        // Ignore m_GlobalCategory, so i = 1
-        for (u32 i = 1; i < pCategories.size(); i++)
+        yyscan_t scanner;
+        if (yylex_init(&scanner) != 0)
         {
-            delete pCategories[i];
+            LOG_WARN("Failed to create ffd scanner.");
+            return;
         }
 
-        pCategories.clear();
-        CurrentVar = "";
+        // Scanned buffers don't initialize their line count
+        yy_scan_bytes(pCode, len, scanner);
+        yyset_lineno(1, scanner);
+
+        yyparse(scanner, &context);
+        yylex_destroy(scanner);
     }
 
     void ffd::FromFile(const eastl::string &path)
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "Utils/Arena.hh"
+
 namespace lr
 {
     class ffd
@@ -39,10 +41,10 @@ namespace lr
         };
 
     public:
-        ffd();
-        ~ffd();
-
+        /// Hand-written parser, see `ffdParser`
         void FromMemory(const char *pCode, u32 len);
+        /// Generated flex/bison parser, kept as the reference for `FromMemory`
+        void FromMemoryBison(const char *pCode, u32 len);
         void FromFile(const eastl::string &path);
         void Close(const eastl::string &path = "");
 
@@ -53,5 +55,6 @@ namespace lr
 
     private:
         Category m_GlobalCategory;
+        Arena m_Arena;  // child categories
     };
 }  // namespace lr
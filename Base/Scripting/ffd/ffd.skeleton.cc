@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.7.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -46,16 +46,16 @@
    USER NAME SPACE" below.  */
 
 /* Identify Bison output, and Bison version.  */
-#define YYBISON 30704
+#define YYBISON 30802
 
 /* Bison version string.  */
-#define YYBISON_VERSION "3.7.4"
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -127,32 +127,26 @@ typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 /* Second part of user prologue.  */
-#line 19 "parser.y"
+#line 29 "parser.y"
 
 #include "ffd.lexer.hh"
-void yyerror(const char *s);
+void yyerror(YYLTYPE *pLocation, yyscan_t scanner, ffdParseContext *pContext, const char *s);
 
-#ifdef YYDEBUG
-int yydebug = 1;
-#endif
-
-extern int yylineno;
+extern void ffd_push_array(ffdParseContext *pContext, char *var);
+extern void ffd_pop_array(ffdParseContext *pContext);
 
-extern void ffd_push_array(char *var);
-extern void ffd_pop_array();
+extern void ffd_array_str(ffdParseContext *pContext, char *val);
+extern void ffd_array_num(ffdParseContext *pContext, double val);
 
-extern void ffd_array_str(char *val);
-extern void ffd_array_num(double val);
+extern void ffd_push_category(ffdParseContext *pContext, char *var);
+extern void ffd_pop_category(ffdParseContext *pContext);
 
-extern void ffd_push_category(char *var);
-extern void ffd_pop_category();
+extern void ffd_var(ffdParseContext *pContext, char *var);
+extern void ffd_num(ffdParseContext *pContext, double num);
+extern void ffd_str(ffdParseContext *pContext, char *str);
+extern void ffd_bool(ffdParseContext *pContext, bool b);
 
-extern void ffd_var(char *var);
-extern void ffd_num(double num);
-extern void ffd_str(char *str);
-extern void ffd_bool(bool b);
-
-#line 156 "ffd.skeleton.cc"
+#line 150 "ffd.skeleton.cc"
 
 
 #ifdef short
@@ -192,6 +186,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -289,17 +295,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -517,13 +529,13 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int8 yyrline[] =
 {
-       0,    49,    49,    50,    51,    55,    56,    60,    61,    65,
-      66,    67,    68,    69,    73,    74,    75,    79,    80,    84,
-      85,    86,    87,    88,    92,    93,    96,    96,    97,    97,
-      98,    98
+       0,    53,    53,    54,    55,    59,    60,    64,    65,    69,
+      70,    71,    72,    73,    77,    78,    79,    83,    84,    88,
+      89,    90,    91,    92,    96,    97,   100,   100,   101,   101,
+     102,   102
 };
 #endif
 
@@ -553,16 +565,6 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
-{
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268
-};
-#endif
-
 #define YYPACT_NINF (-10)
 
 #define yypact_value_is_default(Yyn) \
@@ -573,8 +575,8 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
        6,    15,     7,     6,    10,   -10,   -10,   -10,    17,    21,
@@ -583,9 +585,9 @@ static const yytype_int8 yypact[] =
      -10,   -10,   -10,   -10,    13,   -10,   -10,    -7,   -10
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        2,    26,     0,     4,     3,    24,    19,    23,    28,     0,
@@ -594,23 +596,23 @@ static const yytype_int8 yydefact[] =
        7,    15,    16,    17,     0,     6,     8,    14,    18
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -10,   -10,   -10,   -10,   -10,    -9,   -10,    11,   -10,    14,
      -10,    -3,   -10,    -2,   -10
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     2,    19,    26,    24,    33,    34,     3,     4,    11,
+       0,     2,    19,    26,    24,    33,    34,     3,     4,    11,
        9,     6,    16,     7,    17
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       12,    13,    30,    27,    35,    31,    32,    10,    31,    32,
@@ -625,8 +627,8 @@ static const yytype_int8 yycheck[] =
        7,    11,     5,     8,     3,     5,    29,    29,    37,    18
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,    11,    15,    21,    22,    23,    25,    27,     8,    24,
@@ -635,7 +637,7 @@ static const yytype_int8 yystos[] =
        6,    12,    13,    19,    20,     4,     6,     7,    19
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    14,    15,    15,    15,    16,    16,    17,    17,    18,
@@ -644,7 +646,7 @@ static const yytype_int8 yyr1[] =
       28,    27
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     1,     1,     2,     3,     2,     3,     0,
@@ -662,6 +664,7 @@ enum { YYENOMEM = -2 };
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -678,7 +681,7 @@ enum { YYENOMEM = -2 };
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (&yylloc, scanner, pContext, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
@@ -729,12 +732,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-# ifndef YY_LOCATION_PRINT
-#  if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -762,15 +772,23 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
 
-#   define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
 #  else
-#   define YY_LOCATION_PRINT(File, Loc) ((void) 0)
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
 #  endif
-# endif /* !defined YY_LOCATION_PRINT */
+# endif /* !defined YYLOCATION_PRINT */
 
 
 # define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
@@ -779,7 +797,7 @@ do {                                                                      \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Kind, Value, Location); \
+                  Kind, Value, Location, scanner, pContext); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -791,19 +809,17 @@ do {                                                                      \
 
 static void
 yy_symbol_value_print (FILE *yyo,
-                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ffdParseContext *pContext)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (pContext);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yykind < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yykind], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yykind);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -814,14 +830,14 @@ yy_symbol_value_print (FILE *yyo,
 
 static void
 yy_symbol_print (FILE *yyo,
-                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ffdParseContext *pContext)
 {
   YYFPRINTF (yyo, "%s %s (",
              yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner, pContext);
   YYFPRINTF (yyo, ")");
 }
 
@@ -855,7 +871,7 @@ do {                                                            \
 
 static void
 yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
-                 int yyrule)
+                 int yyrule, yyscan_t scanner, ffdParseContext *pContext)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -869,7 +885,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
       yy_symbol_print (stderr,
                        YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
                        &yyvsp[(yyi + 1) - (yynrhs)],
-                       &(yylsp[(yyi + 1) - (yynrhs)]));
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner, pContext);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -877,7 +893,7 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, pContext); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
@@ -1186,44 +1202,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
 
 static void
 yydestruct (const char *yymsg,
-            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, yyscan_t scanner, ffdParseContext *pContext)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (pContext);
   if (!yymsg)
     yymsg = "Deleting";
   YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yykind);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (yyscan_t scanner, ffdParseContext *pContext)
+{
 /* Lookahead token kind.  */
 int yychar;
 
+
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
 /* Location data for the lookahead symbol.  */
-YYLTYPE yylloc
+static YYLTYPE yyloc_default
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
-/* Number of syntax errors so far.  */
-int yynerrs;
-
+YYLTYPE yylloc = yyloc_default;
 
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-
-/*----------.
-| yyparse.  |
-`----------*/
-
-int
-yyparse (void)
-{
     yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
     int yyerrstatus = 0;
@@ -1276,6 +1302,7 @@ yyparse (void)
   YYDPRINTF ((stderr, "Starting parse\n"));
 
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1302,7 +1329,7 @@ yysetstate:
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1333,7 +1360,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1344,7 +1371,7 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1368,6 +1395,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1392,7 +1420,7 @@ yybackup:
   if (yychar == YYEMPTY)
     {
       YYDPRINTF ((stderr, "Reading a token\n"));
-      yychar = yylex ();
+      yychar = yylex (&yylval, &yylloc, scanner);
     }
 
   if (yychar <= YYEOF)
@@ -1484,85 +1512,85 @@ yyreduce:
   switch (yyn)
     {
   case 5: /* object: LCURLY RCURLY  */
-#line 55 "parser.y"
-                        { ffd_pop_category(); }
-#line 1490 "ffd.skeleton.cc"
+#line 59 "parser.y"
+                        { ffd_pop_category(pContext); }
+#line 1518 "ffd.skeleton.cc"
     break;
 
   case 6: /* object: LCURLY members RCURLY  */
-#line 56 "parser.y"
-                        { ffd_pop_category(); }
-#line 1496 "ffd.skeleton.cc"
+#line 60 "parser.y"
+                        { ffd_pop_category(pContext); }
+#line 1524 "ffd.skeleton.cc"
     break;
 
   case 7: /* array: RBRACKET LBRACKET  */
-#line 60 "parser.y"
-                                    { ffd_pop_array(); }
-#line 1502 "ffd.skeleton.cc"
+#line 64 "parser.y"
+                                    { ffd_pop_array(pContext); }
+#line 1530 "ffd.skeleton.cc"
     break;
 
   case 8: /* array: RBRACKET arrayValues LBRACKET  */
-#line 61 "parser.y"
-                                { ffd_pop_array(); }
-#line 1508 "ffd.skeleton.cc"
+#line 65 "parser.y"
+                                { ffd_pop_array(pContext); }
+#line 1536 "ffd.skeleton.cc"
     break;
 
   case 10: /* value: STRING  */
-#line 66 "parser.y"
-         { ffd_str((yyvsp[0].string));     }
-#line 1514 "ffd.skeleton.cc"
+#line 70 "parser.y"
+         { ffd_str(pContext, (yyvsp[0].string));     }
+#line 1542 "ffd.skeleton.cc"
     break;
 
   case 11: /* value: NUMBER  */
-#line 67 "parser.y"
-         { ffd_num((yyvsp[0].number));     }
-#line 1520 "ffd.skeleton.cc"
+#line 71 "parser.y"
+         { ffd_num(pContext, (yyvsp[0].number));     }
+#line 1548 "ffd.skeleton.cc"
     break;
 
   case 12: /* value: VTRUE  */
-#line 68 "parser.y"
-         { ffd_bool(true);  }
-#line 1526 "ffd.skeleton.cc"
+#line 72 "parser.y"
+         { ffd_bool(pContext, true);  }
+#line 1554 "ffd.skeleton.cc"
     break;
 
   case 13: /* value: VFALSE  */
-#line 69 "parser.y"
-         { ffd_bool(false); }
-#line 1532 "ffd.skeleton.cc"
+#line 73 "parser.y"
+         { ffd_bool(pContext, false); }
+#line 1560 "ffd.skeleton.cc"
     break;
 
   case 15: /* arrayValue: STRING  */
-#line 74 "parser.y"
-         { ffd_array_str((yyvsp[0].string)); }
-#line 1538 "ffd.skeleton.cc"
+#line 78 "parser.y"
+         { ffd_array_str(pContext, (yyvsp[0].string)); }
+#line 1566 "ffd.skeleton.cc"
     break;
 
   case 16: /* arrayValue: NUMBER  */
-#line 75 "parser.y"
-         { ffd_array_num((yyvsp[0].number)); }
-#line 1544 "ffd.skeleton.cc"
+#line 79 "parser.y"
+         { ffd_array_num(pContext, (yyvsp[0].number)); }
+#line 1572 "ffd.skeleton.cc"
     break;
 
   case 26: /* $@1: %empty  */
-#line 96 "parser.y"
-                                                { ffd_push_category((yyvsp[0].string)); }
-#line 1550 "ffd.skeleton.cc"
+#line 100 "parser.y"
+                                                { ffd_push_category(pContext, (yyvsp[0].string)); }
+#line 1578 "ffd.skeleton.cc"
     break;
 
   case 28: /* $@2: %empty  */
-#line 97 "parser.y"
-                                        { ffd_var((yyvsp[-1].string)); }
-#line 1556 "ffd.skeleton.cc"
+#line 101 "parser.y"
+                                        { ffd_var(pContext, (yyvsp[-1].string)); }
+#line 1584 "ffd.skeleton.cc"
     break;
 
   case 30: /* $@3: %empty  */
-#line 98 "parser.y"
-                                        { ffd_push_array((yyvsp[-1].string)); }
-#line 1562 "ffd.skeleton.cc"
+#line 102 "parser.y"
+                                        { ffd_push_array(pContext, (yyvsp[-1].string)); }
+#line 1590 "ffd.skeleton.cc"
     break;
 
 
-#line 1566 "ffd.skeleton.cc"
+#line 1594 "ffd.skeleton.cc"
 
       default: break;
     }
@@ -1637,9 +1665,9 @@ yyerrlab:
                 yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
+        yyerror (&yylloc, scanner, pContext, yymsgp);
         if (yysyntax_error_status == YYENOMEM)
-          goto yyexhaustedlab;
+          YYNOMEM;
       }
     }
 
@@ -1658,7 +1686,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval, &yylloc);
+                      yytoken, &yylval, &yylloc, scanner, pContext);
           yychar = YYEMPTY;
         }
     }
@@ -1676,6 +1704,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1713,7 +1742,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner, pContext);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1739,7 +1768,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -1747,31 +1776,29 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if 1
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, scanner, pContext, YY_("memory exhausted"));
   yyresult = 2;
-  goto yyreturn;
-#endif
+  goto yyreturnlab;
 
 
-/*-------------------------------------------------------.
-| yyreturn -- parsing is finished, clean up and return.  |
-`-------------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval, &yylloc);
+                  yytoken, &yylval, &yylloc, scanner, pContext);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1780,7 +1807,7 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner, pContext);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
@@ -1792,10 +1819,10 @@ yyreturn:
   return yyresult;
 }
 
-#line 100 "parser.y"
+#line 104 "parser.y"
 
 
-void yyerror(const char *s)
+void yyerror(YYLTYPE *pLocation, yyscan_t scanner, ffdParseContext *pContext, const char *s)
 {
-    printf("** Line %d: %s\n", yylineno, s);
+    printf("** Line %d: %s\n", pLocation->first_line, s);
 }
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.7.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -44,6 +44,13 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 6 "parser.y"
+
+typedef void *yyscan_t;
+struct ffdParseContext;
+
+#line 54 "ffd.skeleton.hh"
 
 /* Token kinds.  */
 #ifndef YYTOKENTYPE
@@ -73,12 +80,12 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 5 "parser.y"
+#line 15 "parser.y"
 
     char *string;
     double number;
 
-#line 82 "ffd.skeleton.hh"
+#line 89 "ffd.skeleton.hh"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -101,8 +108,9 @@ struct YYLTYPE
 #endif
 
 
-extern YYSTYPE yylval;
-extern YYLTYPE yylloc;
-int yyparse (void);
+
+
+int yyparse (yyscan_t scanner, ffdParseContext *pContext);
+
 
 #endif /* !YY_YY_FFD_SKELETON_HH_INCLUDED  */
@@ -1,5 +1,15 @@
 %require "3.7"
 %define parse.error verbose
+%define api.pure full
+
+%code requires
+{
+typedef void *yyscan_t;
+struct ffdParseContext;
+}
+
+%param { yyscan_t scanner }
+%parse-param { ffdParseContext *pContext }
 
 %union
 {
@@ -18,27 +28,21 @@
 
 %{
 #include "ffd.lexer.hh"
-void yyerror(const char *s);
-
-#ifdef YYDEBUG
-int yydebug = 1;
-#endif
-
-extern int yylineno;
+void yyerror(YYLTYPE *pLocation, yyscan_t scanner, ffdParseContext *pContext, const char *s);
 
-extern void ffd_push_array(char *var);
-extern void ffd_pop_array();
+extern void ffd_push_array(ffdParseContext *pContext, char *var);
+extern void ffd_pop_array(ffdParseContext *pContext);
 
-extern void ffd_array_str(char *val);
-extern void ffd_array_num(double val);
+extern void ffd_array_str(ffdParseContext *pContext, char *val);
+extern void ffd_array_num(ffdParseContext *pContext, double val);
 
-extern void ffd_push_category(char *var);
-extern void ffd_pop_category();
+extern void ffd_push_category(ffdParseContext *pContext, char *var);
+extern void ffd_pop_category(ffdParseContext *pContext);
 
-extern void ffd_var(char *var);
-extern void ffd_num(double num);
-extern void ffd_str(char *str);
-extern void ffd_bool(bool b);
+extern void ffd_var(ffdParseContext *pContext, char *var);
+extern void ffd_num(ffdParseContext *pContext, double num);
+extern void ffd_str(ffdParseContext *pContext, char *str);
+extern void ffd_bool(ffdParseContext *pContext, bool b);
 %}
 
 %locations
@@ -52,27 +56,27 @@ FFD
 ;
 
 object
-: LCURLY         RCURLY { ffd_pop_category(); } //  { }
-| LCURLY members RCURLY { ffd_pop_category(); } //  {Members..}
+: LCURLY         RCURLY { ffd_pop_category(pContext); } //  { }
+| LCURLY members RCURLY { ffd_pop_category(pContext); } //  {Members..}
 ;
 
 array
-: RBRACKET  		   LBRACKET { ffd_pop_array(); } // []
-| RBRACKET arrayValues LBRACKET { ffd_pop_array(); } // [values...]
+: RBRACKET  		   LBRACKET { ffd_pop_array(pContext); } // []
+| RBRACKET arrayValues LBRACKET { ffd_pop_array(pContext); } // [values...]
 ;
 
 value
 :
-| STRING { ffd_str($1);     } // "String"
-| NUMBER { ffd_num($1);     } // 12345
-| VTRUE  { ffd_bool(true);  } // true
-| VFALSE { ffd_bool(false); } // false
+| STRING { ffd_str(pContext, $1);     } // "String"
+| NUMBER { ffd_num(pContext, $1);     } // 12345
+| VTRUE  { ffd_bool(pContext, true);  } // true
+| VFALSE { ffd_bool(pContext, false); } // false
 ;
 
 arrayValue
 :
-| STRING { ffd_array_str($1); }
-| NUMBER { ffd_array_num($1); }
+| STRING { ffd_array_str(pContext, $1); }
+| NUMBER { ffd_array_num(pContext, $1); }
 ;
 
 arrayValues
@@ -93,13 +97,13 @@ categories
 | categories category
 ;
 
-category: 	IDENTIFIER 			{ ffd_push_category($1); } object;
-member: 	IDENTIFIER ASSIGN 	{ ffd_var($1); } value; // IDENTIFIER = value
-list: 		IDENTIFIER ASSIGN 	{ ffd_push_array($1); } array;
+category: 	IDENTIFIER 			{ ffd_push_category(pContext, $1); } object;
+member: 	IDENTIFIER ASSIGN 	{ ffd_var(pContext, $1); } value; // IDENTIFIER = value
+list: 		IDENTIFIER ASSIGN 	{ ffd_push_array(pContext, $1); } array;
 
 %%
 
-void yyerror(const char *s)
+void yyerror(YYLTYPE *pLocation, yyscan_t scanner, ffdParseContext *pContext, const char *s)
 {
-    printf("** Line %d: %s\n", yylineno, s);
+    printf("** Line %d: %s\n", pLocation->first_line, s);
 }
\ No newline at end of file
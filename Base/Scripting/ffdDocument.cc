@@ -0,0 +1,504 @@
+#include "ffdDocument.hh"
+
+#include <EASTL/sort.h>
+#include <filesystem>
+
+#include "IO/FileStream.hh"
+
+#include "ffdParser.hh"
+
+namespace lr
+{
+    static_assert(sizeof(ffdDocument::Node) == 16, "Nodes are expected to be 16 bytes.");
+
+    static void CollectNames(const ffd::Category &category, eastl::vector<eastl::string_view> &names)
+    {
+        for (auto &v : category.m_Numbers) names.push_back(v.first);
+        for (auto &v : category.m_Strings) names.push_back(v.first);
+        for (auto &v : category.m_Bools) names.push_back(v.first);
+        for (auto &v : category.m_ArrayNumbers) names.push_back(v.first);
+        for (auto &v : category.m_ArrayString) names.push_back(v.first);
+
+        for (auto &v : category.m_Childeren)
+        {
+            names.push_back(v.first);
+            CollectNames(*v.second, names);
+        }
+    }
+
+    static bool IsNodeLess(const ffdDocument::Node &a, const ffdDocument::Node &b)
+    {
+        return a.Key != b.Key ? a.Key < b.Key : a.Type < b.Type;
+    }
+
+    /// Children of every category share one table, the parent is mixed into the name hash
+    static u64 GetChildHash(u32 parent, u64 nameHash)
+    {
+        return Hash::FNV64(parent, nameHash);
+    }
+
+    /// Appends a null terminated copy, the range doesn't include the terminator
+    static ffdDocument::Range AddChars(eastl::vector<char> &chars, eastl::string_view text)
+    {
+        ffdDocument::Range range = { (u32)chars.size(), (u32)text.size() };
+
+        chars.insert(chars.end(), text.begin(), text.end());
+        chars.push_back(0);
+
+        return range;
+    }
+
+    eastl::string_view ffdDocument::Category::AsString(eastl::string_view var, u32 arrayIdx) const
+    {
+        if (arrayIdx == -1)
+        {
+            const Node *pNode = Find(var, ffdValueType::String);
+            return pNode ? m_pDocument->GetString(*pNode) : "";
+        }
+
+        const Node *pNode = Find(var, ffdValueType::StringArray);
+        if (!pNode || arrayIdx >= pNode->Children.Count) return "";
+
+        return m_pDocument->GetString(m_pDocument->m_pNodes[pNode->Children.First + arrayIdx]);
+    }
+
+    u32 ffdDocument::Category::AsU32(eastl::string_view var, u32 arrayIdx) const
+    {
+        return (u32)GetNumber(var, arrayIdx);
+    }
+
+    i32 ffdDocument::Category::AsI32(eastl::string_view var, u32 arrayIdx) const
+    {
+        return (i32)GetNumber(var, arrayIdx);
+    }
+
+    float ffdDocument::Category::AsFloat(eastl::string_view var, u32 arrayIdx) const
+    {
+        return (float)GetNumber(var, arrayIdx);
+    }
+
+    bool ffdDocument::Category::AsBool(eastl::string_view var) const
+    {
+        const Node *pNode = Find(var, ffdValueType::Bool);
+        return pNode ? pNode->Bool : false;
+    }
+
+    u32 ffdDocument::Category::GetStringArraySize(eastl::string_view var) const
+    {
+        const Node *pNode = Find(var, ffdValueType::StringArray);
+        return pNode ? pNode->Children.Count : 0;
+    }
+
+    u32 ffdDocument::Category::GetNumberArraySize(eastl::string_view var) const
+    {
+        const Node *pNode = Find(var, ffdValueType::NumberArray);
+        return pNode ? pNode->Children.Count : 0;
+    }
+
+    ffdDocument::Category ffdDocument::Category::operator[](eastl::string_view var) const
+    {
+        const Node *pNode = Find(var, ffdValueType::Category);
+        if (!pNode) return {};
+
+        return Category(m_pDocument, pNode - m_pDocument->m_pNodes);
+    }
+
+    ffdDocument::Category ffdDocument::Category::operator[](const ffdKey &path) const
+    {
+        const Node *pNode = Find(path, ffdValueType::Category);
+        if (!pNode) return {};
+
+        return Category(m_pDocument, pNode - m_pDocument->m_pNodes);
+    }
+
+    const ffdDocument::Node *ffdDocument::Category::Find(eastl::string_view var, ffdValueType type) const
+    {
+        if (!IsValid()) return nullptr;
+
+        return m_pDocument->FindChild(m_Node, var, type);
+    }
+
+    const ffdDocument::Node *ffdDocument::Category::Find(const ffdKey &path, ffdValueType type) const
+    {
+        if (!IsValid() || path.GetDepth() == 0) return nullptr;
+
+        u32 node = m_Node;
+        for (u32 i = 0; i + 1 < path.GetDepth(); i++)
+        {
+            const ffdKey::Segment &segment = path.GetSegment(i);
+
+            const Node *pCategory = m_pDocument->FindChild(node, segment.Name, segment.Hash, ffdValueType::Category);
+            if (!pCategory) return nullptr;
+
+            node = pCategory - m_pDocument->m_pNodes;
+        }
+
+        const ffdKey::Segment &segment = path.GetSegment(path.GetDepth() - 1);
+
+        return m_pDocument->FindChild(node, segment.Name, segment.Hash, type);
+    }
+
+    double ffdDocument::Category::GetNumber(eastl::string_view var, u32 arrayIdx) const
+    {
+        if (arrayIdx == -1)
+        {
+            const Node *pNode = Find(var, ffdValueType::Number);
+            return pNode ? pNode->Number : 0.0;
+        }
+
+        const Node *pNode = Find(var, ffdValueType::NumberArray);
+        if (!pNode || arrayIdx >= pNode->Children.Count) return 0.0;
+
+        return m_pDocument->m_pNodes[pNode->Children.First + arrayIdx].Number;
+    }
+
+    bool ffdDocument::FromMemory(const char *pCode, u32 len)
+    {
+        // The tree is only an intermediate, its arena goes away with it
+        Arena arena;
+        ffd::Category global;
+
+        ffdParser parser(eastl::string_view(pCode, len), arena);
+        if (!parser.Parse(global))
+        {
+            // Don't keep whatever parsed before the error
+            Reset();
+            return false;
+        }
+
+        FromCategory(global);
+
+        return true;
+    }
+
+    bool ffdDocument::FromFile(const eastl::string &path)
+    {
+        FileStream scriptFile(path, false);
+        if (!scriptFile.IsOK())
+        {
+            LOG_WARN("Failed to load '{}'.", path.c_str());
+            return false;
+        }
+
+        const char *pScript = scriptFile.ReadAll<char>();
+        u32 size = scriptFile.Size();
+        scriptFile.Close();
+
+        bool parsed = FromMemory(pScript, size);
+
+        free((void *)pScript);
+
+        return parsed;
+    }
+
+    void ffdDocument::FromCategory(const ffd::Category &global)
+    {
+        Reset();
+
+        // Intern every name up front, key indices follow name order
+        eastl::vector<eastl::string_view> names;
+        CollectNames(global, names);
+
+        eastl::sort(names.begin(), names.end());
+        names.erase(eastl::unique(names.begin(), names.end()), names.end());
+
+        eastl::unordered_map<eastl::string_view, u32> keyIndices;
+        keyIndices.reserve(names.size());
+
+        for (eastl::string_view name : names)
+        {
+            Range chars = AddChars(m_Chars, name);
+
+            keyIndices.emplace(name, (u32)m_Keys.size());
+            m_Keys.push_back({ Hash::FNV64String(name), chars.First, chars.Count });
+        }
+
+        // Breadth first, a category's children are written together and its arrays/categories are expanded later
+        struct Pending
+        {
+            const ffd::Category *pCategory;
+            u32 Node;
+        };
+
+        eastl::vector<Pending> queue = { { &global, 0 } };
+        eastl::vector<eastl::pair<Node, const void *>> children;
+
+        m_Nodes.emplace_back();
+
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            const ffd::Category &category = *queue[i].pCategory;
+            children.clear();
+
+            auto AddChild = [&](const eastl::string &name, ffdValueType type, const void *pSource = nullptr) -> Node & {
+                Node node;
+                node.Key = keyIndices[name];
+                node.Type = type;
+
+                return children.emplace_back(node, pSource).first;
+            };
+
+            for (auto &v : category.m_Numbers) AddChild(v.first, ffdValueType::Number).Number = v.second;
+            for (auto &v : category.m_Strings) AddChild(v.first, ffdValueType::String).Children = AddChars(m_Chars, v.second);
+            for (auto &v : category.m_Bools) AddChild(v.first, ffdValueType::Bool).Bool = v.second;
+            for (auto &v : category.m_ArrayNumbers) AddChild(v.first, ffdValueType::NumberArray, &v.second);
+            for (auto &v : category.m_ArrayString) AddChild(v.first, ffdValueType::StringArray, &v.second);
+            for (auto &v : category.m_Childeren) AddChild(v.first, ffdValueType::Category, v.second);
+
+            eastl::sort(children.begin(), children.end(), [](auto &a, auto &b) { return IsNodeLess(a.first, b.first); });
+
+            u32 first = m_Nodes.size();
+            m_Nodes[queue[i].Node].Children = { first, (u32)children.size() };
+
+            for (auto &child : children) m_Nodes.push_back(child.first);
+
+            for (u32 j = 0; j < children.size(); j++)
+            {
+                auto &[node, pSource] = children[j];
+                Range elements = { (u32)m_Nodes.size(), 0 };
+
+                if (node.Type == ffdValueType::NumberArray)
+                {
+                    for (double value : *(const eastl::vector<double> *)pSource)
+                    {
+                        m_Nodes.emplace_back().Type = ffdValueType::Number;
+                        m_Nodes.back().Number = value;
+                    }
+                }
+                else if (node.Type == ffdValueType::StringArray)
+                {
+                    for (const eastl::string &value : *(const eastl::vector<eastl::string> *)pSource)
+                    {
+                        m_Nodes.emplace_back().Type = ffdValueType::String;
+                        m_Nodes.back().Children = AddChars(m_Chars, value);
+                    }
+                }
+                else if (node.Type == ffdValueType::Category)
+                {
+                    queue.push_back({ (const ffd::Category *)pSource, first + j });
+                    continue;
+                }
+                else
+                {
+                    continue;
+                }
+
+                elements.Count = m_Nodes.size() - elements.First;
+                m_Nodes[first + j].Children = elements;
+            }
+        }
+
+        // Open addressing, at most half full
+        u32 childCount = 0;
+        for (const Node &node : m_Nodes) childCount += node.Key != kInvalid;
+
+        u32 tableSize = 16;
+        while (tableSize < childCount * 2) tableSize *= 2;
+
+        m_ChildTable.assign(tableSize, kInvalid);
+
+        for (u32 parent = 0; parent < m_Nodes.size(); parent++)
+        {
+            const Node &node = m_Nodes[parent];
+            if (node.Type != ffdValueType::Category) continue;
+
+            for (u32 child = node.Children.First; child < node.Children.First + node.Children.Count; child++)
+            {
+                u32 slot = GetChildHash(parent, m_Keys[m_Nodes[child].Key].Hash) & (tableSize - 1);
+                while (m_ChildTable[slot] != kInvalid) slot = (slot + 1) & (tableSize - 1);
+
+                m_ChildTable[slot] = child;
+            }
+        }
+
+        SetViews();
+    }
+
+    bool ffdDocument::FromBinaryFile(eastl::string_view path)
+    {
+        Reset();
+
+        if (!m_File.Open(path))
+        {
+            LOG_WARN("Couldn't open compiled ffd {}.", path);
+            return false;
+        }
+
+        if (!SetBinaryViews(m_File.GetData(), m_File.GetSize()))
+        {
+            LOG_WARN("{} is not a valid compiled ffd.", path);
+            Reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ffdDocument::FromBinaryMemory(const u8 *pData, size_t size)
+    {
+        Reset();
+
+        return SetBinaryViews(pData, size);
+    }
+
+    bool ffdDocument::SetBinaryViews(const u8 *pData, size_t size)
+    {
+        const BinaryHeader *pHeader = (const BinaryHeader *)pData;
+        if (size < sizeof(BinaryHeader) || pHeader->Magic != BinaryHeader::kMagic || pHeader->Version != BinaryHeader::kVersion) return false;
+
+        u64 nodesOffset = sizeof(BinaryHeader);
+        u64 keysOffset = nodesOffset + (u64)pHeader->NodeCount * sizeof(Node);
+        u64 childTableOffset = keysOffset + (u64)pHeader->KeyCount * sizeof(Key);
+        u64 charsOffset = childTableOffset + (u64)pHeader->ChildTableSize * sizeof(u32);
+
+        // Only the layout is checked, contents are trusted like any other baked asset
+        bool isPowerOfTwo = (pHeader->ChildTableSize & (pHeader->ChildTableSize - 1)) == 0;
+        if (charsOffset + pHeader->CharCount > size || !isPowerOfTwo || pHeader->NodeCount == 0) return false;
+
+        m_pNodes = (const Node *)(pData + nodesOffset);
+        m_pKeys = (const Key *)(pData + keysOffset);
+        m_pChildTable = (const u32 *)(pData + childTableOffset);
+        m_pChars = (const char *)(pData + charsOffset);
+
+        m_NodeCount = pHeader->NodeCount;
+        m_KeyCount = pHeader->KeyCount;
+        m_ChildTableSize = pHeader->ChildTableSize;
+        m_CharCount = pHeader->CharCount;
+
+        return true;
+    }
+
+    void ffdDocument::Compile(eastl::vector<u8> &blob) const
+    {
+        BinaryHeader header;
+        header.NodeCount = m_NodeCount;
+        header.KeyCount = m_KeyCount;
+        header.ChildTableSize = m_ChildTableSize;
+        header.CharCount = m_CharCount;
+
+        // Every section is a multiple of its successor's alignment, so nothing needs padding
+        blob.clear();
+        blob.insert(blob.end(), (const u8 *)&header, (const u8 *)(&header + 1));
+        blob.insert(blob.end(), (const u8 *)m_pNodes, (const u8 *)(m_pNodes + m_NodeCount));
+        blob.insert(blob.end(), (const u8 *)m_pKeys, (const u8 *)(m_pKeys + m_KeyCount));
+        blob.insert(blob.end(), (const u8 *)m_pChildTable, (const u8 *)(m_pChildTable + m_ChildTableSize));
+        blob.insert(blob.end(), (const u8 *)m_pChars, (const u8 *)(m_pChars + m_CharCount));
+    }
+
+    bool ffdDocument::WriteBinary(eastl::string_view path) const
+    {
+        eastl::vector<u8> blob;
+        Compile(blob);
+
+        // Same as `LUTArchiveWriter`, write next to the file and rename
+        eastl::string tempPath = eastl::string(path) + ".tmp";
+
+        FileStream file(tempPath, true);
+        if (!file.IsOK())
+        {
+            LOG_WARN("Couldn't open compiled ffd {} for writing.", tempPath);
+            return false;
+        }
+
+        file.WritePtr(blob.data(), blob.size());
+        file.Close();
+
+        std::error_code error;
+        std::filesystem::rename(tempPath.c_str(), eastl::string(path).c_str(), error);
+
+        if (error)
+        {
+            // Windows refuses to replace a file that is still mapped
+            std::filesystem::remove(tempPath.c_str(), error);
+
+            LOG_WARN("Couldn't write compiled ffd {}.", path);
+            return false;
+        }
+
+        return true;
+    }
+
+    ffdDocument::Category ffdDocument::Global() const
+    {
+        if (m_NodeCount == 0) return {};
+
+        return Category(this, 0);
+    }
+
+    ffdDocument::Category ffdDocument::operator[](eastl::string_view var) const
+    {
+        return Global()[var];
+    }
+
+    ffdDocument::Category ffdDocument::operator[](const ffdKey &path) const
+    {
+        return Global()[path];
+    }
+
+    const ffdDocument::Node *ffdDocument::FindChild(u32 node, eastl::string_view name, ffdValueType type) const
+    {
+        return FindChild(node, name, Hash::FNV64String(name), type);
+    }
+
+    const ffdDocument::Node *ffdDocument::FindChild(u32 node, eastl::string_view name, u64 hash, ffdValueType type) const
+    {
+        if (m_ChildTableSize == 0) return nullptr;
+
+        const Range &children = m_pNodes[node].Children;
+        u32 mask = m_ChildTableSize - 1;
+
+        // Other types with the same name and other parents can be on the same chain
+        for (u32 slot = GetChildHash(node, hash) & mask;; slot = (slot + 1) & mask)
+        {
+            u32 child = m_pChildTable[slot];
+            if (child == kInvalid) return nullptr;
+
+            const Node &candidate = m_pNodes[child];
+            if (child - children.First >= children.Count || candidate.Type != type) continue;
+
+            if (m_pKeys[candidate.Key].Hash == hash && GetKeyName(candidate.Key) == name) return &candidate;
+        }
+    }
+
+    eastl::string_view ffdDocument::GetKeyName(u32 key) const
+    {
+        const Key &entry = m_pKeys[key];
+        return eastl::string_view(m_pChars + entry.Offset, entry.Length);
+    }
+
+    eastl::string_view ffdDocument::GetString(const Node &node) const
+    {
+        return eastl::string_view(m_pChars + node.Children.First, node.Children.Count);
+    }
+
+    size_t ffdDocument::GetMemorySize() const
+    {
+        return m_NodeCount * sizeof(Node) + m_KeyCount * sizeof(Key) + m_ChildTableSize * sizeof(u32) + m_CharCount;
+    }
+
+    void ffdDocument::Reset()
+    {
+        m_File.Close();
+
+        m_Nodes.clear();
+        m_Keys.clear();
+        m_ChildTable.clear();
+        m_Chars.clear();
+
+        SetViews();
+    }
+
+    void ffdDocument::SetViews()
+    {
+        m_pNodes = m_Nodes.data();
+        m_pKeys = m_Keys.data();
+        m_pChildTable = m_ChildTable.data();
+        m_pChars = m_Chars.data();
+
+        m_NodeCount = m_Nodes.size();
+        m_KeyCount = m_Keys.size();
+        m_ChildTableSize = m_ChildTable.size();
+        m_CharCount = m_Chars.size();
+    }
+
+}  // namespace lr
\ No newline at end of file
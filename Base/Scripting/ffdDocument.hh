@@ -0,0 +1,269 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "IO/MappedFile.hh"
+#include "Utils/Hash.hh"
+
+#include "ffd.hh"
+
+namespace lr
+{
+    enum class ffdValueType : u8
+    {
+        Category,
+        Number,
+        String,
+        Bool,
+        NumberArray,
+        StringArray,
+    };
+
+    /// Dotted path into a `ffdDocument` with every segment hashed up front, `"Category.Sub.Name"_k` does it at
+    /// compile time. Segments point into `path`, so it has to outlive the key. Deeper paths than `kMaxDepth`
+    /// never resolve.
+    class ffdKey
+    {
+    public:
+        static constexpr u32 kMaxDepth = 8;
+
+        struct Segment
+        {
+            u64 Hash = 0;
+            eastl::string_view Name;
+        };
+
+        constexpr explicit ffdKey(eastl::string_view path)
+        {
+            u32 start = 0;
+            for (u32 i = 0; i <= path.size(); i++)
+            {
+                if (i < path.size() && path[i] != '.') continue;
+
+                if (m_Depth == kMaxDepth)
+                {
+                    m_Depth = 0;
+                    return;
+                }
+
+                eastl::string_view name(path.data() + start, i - start);
+                m_Segments[m_Depth++] = { Hash::FNV64String(name), name };
+
+                start = i + 1;
+            }
+        }
+
+        constexpr u32 GetDepth() const
+        {
+            return m_Depth;
+        }
+
+        constexpr const Segment &GetSegment(u32 index) const
+        {
+            return m_Segments[index];
+        }
+
+    private:
+        Segment m_Segments[kMaxDepth] = {};
+        u32 m_Depth = 0;
+    };
+
+    consteval ffdKey operator""_k(const char *pPath, size_t size)
+    {
+        return ffdKey(eastl::string_view(pPath, size));
+    }
+
+    /// Read-only ffd document stored as one flat node array. Keys are interned once per document and children of
+    /// a category are a contiguous node range sorted by key. Lookups go through a single table of every child
+    /// keyed by parent + name hash. Array elements are nodes as well, strings live in a single character pool.
+    ///
+    /// Everything is index based, so a document can be compiled into a blob and queried in place from a mapping.
+    /// Blob layout: BinaryHeader | Node[NodeCount] | Key[KeyCount] | u32[ChildTableSize] | char[CharCount]
+    class ffdDocument
+    {
+    public:
+        static constexpr u32 kInvalid = ~0u;
+
+        struct Range
+        {
+            u32 First;
+            u32 Count;
+        };
+
+        struct Node
+        {
+            u32 Key = kInvalid;  // array elements and the root have no key
+            ffdValueType Type = ffdValueType::Category;
+            u8 _padding[3] = {};
+
+            union
+            {
+                double Number;
+                bool Bool;
+                Range Children = {};  // category children, array elements or characters of a string
+            };
+        };
+
+        struct Key
+        {
+            u64 Hash;  // FNV-1a of the name
+            u32 Offset;
+            u32 Length;
+        };
+
+        /// Handle to a category node, cheap to copy. Missing values return defaults and missing categories
+        /// return an invalid handle, nothing is logged so it can be used on hot paths.
+        class Category
+        {
+        public:
+            Category() = default;
+            Category(const ffdDocument *pDocument, u32 node) : m_pDocument(pDocument), m_Node(node) {}
+
+            eastl::string_view AsString(eastl::string_view var, u32 arrayIdx = -1) const;
+            u32 AsU32(eastl::string_view var, u32 arrayIdx = -1) const;
+            i32 AsI32(eastl::string_view var, u32 arrayIdx = -1) const;
+            float AsFloat(eastl::string_view var, u32 arrayIdx = -1) const;
+            bool AsBool(eastl::string_view var) const;
+
+            u32 GetStringArraySize(eastl::string_view var) const;
+            u32 GetNumberArraySize(eastl::string_view var) const;
+
+            Category operator[](eastl::string_view var) const;
+
+            /// Resolves `path` from this category in one walk, without hashing or allocating. `T` is a number
+            /// type, bool or `eastl::string_view`, misses return 0, false or "" like the `As` functions.
+            template<typename T>
+            T Get(const ffdKey &path, u32 arrayIdx = -1) const;
+            Category operator[](const ffdKey &path) const;
+
+            bool IsValid() const
+            {
+                return m_Node != kInvalid;
+            }
+
+        private:
+            const Node *Find(eastl::string_view var, ffdValueType type) const;
+            const Node *Find(const ffdKey &path, ffdValueType type) const;
+            double GetNumber(eastl::string_view var, u32 arrayIdx) const;
+
+            const ffdDocument *m_pDocument = nullptr;
+            u32 m_Node = kInvalid;
+        };
+
+    public:
+        ffdDocument() = default;
+        ffdDocument(const ffdDocument &) = delete;
+        ffdDocument &operator=(const ffdDocument &) = delete;
+
+        /// False if the file can't be read or has a syntax error, the document is left empty then
+        bool FromMemory(const char *pCode, u32 len);
+        bool FromFile(const eastl::string &path);
+        /// Flattens an already parsed tree, categories are laid out breadth first
+        void FromCategory(const ffd::Category &global);
+
+        /// Maps a compiled document, nothing is parsed or copied. The file has to stay unchanged while it's open.
+        bool FromBinaryFile(eastl::string_view path);
+        /// Same as `FromBinaryFile`, `pData` has to be 8 byte aligned and outlive the document
+        bool FromBinaryMemory(const u8 *pData, size_t size);
+
+        /// Serializes the document into a blob for `FromBinaryMemory`
+        void Compile(eastl::vector<u8> &blob) const;
+        /// Compiled blob for `FromBinaryFile`, written next to `path` and renamed over it. POSIX mappings of the
+        /// old file stay intact, on Windows the rename fails while `path` is mapped and the temporary is removed.
+        bool WriteBinary(eastl::string_view path) const;
+
+        Category Global() const;
+        Category operator[](eastl::string_view var) const;
+
+        /// Paths start at the global category, see `Category::Get`
+        template<typename T>
+        T Get(const ffdKey &path, u32 arrayIdx = -1) const
+        {
+            return Global().Get<T>(path, arrayIdx);
+        }
+
+        Category operator[](const ffdKey &path) const;
+
+        /// Child of a category node with the given name and type, or null
+        const Node *FindChild(u32 node, eastl::string_view name, ffdValueType type) const;
+        /// Same as above with `name` already hashed by `Hash::FNV64String`
+        const Node *FindChild(u32 node, eastl::string_view name, u64 hash, ffdValueType type) const;
+
+        eastl::string_view GetKeyName(u32 key) const;
+        /// Characters of a string node, null terminated
+        eastl::string_view GetString(const Node &node) const;
+
+        /// Bytes used by nodes, keys, the child table and characters
+        size_t GetMemorySize() const;
+
+    private:
+        struct BinaryHeader
+        {
+            static constexpr u32 kMagic = 0x42444646;  // FFDB
+            static constexpr u32 kVersion = 1;
+
+            u32 Magic = kMagic;
+            u32 Version = kVersion;
+            u32 NodeCount = 0;
+            u32 KeyCount = 0;
+            u32 ChildTableSize = 0;
+            u32 CharCount = 0;
+            u32 _padding[2] = {};
+        };
+
+        void Reset();
+        /// Points the views at the storage vectors
+        void SetViews();
+        /// Points the views into a blob, false if its layout doesn't fit
+        bool SetBinaryViews(const u8 *pData, size_t size);
+
+        // Views into either the storage below or a compiled blob
+        const Node *m_pNodes = nullptr;
+        const Key *m_pKeys = nullptr;
+        const u32 *m_pChildTable = nullptr;  // open addressing, node index or `kInvalid`
+        const char *m_pChars = nullptr;
+
+        u32 m_NodeCount = 0;
+        u32 m_KeyCount = 0;
+        u32 m_ChildTableSize = 0;
+        u32 m_CharCount = 0;
+
+        eastl::vector<Node> m_Nodes;
+        eastl::vector<Key> m_Keys;
+        eastl::vector<u32> m_ChildTable;
+        eastl::vector<char> m_Chars;
+
+        MappedFile m_File;
+    };
+
+    template<typename T>
+    T ffdDocument::Category::Get(const ffdKey &path, u32 arrayIdx) const
+    {
+        constexpr bool kIsString = eastl::is_same_v<T, eastl::string_view>;
+        static_assert(kIsString || eastl::is_arithmetic_v<T>, "ffd values are numbers, bools or strings.");
+
+        if constexpr (eastl::is_same_v<T, bool>)
+        {
+            const Node *pNode = Find(path, ffdValueType::Bool);
+            return pNode ? pNode->Bool : false;
+        }
+        else
+        {
+            bool isArray = arrayIdx != -1;
+
+            ffdValueType type = kIsString ? ffdValueType::String : ffdValueType::Number;
+            if (isArray) type = kIsString ? ffdValueType::StringArray : ffdValueType::NumberArray;
+
+            const Node *pNode = Find(path, type);
+            if (pNode && isArray) pNode = arrayIdx < pNode->Children.Count ? m_pDocument->m_pNodes + pNode->Children.First + arrayIdx : nullptr;
+
+            if constexpr (kIsString)
+                return pNode ? m_pDocument->GetString(*pNode) : "";
+            else
+                return pNode ? (T)pNode->Number : T{};
+        }
+    }
+
+}  // namespace lr
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "ffdParser.hh"
+
+#include <charconv>
+
+namespace lr
+{
+    static bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool IsIdentifierStart(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+    }
+
+    static bool IsIdentifier(char c)
+    {
+        return IsIdentifierStart(c) || IsDigit(c);
+    }
+
+    /// No token or whitespace starts with `c`
+    static bool IsUnexpected(char c)
+    {
+        return !IsIdentifier(c) && !strchr(" \t\r\n\"{}[],=+-./", c);
+    }
+
+    ffdParser::ffdParser(eastl::string_view source, Arena &arena)
+        : m_pCursor(source.data()), m_pEnd(source.data() + source.size()), m_Arena(arena)
+    {
+        // Editors on Windows like to add an UTF-8 BOM
+        if (source.starts_with("\xEF\xBB\xBF")) m_pCursor += 3;
+    }
+
+    bool ffdParser::Parse(ffd::Category &global)
+    {
+        Advance();
+
+        return ParseMembers(global, 0);
+    }
+
+    ffd::Category *ffdParser::GetChild(ffd::Category &parent, eastl::string_view name, Arena &arena)
+    {
+        auto categoryIt = parent.m_Childeren.find_as(name, eastl::hash<eastl::string_view>(), eastl::equal_to_2<eastl::string, eastl::string_view>());
+        if (categoryIt != parent.m_Childeren.end()) return categoryIt->second;
+
+        ffd::Category *pCategory = arena.New<ffd::Category>();
+        parent.m_Childeren.emplace(eastl::string(name.data(), name.size()), pCategory);
+
+        return pCategory;
+    }
+
+    void ffdParser::SkipWhitespace()
+    {
+        while (m_pCursor < m_pEnd)
+        {
+            char c = *m_pCursor;
+
+            if (c == '\n')
+            {
+                m_Line++;
+                m_pCursor++;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r')
+            {
+                m_pCursor++;
+            }
+            else if (c == '/' && m_pCursor + 1 < m_pEnd && m_pCursor[1] == '/')
+            {
+                while (m_pCursor < m_pEnd && *m_pCursor != '\n') m_pCursor++;
+            }
+            else if (c == '/' && m_pCursor + 1 < m_pEnd && m_pCursor[1] == '*')
+            {
+                const char *pComment = m_pCursor + 2;
+                u32 lineCount = 0;
+
+                for (; pComment + 1 < m_pEnd; pComment++)
+                {
+                    if (pComment[0] == '*' && pComment[1] == '/') break;
+                    lineCount += *pComment == '\n';
+                }
+
+                // Unterminated, left for `Advance` to report
+                if (pComment + 1 >= m_pEnd) return;
+
+                m_Line += lineCount;
+                m_pCursor = pComment + 2;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    /// `[+-]?([0-9]*[.])?[0-9]+`, longest match like the flex rule
+    bool ffdParser::ScanNumber()
+    {
+        const char *pCursor = m_pCursor;
+        if (*pCursor == '+' || *pCursor == '-') pCursor++;
+
+        const char *pDigits = pCursor;
+        while (pCursor < m_pEnd && IsDigit(*pCursor)) pCursor++;
+
+        bool hasInteger = pCursor != pDigits;
+
+        if (pCursor + 1 < m_pEnd && pCursor[0] == '.' && IsDigit(pCursor[1]))
+        {
+            pCursor++;
+            while (pCursor < m_pEnd && IsDigit(*pCursor)) pCursor++;
+        }
+        else if (!hasInteger)
+        {
+            return false;
+        }
+
+        m_Token.Type = TokenType::Number;
+        m_Token.Text = eastl::string_view(m_pCursor, pCursor - m_pCursor);
+        m_pCursor = pCursor;
+
+        return true;
+    }
+
+    void ffdParser::Advance()
+    {
+        while (!ScanToken())
+        {
+        }
+    }
+
+    bool ffdParser::ScanToken()
+    {
+        SkipWhitespace();
+
+        m_Token.Line = m_Line;
+
+        if (m_pCursor >= m_pEnd)
+        {
+            m_Token.Type = TokenType::End;
+            m_Token.Text = {};
+            return true;
+        }
+
+        const char *pStart = m_pCursor;
+        char c = *m_pCursor;
+
+        if (IsIdentifierStart(c))
+        {
+            while (m_pCursor < m_pEnd && IsIdentifier(*m_pCursor)) m_pCursor++;
+
+            m_Token.Text = eastl::string_view(pStart, m_pCursor - pStart);
+            m_Token.Type = TokenType::Identifier;
+
+            if (m_Token.Text == "true")
+                m_Token.Type = TokenType::True;
+            else if (m_Token.Text == "false")
+                m_Token.Type = TokenType::False;
+
+            return true;
+        }
+
+        if (c == '"')
+        {
+            const char *pString = pStart + 1;
+            const char *pQuote = (const char *)memchr(pString, '"', m_pEnd - pString);
+
+            if (!pQuote)
+            {
+                m_Token.Type = TokenType::Invalid;
+                m_Token.Text = eastl::string_view(pStart, 1);
+                return true;
+            }
+
+            // Strings may span lines
+            for (const char *p = pString; p < pQuote; p++) m_Line += *p == '\n';
+
+            m_Token.Type = TokenType::String;
+            m_Token.Text = eastl::string_view(pString, pQuote - pString);
+            m_pCursor = pQuote + 1;
+
+            return true;
+        }
+
+        if ((IsDigit(c) || c == '.' || c == '+' || c == '-') && ScanNumber()) return true;
+
+        m_Token.Text = eastl::string_view(pStart, 1);
+        m_pCursor++;
+
+        switch (c)
+        {
+            case '{': m_Token.Type = TokenType::LCurly; break;
+            case '}': m_Token.Type = TokenType::RCurly; break;
+            case '[': m_Token.Type = TokenType::LBracket; break;
+            case ']': m_Token.Type = TokenType::RBracket; break;
+            case ',': m_Token.Type = TokenType::Comma; break;
+            case '=': m_Token.Type = TokenType::Assign; break;
+            default:
+            {
+                // Same as flex's default rule, a run of bytes without a rule is skipped and reported once
+                while (m_pCursor < m_pEnd && IsUnexpected(*m_pCursor)) m_pCursor++;
+
+                LOG_WARN("ffd: Line {}: skipping unexpected '{}'.", m_Line, eastl::string_view(pStart, m_pCursor - pStart));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ffdParser::ParseMembers(ffd::Category &category, u32 depth)
+    {
+        bool isNested = depth > 0;
+
+        while (true)
+        {
+            if (m_Token.Type == TokenType::End)
+            {
+                if (isNested) return Error("'}'");
+
+                return true;
+            }
+
+            if (m_Token.Type == TokenType::RCurly && isNested)
+            {
+                Advance();
+                return true;
+            }
+
+            if (m_Token.Type != TokenType::Identifier) return Error("a name");
+
+            eastl::string_view name = m_Token.Text;
+            Advance();
+
+            if (m_Token.Type == TokenType::LCurly)
+            {
+                // Recursion depth, bison stops at `YYMAXDEPTH` as well
+                if (depth == kMaxDepth)
+                {
+                    LOG_WARN("ffd: Line {}: categories are nested deeper than {}.", m_Token.Line, kMaxDepth);
+                    return false;
+                }
+
+                Advance();
+                if (!ParseMembers(*GetChild(category, name, m_Arena), depth + 1)) return false;
+
+                continue;
+            }
+
+            if (m_Token.Type != TokenType::Assign) return Error("'=' or '{'");
+
+            Advance();
+
+            if (m_Token.Type == TokenType::LBracket)
+            {
+                if (!ParseArray(category, name)) return false;
+
+                continue;
+            }
+
+            ParseValue(category, name);
+        }
+    }
+
+    /// A missing value is allowed, the name is dropped then
+    void ffdParser::ParseValue(ffd::Category &category, eastl::string_view name)
+    {
+        eastl::string key(name.data(), name.size());
+
+        switch (m_Token.Type)
+        {
+            case TokenType::String: category.m_Strings.try_emplace(eastl::move(key), m_Token.Text.data(), m_Token.Text.size()); break;
+            case TokenType::Number: category.m_Numbers.try_emplace(eastl::move(key), GetNumber()); break;
+            case TokenType::True: category.m_Bools.try_emplace(eastl::move(key), true); break;
+            case TokenType::False: category.m_Bools.try_emplace(eastl::move(key), false); break;
+            default: return;
+        }
+
+        Advance();
+    }
+
+    /// Empty elements are skipped, arrays without elements aren't added
+    bool ffdParser::ParseArray(ffd::Category &category, eastl::string_view name)
+    {
+        eastl::vector<eastl::string> *pStrings = nullptr;
+        eastl::vector<double> *pNumbers = nullptr;
+
+        Advance();
+
+        while (true)
+        {
+            if (m_Token.Type == TokenType::String)
+            {
+                if (!pStrings) pStrings = &category.m_ArrayString[eastl::string(name.data(), name.size())];
+
+                pStrings->emplace_back(m_Token.Text.data(), m_Token.Text.size());
+                Advance();
+            }
+            else if (m_Token.Type == TokenType::Number)
+            {
+                if (!pNumbers) pNumbers = &category.m_ArrayNumbers[eastl::string(name.data(), name.size())];
+
+                pNumbers->push_back(GetNumber());
+                Advance();
+            }
+
+            if (m_Token.Type == TokenType::Comma)
+            {
+                Advance();
+            }
+            else if (m_Token.Type == TokenType::RBracket)
+            {
+                Advance();
+                return true;
+            }
+            else
+            {
+                return Error("',' or ']'");
+            }
+        }
+    }
+
+    double ffdParser::GetNumber()
+    {
+        const char *pFirst = m_Token.Text.data();
+        const char *pLast = pFirst + m_Token.Text.size();
+
+        // `from_chars` doesn't take a plus sign
+        if (*pFirst == '+') pFirst++;
+
+        double value = 0.0;
+        std::from_chars(pFirst, pLast, value);
+
+        return value;
+    }
+
+    bool ffdParser::Error(const char *pExpected)
+    {
+        if (m_Token.Type == TokenType::Invalid && m_Token.Text == "\"")
+            LOG_WARN("ffd: Line {}: string is never closed.", m_Token.Line);
+        else if (m_Token.Type == TokenType::End)
+            LOG_WARN("ffd: Line {}: expected {} before the end of the file.", m_Token.Line, pExpected);
+        else
+            LOG_WARN("ffd: Line {}: expected {}, got '{}'.", m_Token.Line, pExpected, m_Token.Text);
+
+        return false;
+    }
+
+}  // namespace lr
\ No newline at end of file
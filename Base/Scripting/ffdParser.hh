@@ -0,0 +1,77 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Utils/Arena.hh"
+
+#include "ffd.hh"
+
+namespace lr
+{
+    /// Single pass recursive descent parser for ffd. Tokens are views into the source, text is copied once when
+    /// a key or string lands in its category and child categories come from the document's arena.
+    /// Accepts the bison grammar plus categories in any order and single letter names. Bytes without a token are
+    /// skipped with a warning like flex does, but an unclosed string is an error and nesting stops at `kMaxDepth`.
+    class ffdParser
+    {
+    public:
+        static constexpr u32 kMaxDepth = 256;
+
+        ffdParser(eastl::string_view source, Arena &arena);
+
+        /// Stops at the first error, everything before it is kept
+        bool Parse(ffd::Category &global);
+
+        /// Existing child or a new one from `arena`, categories with the same name are merged
+        static ffd::Category *GetChild(ffd::Category &parent, eastl::string_view name, Arena &arena);
+
+    private:
+        enum class TokenType : u8
+        {
+            End,
+            Identifier,
+            String,  // text is without quotes
+            Number,
+            True,
+            False,
+            LCurly,
+            RCurly,
+            LBracket,
+            RBracket,
+            Comma,
+            Assign,
+            Invalid,  // unclosed string
+        };
+
+        struct Token
+        {
+            TokenType Type = TokenType::End;
+            eastl::string_view Text;
+            u32 Line = 1;
+        };
+
+        void Advance();
+        /// False if it skipped bytes without a token instead
+        bool ScanToken();
+        void SkipWhitespace();
+        bool ScanNumber();
+
+        /// Global category is at depth 0
+        bool ParseMembers(ffd::Category &category, u32 depth);
+        void ParseValue(ffd::Category &category, eastl::string_view name);
+        bool ParseArray(ffd::Category &category, eastl::string_view name);
+
+        double GetNumber();
+        bool Error(const char *pExpected);
+
+        const char *m_pCursor = nullptr;
+        const char *m_pEnd = nullptr;
+        u32 m_Line = 1;
+
+        Token m_Token;
+        Arena &m_Arena;
+    };
+
+}  // namespace lr
\ No newline at end of file
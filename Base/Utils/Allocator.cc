@@ -1,71 +1,92 @@
-#include "pch.hh"
-
 /// EA ALLOCATOR
+/// `_aligned_offset_malloc` only exists on MSVC, other platforms go through `posix_memalign`
+
+static void *AlignedAlloc(size_t size, size_t alignment)
+{
+#ifdef _WIN32
+    return _aligned_offset_malloc(size, alignment, 0);
+#else
+    void *pData = nullptr;
+    if (posix_memalign(&pData, bx::max(alignment, sizeof(void *)), size) != 0) return nullptr;
+
+    return pData;
+#endif
+}
+
+static void AlignedFree(void *p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
 void *operator new(size_t size)
 {
-    void *PTR = _aligned_offset_malloc(size, 16, 0);
+    void *PTR = AlignedAlloc(size, 16);
     return PTR;
 }
 
 void *operator new[](size_t size)
 {
-    void *PTR = _aligned_offset_malloc(size, 16, 0);
+    void *PTR = AlignedAlloc(size, 16);
     return PTR;
 }
 
 void *operator new[](size_t size, const char * /*name*/, int /*flags*/, unsigned /*debugFlags*/, const char * /*file*/, int /*line*/)
 {
-    void *PTR = _aligned_offset_malloc(size, 16, 0);
+    void *PTR = AlignedAlloc(size, 16);
     return PTR;
 }
 
 void *operator new[](size_t size, size_t alignment, size_t /*alignmentOffset*/, const char * /*name*/, int /*flags*/, unsigned /*debugFlags*/,
                      const char * /*file*/, int /*line*/)
 {
-    void *PTR = _aligned_offset_malloc(size, alignment, 0);
+    void *PTR = AlignedAlloc(size, alignment);
     return PTR;
 }
 
 void *operator new(size_t size, size_t alignment)
 {
-    void *PTR = _aligned_offset_malloc(size, alignment, 0);
+    void *PTR = AlignedAlloc(size, alignment);
     return PTR;
 }
 
 void *operator new(size_t size, size_t alignment, const std::nothrow_t &) EA_THROW_SPEC_NEW_NONE()
 {
-    void *PTR = _aligned_offset_malloc(size, alignment, 0);
+    void *PTR = AlignedAlloc(size, alignment);
     return PTR;
 }
 
 void *operator new[](size_t size, size_t alignment)
 {
-    void *PTR = _aligned_offset_malloc(size, alignment, 0);
+    void *PTR = AlignedAlloc(size, alignment);
     return PTR;
 }
 
 void *operator new[](size_t size, size_t alignment, const std::nothrow_t &) EA_THROW_SPEC_NEW_NONE()
 {
-    void *PTR = _aligned_offset_malloc(size, alignment, 0);
+    void *PTR = AlignedAlloc(size, alignment);
     return PTR;
 }
 
 void operator delete[](void *p) noexcept
 {
-    _aligned_free(p);
+    AlignedFree(p);
 }
 
 void operator delete(void *p, std::size_t sz) EA_THROW_SPEC_DELETE_NONE()
 {
-    _aligned_free(p);
+    AlignedFree(p);
 }
 
 void operator delete[](void *p, std::size_t sz) EA_THROW_SPEC_DELETE_NONE()
 {
-    _aligned_free(p);
+    AlignedFree(p);
 }
 
 void operator delete(void *p) EA_THROW_SPEC_DELETE_NONE()
 {
-    _aligned_free(p);
+    AlignedFree(p);
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Arena.hh"
+
+namespace lr
+{
+    Arena::Arena(u32 blockSize) : m_BlockSize(blockSize)
+    {
+    }
+
+    Arena::~Arena()
+    {
+        Reset();
+    }
+
+    void *Arena::Allocate(size_t size, size_t alignment)
+    {
+        u8 *pData = (u8 *)(((uintptr_t)m_pCursor + alignment - 1) & ~(uintptr_t)(alignment - 1));
+
+        if (!m_pCursor || pData + size > m_pEnd)
+        {
+            // Oversized allocations get a block of their own
+            size_t blockSize = eastl::max((size_t)m_BlockSize, sizeof(Block) + size + alignment);
+
+            Block *pBlock = (Block *)malloc(blockSize);
+            pBlock->pNext = m_pBlock;
+            pBlock->Size = blockSize;
+            m_pBlock = pBlock;
+
+            m_pCursor = (u8 *)(pBlock + 1);
+            m_pEnd = (u8 *)pBlock + blockSize;
+
+            pData = (u8 *)(((uintptr_t)m_pCursor + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        }
+
+        m_pCursor = pData + size;
+
+        return pData;
+    }
+
+    void Arena::Reset()
+    {
+        for (Destructor *pDestructor = m_pDestructors; pDestructor; pDestructor = pDestructor->pNext)
+            pDestructor->pFunc(pDestructor->pObject);
+
+        m_pDestructors = nullptr;
+
+        while (m_pBlock)
+        {
+            Block *pNext = m_pBlock->pNext;
+            free(m_pBlock);
+            m_pBlock = pNext;
+        }
+
+        m_pCursor = nullptr;
+        m_pEnd = nullptr;
+    }
+
+}  // namespace lr
\ No newline at end of file
@@ -0,0 +1,65 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+namespace lr
+{
+    /// Bump allocator over a chain of blocks, memory is only given back when the arena is reset or destroyed.
+    /// Objects made with `New` are destroyed in reverse order on reset, trivially destructible ones cost nothing.
+    class Arena
+    {
+    public:
+        Arena(u32 blockSize = 16 * 1024);
+        ~Arena();
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        void *Allocate(size_t size, size_t alignment);
+
+        template<typename T, typename... Args>
+        T *New(Args &&...args)
+        {
+            T *pObject = new (Allocate(sizeof(T), alignof(T))) T(eastl::forward<Args>(args)...);
+
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                Destructor *pDestructor = (Destructor *)Allocate(sizeof(Destructor), alignof(Destructor));
+                pDestructor->pFunc = [](void *pData) { ((T *)pData)->~T(); };
+                pDestructor->pObject = pObject;
+                pDestructor->pNext = m_pDestructors;
+                m_pDestructors = pDestructor;
+            }
+
+            return pObject;
+        }
+
+        /// Destroys every object and frees all blocks
+        void Reset();
+
+    private:
+        struct Block
+        {
+            Block *pNext;
+            size_t Size;
+        };
+
+        struct Destructor
+        {
+            void (*pFunc)(void *);
+            void *pObject;
+            Destructor *pNext;
+        };
+
+        u32 m_BlockSize = 0;
+
+        Block *m_pBlock = nullptr;
+        u8 *m_pCursor = nullptr;
+        u8 *m_pEnd = nullptr;
+
+        Destructor *m_pDestructors = nullptr;
+    };
+
+}  // namespace lr
\ No newline at end of file
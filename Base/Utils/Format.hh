@@ -20,7 +20,8 @@ namespace fmt
         template<typename FormatContext>
         auto format(eastl::string_view p, FormatContext &ctx) -> decltype(ctx.out())
         {
-            return format_to(ctx.out(), "{:{}}", p.data(), p.size());
+            // Views aren't null terminated
+            return format_to(ctx.out(), "{}", fmt::string_view(p.data(), p.size()));
         }
     };
     
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <typeinfo>
 
 #define HASH_INTERFACE(intf)                                                                                                                                   \
@@ -21,4 +22,50 @@
     inline bool operator==(const intf &lhs, const intf &rhs)                                                                                                   \
     {                                                                                                                                                          \
         return !memcmp(&lhs, &rhs, sizeof(intf));                                                                                                              \
-    }
\ No newline at end of file
+    }
+
+namespace lr::Hash
+{
+    constexpr u64 kFNV64Offset = 0xcbf29ce484222325;
+    constexpr u64 kFNV64Prime = 0x100000001b3;
+
+    /// FNV-1a, pass previous result as `seed` to chain multiple inputs.
+    /// Named apart from `FNV64` so a pointer + size call can't resolve to the template and hash the pointer.
+    inline u64 FNV64Bytes(const void *pData, size_t size, u64 seed = kFNV64Offset)
+    {
+        const u8 *pBytes = (const u8 *)pData;
+
+        u64 hash = seed;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= pBytes[i];
+            hash *= kFNV64Prime;
+        }
+
+        return hash;
+    }
+
+    /// Same result as `FNV64Bytes` over the characters, usable at compile time
+    constexpr u64 FNV64String(eastl::string_view str, u64 seed = kFNV64Offset)
+    {
+        u64 hash = seed;
+        for (char c : str)
+        {
+            hash ^= (u8)c;
+            hash *= kFNV64Prime;
+        }
+
+        return hash;
+    }
+
+    //! Hashes raw bytes, so padding of `T` has to be initialized
+    template<typename T>
+    inline u64 FNV64(const T &value, u64 seed = kFNV64Offset)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only POD types can be hashed.");
+        static_assert(!std::is_pointer_v<T>, "Pointers would hash their address, use FNV64Bytes for the data.");
+
+        return FNV64Bytes(&value, sizeof(T), seed);
+    }
+
+}  // namespace lr::Hash
\ No newline at end of file
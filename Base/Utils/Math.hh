@@ -58,7 +58,7 @@ namespace lr::Math
         *pCos = sign * p;
     }
 
-    constexpr XMFLOAT3 ToFloat3(const XMVECTOR &v)
+    inline XMFLOAT3 ToFloat3(const XMVECTOR &v)
     {
         return XMFLOAT3(XMVectorGetX(v), XMVectorGetY(v), XMVectorGetZ(v));
     }
@@ -0,0 +1,73 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+// Platform neutral part of `pch.hh`, `ProtoCore` and everything linking only it never sees Windows or D3D11 headers
+
+#include <stdint.h>
+
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/map.h>
+#include <EASTL/array.h>
+#include <EASTL/atomic.h>
+#include <EASTL/iterator.h>
+#include <EASTL/queue.h>
+
+#include <bx/bx.h>
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+using namespace DirectX;
+using namespace PackedVector;
+
+#include "Utils/BitFlags.hh"
+#include "Utils/Logger.hh"
+#include "Utils/Math.hh"
+#include "Utils/Timer.hh"
+#include "Utils/Format.hh"
+
+#define SAFE_DELETE(var)                                                                                                                             \
+    if (var)                                                                                                                                         \
+    {                                                                                                                                                \
+        delete var;                                                                                                                                  \
+        var = NULL;                                                                                                                                  \
+    }
+
+#define SAFE_FREE(var)                                                                                                                               \
+    if (var)                                                                                                                                         \
+    {                                                                                                                                                \
+        free(var);                                                                                                                                   \
+        var = NULL;                                                                                                                                  \
+    }
+
+#define _ZEROM(x, len) memset((void *)x, 0, len)
+
+typedef unsigned long long u64;
+typedef signed long long i64;
+
+typedef unsigned int u32;
+typedef signed int i32;
+
+typedef unsigned short u16;
+typedef signed short i16;
+
+typedef unsigned char u8;
+typedef signed char i8;
+
+template<typename T1, typename T2>
+struct eastl::hash<eastl::pair<T1, T2>>
+{
+    size_t operator()(const eastl::pair<T1, T2> &s) const noexcept
+    {
+        size_t h1 = eastl::hash<T1>{}(s.first);
+        size_t h2 = eastl::hash<T2>{}(s.second);
+        return h1 ^ (h2 << 1);
+    }
+};
\ No newline at end of file
@@ -1,27 +1,72 @@
 #include "App.hh"
 
-#include "Utils/Random.hh"
+#include "Utils/Hash.hh"
+#include "IO/FileStream.hh"
 
-#include <cy/cySampleElim.h>
-#include <cy/cyPoint.h>
+#include "CPU/SampleSets.hh"
 
-static void GeneratePoissonDiscSamples(u32 sampleCount, eastl::vector<cy::Point2f> &output)
+#include "LUTTexture.hh"
+
+/// Rough GPU time of a 16x16 tile, there are no timestamp queries to measure them
+constexpr float kTransmittanceTileCostUS = 50.0f;
+constexpr float kMultiScatterTileCostUS = 400.0f;
+
+static u32 GetLUTTileCount(XMINT2 resolution)
+{
+    return ((resolution.x + 15) / 16) * ((resolution.y + 15) / 16);
+}
+
+/// RW target the slices are dispatched into and the front/back textures it's copied to
+static void CreateLUTTextures(XMINT2 resolution, Texture &target, Texture *pLUTs)
 {
-    Random::Seed();
+    TextureDesc textureComputeDesc;
+    textureComputeDesc.Type = TextureType::RW;
+
+    TextureData textureComputeData;
+    textureComputeData.Width = resolution.x;
+    textureComputeData.Height = resolution.y;
+    textureComputeData.Format = TextureFormat::RGBA32F;
+
+    target.Init(&textureComputeDesc, &textureComputeData);
 
-    eastl::vector<cy::Point2f> randomPoints(sampleCount * 10);
+    TextureDesc textureLUTDesc;
+    textureLUTDesc.Type = TextureType::Default;
 
-    for (auto &point : randomPoints)
+    for (u32 i = 0; i < 2; i++)
     {
-        point.x = Random::Float(0, 1);
-        point.y = Random::Float(0, 1);
+        TextureData textureLUTData;
+        textureLUTData.Width = textureComputeData.Width;
+        textureLUTData.Height = textureComputeData.Height;
+        textureLUTData.Format = textureComputeData.Format;
+
+        pLUTs[i].Init(&textureLUTDesc, &textureLUTData);
     }
+}
+
+/// Creating a texture with initial data is a copy on the driver side, it doesn't wait for the GPU
+static void UploadLUT(Texture *pTexture, LUT2D &lut)
+{
+    TextureDesc desc;
+    desc.Type = TextureType::Default;
+
+    TextureData data;
+    GetTextureData(lut, data);
 
-    output.resize(sampleCount);
+    pTexture->Delete();
+    pTexture->Init(&desc, &data);
+}
+
+static u64 HashShaderSource(eastl::string_view path, u64 seed)
+{
+    FileStream fs(Format("Resources/Shaders/{}.hlsl", path), false);
+    if (!fs.IsOK()) return seed;
 
-    cy::WeightedSampleElimination<cy::Point2f, float, 2> eliminator;
-    eliminator.SetTiling(true);
-    eliminator.Eliminate(randomPoints.data(), randomPoints.size(), output.data(), output.size());
+    char *pFileData = fs.ReadAll<char>();
+    u64 hash = Hash::FNV64Bytes(pFileData, fs.Size(), seed);
+    free(pFileData);
+    fs.Close();
+
+    return hash;
 }
 
 void AtmosphereApp::Init()
@@ -31,6 +76,12 @@ void AtmosphereApp::Init()
     m_Config.TransmittanceLUTRes = XMINT2(256, 64);
     m_Config.MultiScatterLUTRes = XMINT2(32, 32);
 
+    /// TRANSMITTANCE INFO
+    m_TransmittanceInfo.RelativeError = 1e-3;
+    m_TransmittanceInfo.MinSteps = 8;
+    m_TransmittanceInfo.MaxSteps = 1024;
+    m_TransmittanceInfo.Adaptive = false;
+
     /// LUT INFO
     m_LUTData.EyePosition = XMFLOAT3(0, 0, 0);
     m_LUTData.StepCount = 48;
@@ -42,6 +93,7 @@ void AtmosphereApp::Init()
     m_SunInfo.SunDirection = m_LUTData.SunDirection;
     m_SunInfo.SunIntensity = m_LUTData.SunIntensity;
     m_SunInfo.SunRadius = 0.4;
+    m_SunInfo.StepCount = m_LUTData.StepCount;
 
     /// MULTI SCATTER INFO
     m_MSInfo.SampleCount = 128;
@@ -55,6 +107,7 @@ void AtmosphereApp::Init()
     ShaderDesc genericShader;
     genericShader.Type = ShaderType::Compute;
     m_TransmittanceCS.Init(&genericShader, "Atmos/Transmittance");
+    m_TransmittanceAdaptiveCS.Init(&genericShader, "Atmos/TransmittanceAdaptive");
     m_MSCS.Init(&genericShader, "Atmos/MultiScatter");
 
     genericShader.Type = ShaderType::Vertex;
@@ -76,6 +129,9 @@ void AtmosphereApp::Init()
     genericBuffer.DataLen = sizeof(Atmosphere);
     m_AtmosphereBuffer.Init(genericBuffer);
 
+    genericBuffer.DataLen = sizeof(TransmittanceInfo);
+    m_TransmittanceBuffer.Init(genericBuffer);
+
     genericBuffer.DataLen = sizeof(SkyLUTData);
     m_SkyLUTBuffer.Init(genericBuffer);
 
@@ -88,9 +144,22 @@ void AtmosphereApp::Init()
     genericBuffer.DataLen = sizeof(MultiScatterInfo);
     m_MSBuffer.Init(genericBuffer);
 
+    genericBuffer.DataLen = sizeof(Atmosphere);
+    m_BakeAtmosphereBuffer.Init(genericBuffer);
+
+    genericBuffer.DataLen = sizeof(SliceInfo);
+    m_SliceBuffer.Init(genericBuffer);
+
     // Sample Buffer for MS
-    eastl::vector<cy::Point2f> samples;
-    GeneratePoissonDiscSamples(m_MSInfo.SampleCount, samples);
+    // Startup only, large sets are generated on every core once and loaded from the cache after that
+    ThreadPool samplePool;
+    samplePool.Init();
+
+    SampleSetCache sampleCache;
+    sampleCache.Init("Cache/Samples");
+
+    eastl::vector<XMFLOAT2> samples;
+    sampleCache.GetPoissonDisc(m_MSInfo.SampleCount, 0, samples, &samplePool);
 
     genericBuffer.Type = RenderBufferType::ShaderResource;
     genericBuffer.MemFlags = RenderBufferMemoryFlags::Structured;
@@ -101,25 +170,97 @@ void AtmosphereApp::Init()
     genericBuffer.DataLen = samples.size() * genericBuffer.ByteStride;
     m_SampleBuffer.Init(genericBuffer);
 
-    /// CALCULATE TRANSMITTANCE
-    UpdateTransmittance();
-    UpdateMS();
+    /// ASYNC CPU BAKER, idle until it's turned on
+    AsyncBakeSettings asyncSettings;
+    asyncSettings.TransmittanceSize = XMUINT2(m_Config.TransmittanceLUTRes.x, m_Config.TransmittanceLUTRes.y);
+    asyncSettings.MultiScatterSize = XMUINT2(m_Config.MultiScatterLUTRes.x, m_Config.MultiScatterLUTRes.y);
+    m_AsyncBaker.Init(asyncSettings, samples.data(), samples.size());
+
+    /// LUT CACHE
+    m_LUTCache.Init("Cache/LUT");
+
+    m_LUTSourceHash = Hash::FNV64Bytes(samples.data(), samples.size() * sizeof(XMFLOAT2));
+    for (eastl::string_view shader : { "Atmos/Common", "Atmos/Slice", "Atmos/Transmittance", "Atmos/TransmittanceAdaptive", "Atmos/MultiScatter" })
+        m_LUTSourceHash = HashShaderSource(shader, m_LUTSourceHash);
+
+    /// LUT UPDATES
+    CreateLUTTextures(m_Config.TransmittanceLUTRes, m_TransmittanceTarget, m_TransmittanceLUTs);
+    CreateLUTTextures(m_Config.MultiScatterLUTRes, m_MSTarget, m_MSLUTs);
+
+    m_TransmittanceStage.SliceCount = GetLUTTileCount(m_Config.TransmittanceLUTRes);
+    m_TransmittanceStage.SliceCostUS = kTransmittanceTileCostUS;
+    m_TransmittanceStage.MeasureCost = false;
+    m_TransmittanceStage.Run = [this](u32 begin, u32 end) {
+        m_API.SetShader(m_pBakeTransmittanceCS);
+        m_API.SetConstantBuffer(&m_BakeAtmosphereBuffer, RenderBufferTarget::Compute, 0);
+        m_API.SetConstantBuffer(&m_TransmittanceBuffer, RenderBufferTarget::Compute, 1);
+        m_API.SetUAVResource(&m_TransmittanceTarget, RenderBufferTarget::Compute, 0);
+        m_API.SetSamplerState(
+            TextureFiltering::Linear, TextureAddress::Clamp, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Compute, 0);
+
+        DispatchLUTTiles(&m_TransmittanceTarget, begin, end);
+    };
+    m_TransmittanceStage.Finish = [this] {
+        Texture *pBack = &m_TransmittanceLUTs[m_TransmittanceFront ^ 1];
+        m_API.GetGPUTexture(pBack, &m_TransmittanceTarget);
+
+        // Readback stalls the GPU, only the first bake is cached. Intermediate states of a transition rarely repeat.
+        if (!m_HasFrontLUTs) m_LUTCache.Store(GetLUTCacheKey(m_BakeHashes[0]), pBack);
+    };
+
+    m_MSStage.SliceCount = GetLUTTileCount(m_Config.MultiScatterLUTRes);
+    m_MSStage.SliceCostUS = kMultiScatterTileCostUS;
+    m_MSStage.MeasureCost = false;
+    m_MSStage.Run = [this](u32 begin, u32 end) {
+        // Transmittance of the same update if it's being rebaked too
+        Texture *pTransmittanceLUT = &m_TransmittanceLUTs[m_Rebaking[0] ? m_TransmittanceFront ^ 1 : m_TransmittanceFront];
+
+        m_API.SetShader(&m_MSCS);
+        m_API.SetConstantBuffer(&m_BakeAtmosphereBuffer, RenderBufferTarget::Compute, 0);
+        m_API.SetConstantBuffer(&m_MSBuffer, RenderBufferTarget::Compute, 1);
+
+        m_API.SetShaderResource(&m_SampleBuffer, RenderBufferTarget::Compute, 0);
+        m_API.SetShaderResource(pTransmittanceLUT, RenderBufferTarget::Compute, 1);
+        m_API.SetUAVResource(&m_MSTarget, RenderBufferTarget::Compute, 0);
+        m_API.SetSamplerState(
+            TextureFiltering::Linear, TextureAddress::Clamp, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Compute, 0);
+
+        DispatchLUTTiles(&m_MSTarget, begin, end);
+    };
+    m_MSStage.Finish = [this] {
+        Texture *pBack = &m_MSLUTs[m_MSFront ^ 1];
+        m_API.GetGPUTexture(pBack, &m_MSTarget);
+
+        if (!m_HasFrontLUTs) m_LUTCache.Store(GetLUTCacheKey(m_BakeHashes[1]), pBack);
+    };
+
+    /// CREATE SKY LUT, every LUT is baked on first `Draw`
     UpdateSkyLut();
 }
 
 void AtmosphereApp::Tick(float deltaTime)
 {
-    m_LUTData.EyePosition.y =
-        bx::clamp(m_Atmosphere.PlanetRadius + XMVectorGetY(m_Camera.GetPosition()), m_Atmosphere.PlanetRadius + 2.0f, m_Atmosphere.AtmosRadius);
+    float eyeHeight = bx::max(m_Atmosphere.PlanetRadius + XMVectorGetY(m_Camera.GetPosition()), m_Atmosphere.PlanetRadius + 2.0f);
 
-    m_SunInfo.EyePosition = m_LUTData.EyePosition;
+    // Sky-view LUT is only sampled inside the atmosphere, keeping its eye at the top stops rebakes while in orbit
+    m_LUTData.EyePosition.y = bx::min(eyeHeight, m_Atmosphere.AtmosRadius);
+
+    m_SunInfo.EyePosition = XMFLOAT3(0, eyeHeight, 0);
     m_SunInfo.SunDirection = m_LUTData.SunDirection;
+    m_SunInfo.SunIntensity = m_LUTData.SunIntensity;
 }
 
 void AtmosphereApp::Draw()
 {
+    /// REBAKE DIRTY LUTS
+    UpdateLUTGraph();
+    bool lutsSwapped = UpdateLUTs();
+
+    Texture *pTransmittanceLUT = &m_TransmittanceLUTs[m_TransmittanceFront];
+    Texture *pMSLUT = &m_MSLUTs[m_MSFront];
+
     /// MAP RENDER BUFFERS TO GPU
-    m_API.MapBuffer(&m_AtmosphereBuffer, &m_Atmosphere, sizeof(Atmosphere));
+    m_API.MapBuffer(&m_AtmosphereBuffer, &m_FrontAtmosphere, sizeof(Atmosphere));
     m_API.MapBuffer(&m_SkyLUTBuffer, &m_LUTData, sizeof(SkyLUTData));
     m_API.MapBuffer(&m_SunBuffer, &m_SunInfo, sizeof(SunInfo));
 
@@ -128,22 +269,28 @@ void AtmosphereApp::Draw()
     m_API.MapBuffer(&m_FrustumBuffer, &frustum, sizeof(CameraFrustum));
 
     /// RENDER LUT
-    m_API.SetRenderTarget(&m_SkyLUT);
-    m_API.ClearRenderTarget(&m_SkyLUT);
+    m_API.SetPrimitiveType(PrimitiveType::TriangleList);
 
-    m_API.SetShader(&m_SkyLUTVS);
-    m_API.SetShader(&m_SkyLUTPS);
+    if (m_LUTGraph.IsDirty(LUTStage::SkyView) || lutsSwapped)
+    {
+        m_API.SetRenderTarget(&m_SkyLUT);
+        m_API.ClearRenderTarget(&m_SkyLUT);
 
-    m_API.SetConstantBuffer(&m_AtmosphereBuffer, RenderBufferTarget::Pixel, 0);
-    m_API.SetConstantBuffer(&m_SkyLUTBuffer, RenderBufferTarget::Pixel, 1);
+        m_API.SetShader(&m_SkyLUTVS);
+        m_API.SetShader(&m_SkyLUTPS);
 
-    m_API.SetShaderResource(&m_TransmittanceLUT, RenderBufferTarget::Pixel, 0);
-    m_API.SetShaderResource(&m_MSLUT, RenderBufferTarget::Pixel, 1);
-    m_API
-        .SetSamplerState(TextureFiltering::Linear, TextureAddress::Clamp, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Pixel, 0);
+        m_API.SetConstantBuffer(&m_AtmosphereBuffer, RenderBufferTarget::Pixel, 0);
+        m_API.SetConstantBuffer(&m_SkyLUTBuffer, RenderBufferTarget::Pixel, 1);
 
-    m_API.SetPrimitiveType(PrimitiveType::TriangleList);
-    m_API.Draw(3);
+        m_API.SetShaderResource(pTransmittanceLUT, RenderBufferTarget::Pixel, 0);
+        m_API.SetShaderResource(pMSLUT, RenderBufferTarget::Pixel, 1);
+        m_API.SetSamplerState(
+            TextureFiltering::Linear, TextureAddress::Clamp, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Pixel, 0);
+
+        m_API.Draw(3);
+
+        m_LUTGraph.MarkBaked(LUTStage::SkyView);
+    }
 
     /// RENDER FINAL
     m_API.SetRenderTarget(nullptr);
@@ -156,14 +303,18 @@ void AtmosphereApp::Draw()
     m_API.SetConstantBuffer(&m_SunBuffer, RenderBufferTarget::Pixel, 2);
 
     m_API.SetShaderResource(m_SkyLUT.m_ColorAttachments[0], RenderBufferTarget::Pixel, 0);
-    m_API.SetShaderResource(&m_TransmittanceLUT, RenderBufferTarget::Pixel, 1);
+    m_API.SetShaderResource(pTransmittanceLUT, RenderBufferTarget::Pixel, 1);
+    m_API.SetShaderResource(pMSLUT, RenderBufferTarget::Pixel, 2);
 
     m_API.SetSamplerState(TextureFiltering::Linear, TextureAddress::Wrap, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Pixel, 0);
+    m_API.SetSamplerState(TextureFiltering::Linear, TextureAddress::Clamp, TextureAddress::Clamp, TextureAddress::Clamp, RenderBufferTarget::Pixel, 1);
 
     m_API.Draw(3);
 
     /// RENDER IMGUI
-    m_Atmosphere.ToReadableUnit();
+    // Edit a copy, converting units back and forth every frame drifts the values and would dirty every LUT
+    Atmosphere atmosphere = m_Atmosphere;
+    atmosphere.ToReadableUnit();
 
     ImGui::SetNextWindowPos(ImVec2(10, 10));
     ImGui::SetNextWindowSize(ImVec2(-FLT_MIN, 600));
@@ -172,22 +323,26 @@ void AtmosphereApp::Draw()
     XMVECTOR pos = m_Camera.GetPosition();
     ImGui::Text("Camera Pos = (%f, %f, %f)", XMVectorGetX(pos), XMVectorGetY(pos), XMVectorGetZ(pos));
 
-    bool updateTLUT = false;
+    bool updateAtmosphere = false;
 
     ImGui::Spacing();
     ImGui::Text("Atmosphere");
     ImGui::Separator();
-    updateTLUT |= ImGui::InputFloat3("(um) Rayleigh Scattering", (float *)&m_Atmosphere.RayleighScatterVal);
-    updateTLUT |= ImGui::InputFloat("(km) Rayleigh Density", &m_Atmosphere.RayleighDensity);
+    updateAtmosphere |= ImGui::InputFloat3("(um) Rayleigh Scattering", (float *)&atmosphere.RayleighScatterVal);
+    updateAtmosphere |= ImGui::InputFloat("(km) Rayleigh Density", &atmosphere.RayleighDensity);
+
+    updateAtmosphere |= ImGui::InputFloat("Mie Asymmetry", &atmosphere.MieAsymmetry);
+    updateAtmosphere |= ImGui::InputFloat("(um) Mie Scattering", &atmosphere.MieScatterVal);
+    updateAtmosphere |= ImGui::InputFloat("(km) Mie Density", &atmosphere.MieDensity);
+    updateAtmosphere |= ImGui::InputFloat("(um) Mie Absorption", &atmosphere.MieAbsorptionVal);
 
-    updateTLUT |= ImGui::InputFloat("Mie Asymmetry", &m_Atmosphere.MieAsymmetry);
-    updateTLUT |= ImGui::InputFloat("(um) Mie Scattering", &m_Atmosphere.MieScatterVal);
-    updateTLUT |= ImGui::InputFloat("(km) Mie Density", &m_Atmosphere.MieDensity);
-    updateTLUT |= ImGui::InputFloat("(um) Mie Absorption", &m_Atmosphere.MieAbsorptionVal);
+    updateAtmosphere |= ImGui::InputFloat3("(um) Ozone Absorption", (float *)&atmosphere.OzoneAbsorption);
+    updateAtmosphere |= ImGui::InputFloat("(km) Ozone Thickness", &atmosphere.OzoneThickness);
+    updateAtmosphere |= ImGui::InputFloat("(km) Ozone Height", &atmosphere.OzoneHeight);
 
-    updateTLUT |= ImGui::InputFloat3("(um) Ozone Absorption", (float *)&m_Atmosphere.OzoneAbsorption);
-    updateTLUT |= ImGui::InputFloat("(km) Ozone Thickness", &m_Atmosphere.OzoneThickness);
-    updateTLUT |= ImGui::InputFloat("(km) Ozone Height", &m_Atmosphere.OzoneHeight);
+    bool adaptiveTransmittance = m_TransmittanceInfo.Adaptive;
+    if (ImGui::Checkbox("Adaptive Transmittance", &adaptiveTransmittance)) m_TransmittanceInfo.Adaptive = adaptiveTransmittance;
+    if (adaptiveTransmittance) ImGui::InputFloat("Relative Error", &m_TransmittanceInfo.RelativeError, 0.0f, 0.0f, "%.6f");
 
     ImGui::Spacing();
     ImGui::Text("Sun");
@@ -202,19 +357,40 @@ void AtmosphereApp::Draw()
     ImGui::Spacing();
     ImGui::Text("Debug");
     ImGui::Separator();
+    if (ImGui::Checkbox("Bake LUTs on CPU", &m_AsyncBake))
+    {
+        // Back textures belong to whichever path is running, start over on the new one
+        m_LUTUpdatePending = false;
+        m_AsyncRequestedHash = 0;
+        m_LUTGraph.Invalidate();
+    }
+
+    if (m_AsyncBake)
+    {
+        ImGui::Text("CPU Bake: %s (last one took %.1fms)", m_AsyncBaker.IsBaking() ? "baking" : "idle", m_AsyncBakeMS);
+    }
+    else
+    {
+        ImGui::SliderFloat("(us) LUT Update Budget", &m_LUTBudgetUS, 100, 5000);
+        ImGui::Text("LUT Update: %.0f%% (last one took %u frames)", m_LUTScheduler.GetProgress() * 100.0f, m_LUTScheduler.GetLastFrameCount());
+    }
+
     if (ImGui::CollapsingHeader("Show Textures"))
     {
-        ImGui::Image(&m_TransmittanceLUT, ImVec2(m_Config.TransmittanceLUTRes.x, m_Config.TransmittanceLUTRes.y));
+        ImGui::Image(pTransmittanceLUT, ImVec2(m_Config.TransmittanceLUTRes.x, m_Config.TransmittanceLUTRes.y));
         ImGui::Image(m_SkyLUT.m_ColorAttachments[0], ImVec2(m_Config.SkyLUTRes.x, m_Config.SkyLUTRes.y));
-        ImGui::Image(&m_MSLUT, ImVec2(m_Config.MultiScatterLUTRes.x, m_Config.MultiScatterLUTRes.y));
+        ImGui::Image(pMSLUT, ImVec2(m_Config.MultiScatterLUTRes.x, m_Config.MultiScatterLUTRes.y));
     }
 
     ImGui::End();
 
-    m_Atmosphere.ToMeters();
+    if (updateAtmosphere)
+    {
+        atmosphere.ToMeters();
+        m_Atmosphere = atmosphere;
+    }
 
     if (updateSun) SetSunDirection(m_SunRotation);
-    if (updateTLUT) UpdateTransmittance();
 }
 
 void AtmosphereApp::SetSunDirection(XMFLOAT2 rotation)
@@ -229,100 +405,145 @@ void AtmosphereApp::SetSunDirection(XMFLOAT2 rotation)
     XMStoreFloat3(&m_LUTData.SunDirection, sunDirection);
 }
 
-void AtmosphereApp::UpdateTransmittance()
+void AtmosphereApp::UpdateLUTGraph()
 {
-    m_TransmittanceLUT.Delete();
+    u64 transmittanceHash = Hash::FNV64(m_Atmosphere);
+    transmittanceHash = Hash::FNV64(m_Config.TransmittanceLUTRes, transmittanceHash);
+    transmittanceHash = Hash::FNV64(m_TransmittanceInfo, transmittanceHash);
+    m_LUTGraph.SetInputs(LUTStage::Transmittance, transmittanceHash);
+
+    // Sample buffer is immutable, no need to hash it
+    u64 msHash = Hash::FNV64(m_MSInfo);
+    msHash = Hash::FNV64(m_Config.MultiScatterLUTRes, msHash);
+    m_LUTGraph.SetInputs(LUTStage::MultiScatter, msHash);
+
+    // Sun and eye only end up here, they never touch transmittance or MS
+    u64 skyHash = Hash::FNV64(m_LUTData);
+    skyHash = Hash::FNV64(m_Config.SkyLUTRes, skyHash);
+    m_LUTGraph.SetInputs(LUTStage::SkyView, skyHash);
+}
 
-    /// CREATE COMPUTE TEXTURE
-    TextureDesc textureComputeDesc;
-    textureComputeDesc.Type = TextureType::RW;
+u64 AtmosphereApp::GetLUTCacheKey(u64 stageHash)
+{
+    return Hash::FNV64(m_LUTSourceHash, stageHash);
+}
 
-    TextureData textureComputeData;
-    textureComputeData.Width = m_Config.TransmittanceLUTRes.x;
-    textureComputeData.Height = m_Config.TransmittanceLUTRes.y;
-    textureComputeData.Format = TextureFormat::RGBA32F;
+bool AtmosphereApp::UpdateLUTs()
+{
+    if (m_AsyncBake && m_HasFrontLUTs) return UpdateLUTsAsync();
 
-    Texture textureCompute;
-    textureCompute.Init(&textureComputeDesc, &textureComputeData);
+    if (!m_LUTUpdatePending)
+    {
+        // MS hash is chained to transmittance's, it's dirty whenever either of them is
+        if (!m_LUTGraph.IsDirty(LUTStage::MultiScatter)) return false;
 
-    /// CREATE TRANSMITTANCE TEXTURE
-    TextureDesc textureTransDesc;
-    textureTransDesc.Type = TextureType::Default;
+        BeginLUTUpdate(m_LUTGraph.IsDirty(LUTStage::Transmittance));
+    }
 
-    TextureData textureTransData;
-    textureTransData.Width = textureComputeData.Width;
-    textureTransData.Height = textureComputeData.Height;
-    textureTransData.Format = textureComputeData.Format;
+    // There is nothing to show before the first bake, it runs in one go
+    if (!m_HasFrontLUTs)
+        m_LUTScheduler.Flush();
+    else if (m_LUTScheduler.IsBusy() && !m_LUTScheduler.Update(m_LUTBudgetUS))
+        return false;
 
-    m_TransmittanceLUT.Init(&textureTransDesc, &textureTransData);
+    /// SWAP IN NEW LUTS
+    if (m_Rebaking[0])
+    {
+        m_TransmittanceFront ^= 1;
+        m_LUTGraph.MarkBaked(LUTStage::Transmittance, m_BakeHashes[0]);
+    }
 
-    /// MAP ATMOSPHERE BUFFER
-    m_API.MapBuffer(&m_AtmosphereBuffer, &m_Atmosphere, sizeof(Atmosphere));
+    m_MSFront ^= 1;
+    m_LUTGraph.MarkBaked(LUTStage::MultiScatter, m_BakeHashes[1]);
 
-    /// PREPARE STATE
-    m_API.SetShader(&m_TransmittanceCS);
-    m_API.SetConstantBuffer(&m_AtmosphereBuffer, RenderBufferTarget::Compute, 0);
-    m_API.SetUAVResource(&textureCompute, RenderBufferTarget::Compute, 0);
-    m_API.SetSamplerState(TextureFiltering::Linear,
-                          TextureAddress::Clamp,
-                          TextureAddress::Clamp,
-                          TextureAddress::Clamp,
-                          RenderBufferTarget::Compute,
-                          0);
+    m_FrontAtmosphere = m_BakeAtmosphere;
+    m_HasFrontLUTs = true;
+    m_LUTUpdatePending = false;
 
-    m_API.Dispatch(ceil(textureComputeData.Width / 16), ceil(textureComputeData.Height / 16), 1);
-    m_API.GetGPUTexture(&m_TransmittanceLUT, &textureCompute);
+    return true;
 }
 
-void AtmosphereApp::UpdateMS()
+bool AtmosphereApp::UpdateLUTsAsync()
 {
-    m_MSLUT.Delete();
+    // Only the latest request is baked, the ones in between are dropped without waiting
+    u64 msHash = m_LUTGraph.GetHash(LUTStage::MultiScatter);
+    if (m_LUTGraph.IsDirty(LUTStage::MultiScatter) && msHash != m_AsyncRequestedHash)
+    {
+        AsyncBakeRequest request;
+        request.Atmos = m_Atmosphere;
 
-    /// CREATE COMPUTE TEXTURE
-    TextureDesc textureComputeDesc;
-    textureComputeDesc.Type = TextureType::RW;
+        request.Transmittance.Mode = m_TransmittanceInfo.Adaptive ? IntegratorMode::Adaptive : IntegratorMode::Uniform;
+        request.Transmittance.RelativeError = m_TransmittanceInfo.RelativeError;
+        request.Transmittance.MinSteps = m_TransmittanceInfo.MinSteps;
+        request.Transmittance.MaxSteps = m_TransmittanceInfo.MaxSteps;
 
-    TextureData textureComputeData;
-    textureComputeData.Width = m_Config.MultiScatterLUTRes.x;
-    textureComputeData.Height = m_Config.MultiScatterLUTRes.y;
-    textureComputeData.Format = TextureFormat::RGBA32F;
+        request.MultiScatter.TerrainAlbedo = m_MSInfo.TerrainAlbedo;
+        request.MultiScatter.StepCount = (u32)m_MSInfo.StepCount;
+
+        request.TransmittanceTag = m_LUTGraph.GetHash(LUTStage::Transmittance);
+        request.MultiScatterTag = msHash;
+
+        m_AsyncBaker.Request(request);
+        m_AsyncRequestedHash = msHash;
+    }
+
+    AsyncBakeResult *pResult = m_AsyncBaker.Poll();
+    if (!pResult) return false;
 
-    Texture textureCompute;
-    textureCompute.Init(&textureComputeDesc, &textureComputeData);
+    /// SWAP IN NEW LUTS
+    UploadLUT(&m_TransmittanceLUTs[m_TransmittanceFront ^ 1], pResult->Transmittance);
+    UploadLUT(&m_MSLUTs[m_MSFront ^ 1], pResult->MultiScatter);
 
-    /// CREATE MULTISCATTER TEXTURE
-    TextureDesc textureMSDesc;
-    textureMSDesc.Type = TextureType::Default;
+    m_TransmittanceFront ^= 1;
+    m_MSFront ^= 1;
 
-    TextureData textureMSData;
-    textureMSData.Width = textureComputeData.Width;
-    textureMSData.Height = textureComputeData.Height;
-    textureMSData.Format = textureComputeData.Format;
+    m_LUTGraph.MarkBaked(LUTStage::Transmittance, pResult->Request.TransmittanceTag);
+    m_LUTGraph.MarkBaked(LUTStage::MultiScatter, pResult->Request.MultiScatterTag);
 
-    m_MSLUT.Init(&textureMSDesc, &textureMSData);
+    m_FrontAtmosphere = pResult->Request.Atmos;
+    m_AsyncBakeMS = pResult->BakeSeconds * 1e3;
 
-    /// MAP BUFFERS
-    m_API.MapBuffer(&m_AtmosphereBuffer, &m_Atmosphere, sizeof(Atmosphere));
+    return true;
+}
+
+void AtmosphereApp::BeginLUTUpdate(bool transmittanceDirty)
+{
+    /// SNAPSHOT INPUTS, they keep changing while the update is in flight
+    m_BakeAtmosphere = m_Atmosphere;
+    m_pBakeTransmittanceCS = m_TransmittanceInfo.Adaptive ? &m_TransmittanceAdaptiveCS : &m_TransmittanceCS;
+
+    m_API.MapBuffer(&m_BakeAtmosphereBuffer, &m_BakeAtmosphere, sizeof(Atmosphere));
+    m_API.MapBuffer(&m_TransmittanceBuffer, &m_TransmittanceInfo, sizeof(TransmittanceInfo));
     m_API.MapBuffer(&m_MSBuffer, &m_MSInfo, sizeof(MultiScatterInfo));
 
-    /// PREPARE STATE
-    m_API.SetShader(&m_MSCS);
-    m_API.SetConstantBuffer(&m_AtmosphereBuffer, RenderBufferTarget::Compute, 0);
-    m_API.SetConstantBuffer(&m_MSBuffer, RenderBufferTarget::Compute, 1);
+    m_BakeHashes[0] = m_LUTGraph.GetHash(LUTStage::Transmittance);
+    m_BakeHashes[1] = m_LUTGraph.GetHash(LUTStage::MultiScatter);
+    m_Rebaking[0] = transmittanceDirty;
+    m_Rebaking[1] = true;
+
+    /// SCHEDULE STAGES, cached ones are loaded straight into their back texture
+    LUTUpdateStage *pStages[2];
+    u32 stageCount = 0;
 
-    m_API.SetShaderResource(&m_SampleBuffer, RenderBufferTarget::Compute, 0);
-    m_API.SetShaderResource(&m_TransmittanceLUT, RenderBufferTarget::Compute, 1);
-    m_API.SetUAVResource(&textureCompute, RenderBufferTarget::Compute, 0);
+    if (transmittanceDirty && !m_LUTCache.Load(GetLUTCacheKey(m_BakeHashes[0]), &m_TransmittanceLUTs[m_TransmittanceFront ^ 1]))
+        pStages[stageCount++] = &m_TransmittanceStage;
+
+    if (!m_LUTCache.Load(GetLUTCacheKey(m_BakeHashes[1]), &m_MSLUTs[m_MSFront ^ 1])) pStages[stageCount++] = &m_MSStage;
+
+    m_LUTScheduler.Begin(pStages, stageCount);
+    m_LUTUpdatePending = true;
+}
+
+void AtmosphereApp::DispatchLUTTiles(Texture *pTarget, u32 begin, u32 end)
+{
+    SliceInfo slice;
+    slice.TileOffset = begin;
+    slice.TileCountX = (pTarget->GetWidth() + 15) / 16;
 
-    m_API.SetSamplerState(TextureFiltering::Linear,
-                          TextureAddress::Clamp,
-                          TextureAddress::Clamp,
-                          TextureAddress::Clamp,
-                          RenderBufferTarget::Compute,
-                          0);
+    m_API.MapBuffer(&m_SliceBuffer, &slice, sizeof(SliceInfo));
+    m_API.SetConstantBuffer(&m_SliceBuffer, RenderBufferTarget::Compute, 2);
 
-    m_API.Dispatch(ceil(textureComputeData.Width / 16), ceil(textureComputeData.Height / 16), 1);
-    m_API.GetGPUTexture(&m_MSLUT, &textureCompute);
+    m_API.Dispatch(end - begin, 1, 1);
 }
 
 void AtmosphereApp::UpdateSkyLut()
@@ -6,86 +6,14 @@
 
 #include "Core/BaseApp.hh"
 
-using namespace lr;
-
-struct Atmosphere
-{
-    XMFLOAT3 RayleighScatterVal = { 5.802, 13.558, 33.1 };
-    float RayleighDensity = 8;
-
-    float PlanetRadius = 6360;
-    float AtmosRadius = 6460;
-
-    float MieScatterVal = 3.996;
-    float MieAbsorptionVal = 4.4;
-    float MieDensity = 1.2;
-    float MieAsymmetry = 0.8;
-
-    float OzoneHeight = 25;
-    float OzoneThickness = 15;
-    XMFLOAT3 OzoneAbsorption = { 0.650, 1.881, 0.085 };
-
-    float __padding;
-
-    Atmosphere()
-    {
-        ToMeters();
-    }
-
-    void ToMeters()
-    {
-        constexpr static float kuM = 1e-6;
-        constexpr static float kKM = 1e3;
-
-        RayleighDensity *= kKM;
-
-        PlanetRadius *= kKM;
-        AtmosRadius *= kKM;
-
-        MieDensity *= kKM;
-
-        OzoneHeight *= kKM;
-        OzoneThickness *= kKM;
-
-        RayleighScatterVal.x *= kuM;
-        RayleighScatterVal.y *= kuM;
-        RayleighScatterVal.z *= kuM;
-
-        MieScatterVal *= kuM;
-        MieAbsorptionVal *= kuM;
-
-        OzoneAbsorption.x *= kuM;
-        OzoneAbsorption.y *= kuM;
-        OzoneAbsorption.z *= kuM;
-    }
-
-    void ToReadableUnit()
-    {
-        constexpr static float kuM = 1e-6;
-        constexpr static float kKM = 1e3;
-
-        RayleighDensity /= kKM;
-
-        PlanetRadius /= kKM;
-        AtmosRadius /= kKM;
-
-        MieDensity /= kKM;
-
-        OzoneHeight /= kKM;
-        OzoneThickness /= kKM;
+#include "Atmosphere.hh"
+#include "LUTGraph.hh"
+#include "LUTCache.hh"
 
-        RayleighScatterVal.x /= kuM;
-        RayleighScatterVal.y /= kuM;
-        RayleighScatterVal.z /= kuM;
+#include "CPU/AsyncBaker.hh"
+#include "CPU/LUTUpdateScheduler.hh"
 
-        MieScatterVal /= kuM;
-        MieAbsorptionVal /= kuM;
-
-        OzoneAbsorption.x /= kuM;
-        OzoneAbsorption.y /= kuM;
-        OzoneAbsorption.z /= kuM;
-    }
-};
+using namespace lr;
 
 class AtmosphereApp : public BaseApp
 {
@@ -96,10 +24,25 @@ public:
 
     void SetSunDirection(XMFLOAT2 rotation);
     
-    void UpdateTransmittance();
-    void UpdateMS();
+    /// Transmittance and MS are rebaked a few tiles per frame within `m_LUTBudgetUS`, into back textures that
+    /// are swapped in together once both are done. Returns true on the frame new LUTs are swapped in.
+    bool UpdateLUTs();
+    void BeginLUTUpdate(bool transmittanceDirty);
+
+    /// CPU path of `UpdateLUTs`, requests a bake from `m_AsyncBaker` and uploads its result once it shows up
+    bool UpdateLUTsAsync();
+
+    /// Dispatches tiles [begin, end) of `Atmos/Slice.hlsl` into `pTarget`, state has to be set
+    void DispatchLUTTiles(Texture *pTarget, u32 begin, u32 end);
+
     void UpdateSkyLut();
 
+    /// Hashes inputs of every LUT stage, dirty ones are rebaked in `Draw`
+    void UpdateLUTGraph();
+
+    /// Stage hash combined with everything that isn't a struct (shader sources, MS samples)
+    u64 GetLUTCacheKey(u64 stageHash);
+
 private:
     struct SkyConfig
     {
@@ -108,6 +51,14 @@ private:
         XMINT2 MultiScatterLUTRes;
     } m_Config;
 
+    struct TransmittanceInfo
+    {
+        float RelativeError;
+        u32 MinSteps;
+        u32 MaxSteps;
+        u32 Adaptive;  // Picks `Atmos/TransmittanceAdaptive`, lands in shader padding
+    } m_TransmittanceInfo;
+
     struct SkyLUTData
     {
         XMFLOAT3 EyePosition;
@@ -116,12 +67,16 @@ private:
         float SunIntensity;
     } m_LUTData;
 
+    /// Eye isn't clamped to the atmosphere here, final pass marches every pixel when it's above
     struct SunInfo
     {
         XMFLOAT3 EyePosition;
         float SunRadius;
         XMFLOAT3 SunDirection;
         float SunIntensity;
+        float StepCount;
+
+        float _padding[3] = {};
     } m_SunInfo;
 
     struct MultiScatterInfo
@@ -131,14 +86,55 @@ private:
         u32 SampleCount;
         float SunIntensity;
         
-        float _padding[2];
+        float _padding[2] = {};
     } m_MSInfo;
+
+    struct SliceInfo
+    {
+        u32 TileOffset;
+        u32 TileCountX;
+
+        u32 _padding[2] = {};
+    };
  
 private:
     XMFLOAT2 m_SunRotation;
 
+    LUTGraph m_LUTGraph;
+    LUTCache m_LUTCache;
+    u64 m_LUTSourceHash = 0;
+
+    LUTUpdateScheduler m_LUTScheduler;
+    LUTUpdateStage m_TransmittanceStage;
+    LUTUpdateStage m_MSStage;
+    float m_LUTBudgetUS = 1000;
+
+    /// Inputs of the update in flight, compute passes only see these
+    Atmosphere m_BakeAtmosphere;
+    Shader *m_pBakeTransmittanceCS = nullptr;
+    RenderBuffer m_BakeAtmosphereBuffer;
+    RenderBuffer m_SliceBuffer;
+    u64 m_BakeHashes[2] = {};
+    bool m_Rebaking[2] = {};  // Transmittance, MS
+    bool m_LUTUpdatePending = false;
+
+    /// Transmittance and MS baked on a worker thread instead, toggled from the UI
+    AsyncLUTBaker m_AsyncBaker;
+    bool m_AsyncBake = false;
+    u64 m_AsyncRequestedHash = 0;
+    float m_AsyncBakeMS = 0;
+
+    /// Atmosphere the front LUTs were baked with, sky-view and final pass use it so they match the LUTs
+    Atmosphere m_FrontAtmosphere;
+    bool m_HasFrontLUTs = false;
+
+    /// Slices land in the RW target, a finished stage is copied into its back texture
     Shader m_TransmittanceCS;
-    Texture m_TransmittanceLUT;
+    Shader m_TransmittanceAdaptiveCS;
+    RenderBuffer m_TransmittanceBuffer;
+    Texture m_TransmittanceTarget;
+    Texture m_TransmittanceLUTs[2];
+    u32 m_TransmittanceFront = 0;
 
     Shader m_SkyLUTVS;
     Shader m_SkyLUTPS;
@@ -157,5 +153,7 @@ private:
     Shader m_MSCS;
     RenderBuffer m_MSBuffer;
     RenderBuffer m_SampleBuffer;
-    Texture m_MSLUT;
+    Texture m_MSTarget;
+    Texture m_MSLUTs[2];
+    u32 m_MSFront = 0;
 };
\ No newline at end of file
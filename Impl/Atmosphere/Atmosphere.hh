@@ -0,0 +1,84 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+struct Atmosphere
+{
+    XMFLOAT3 RayleighScatterVal = { 5.802, 13.558, 33.1 };
+    float RayleighDensity = 8;
+
+    float PlanetRadius = 6360;
+    float AtmosRadius = 6460;
+
+    float MieScatterVal = 3.996;
+    float MieAbsorptionVal = 4.4;
+    float MieDensity = 1.2;
+    float MieAsymmetry = 0.8;
+
+    float OzoneHeight = 25;
+    float OzoneThickness = 15;
+    XMFLOAT3 OzoneAbsorption = { 0.650, 1.881, 0.085 };
+
+    float __padding = 0;
+
+    Atmosphere()
+    {
+        ToMeters();
+    }
+
+    void ToMeters()
+    {
+        constexpr static float kuM = 1e-6;
+        constexpr static float kKM = 1e3;
+
+        RayleighDensity *= kKM;
+
+        PlanetRadius *= kKM;
+        AtmosRadius *= kKM;
+
+        MieDensity *= kKM;
+
+        OzoneHeight *= kKM;
+        OzoneThickness *= kKM;
+
+        RayleighScatterVal.x *= kuM;
+        RayleighScatterVal.y *= kuM;
+        RayleighScatterVal.z *= kuM;
+
+        MieScatterVal *= kuM;
+        MieAbsorptionVal *= kuM;
+
+        OzoneAbsorption.x *= kuM;
+        OzoneAbsorption.y *= kuM;
+        OzoneAbsorption.z *= kuM;
+    }
+
+    void ToReadableUnit()
+    {
+        constexpr static float kuM = 1e-6;
+        constexpr static float kKM = 1e3;
+
+        RayleighDensity /= kKM;
+
+        PlanetRadius /= kKM;
+        AtmosRadius /= kKM;
+
+        MieDensity /= kKM;
+
+        OzoneHeight /= kKM;
+        OzoneThickness /= kKM;
+
+        RayleighScatterVal.x /= kuM;
+        RayleighScatterVal.y /= kuM;
+        RayleighScatterVal.z /= kuM;
+
+        MieScatterVal /= kuM;
+        MieAbsorptionVal /= kuM;
+
+        OzoneAbsorption.x /= kuM;
+        OzoneAbsorption.y /= kuM;
+        OzoneAbsorption.z /= kuM;
+    }
+};
\ No newline at end of file
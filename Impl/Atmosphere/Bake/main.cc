@@ -0,0 +1,192 @@
+#include "Scripting/ffd.hh"
+#include "Utils/Timer.hh"
+
+#include <EASTL/sort.h>
+
+#include "CPU/LUTArchive.hh"
+#include "CPU/PresetBaker.hh"
+
+using namespace lr;
+
+/// Bakes transmittance, MS and sky-view LUTs of every preset in a ffd file into one LUT archive.
+/// Every top level category is a preset, values are in the same units as the app UI and
+/// missing ones keep their Earth defaults.
+///
+/// Usage: AtmosphereBake <presets.ffd> <output.luta> [--lanes N] [--threads-per-lane N] [--format F]
+/// `F` is the storage format of every LUT: rgba32f (default), rgba16f, r11g11b10f or rgb9e5.
+
+static void ReadFloat(ffd::Category &category, const char *pName, float &value)
+{
+    if (category.m_Numbers.count(pName)) value = category.AsFloat(pName);
+}
+
+static void ReadFloat3(ffd::Category &category, const char *pName, XMFLOAT3 &value)
+{
+    if (category.GetNumberArraySize(pName) != 3)
+    {
+        if (category.GetNumberArraySize(pName)) LOG_WARN("'{}' needs 3 values, ignoring it.", pName);
+        return;
+    }
+
+    value.x = category.AsFloat(pName, 0);
+    value.y = category.AsFloat(pName, 1);
+    value.z = category.AsFloat(pName, 2);
+}
+
+static void LoadPresets(const char *pPath, eastl::vector<AtmospherePreset> &presets)
+{
+    ffd file;
+    file.FromFile(pPath);
+
+    for (auto &[name, pCategory] : file.Global().m_Childeren)
+    {
+        AtmospherePreset &preset = presets.emplace_back();
+        preset.Name = name;
+
+        Atmosphere &atmos = preset.Atmos;
+        atmos.ToReadableUnit();
+
+        ReadFloat3(*pCategory, "RayleighScattering", atmos.RayleighScatterVal);
+        ReadFloat(*pCategory, "RayleighDensity", atmos.RayleighDensity);
+
+        ReadFloat(*pCategory, "PlanetRadius", atmos.PlanetRadius);
+        ReadFloat(*pCategory, "AtmosRadius", atmos.AtmosRadius);
+
+        ReadFloat(*pCategory, "MieScattering", atmos.MieScatterVal);
+        ReadFloat(*pCategory, "MieAbsorption", atmos.MieAbsorptionVal);
+        ReadFloat(*pCategory, "MieDensity", atmos.MieDensity);
+        ReadFloat(*pCategory, "MieAsymmetry", atmos.MieAsymmetry);
+
+        ReadFloat(*pCategory, "OzoneHeight", atmos.OzoneHeight);
+        ReadFloat(*pCategory, "OzoneThickness", atmos.OzoneThickness);
+        ReadFloat3(*pCategory, "OzoneAbsorption", atmos.OzoneAbsorption);
+
+        atmos.ToMeters();
+    }
+
+    // Categories are unordered, keep archives reproducible
+    eastl::sort(presets.begin(), presets.end(), [](const AtmospherePreset &a, const AtmospherePreset &b) {
+        return a.Name < b.Name;
+    });
+}
+
+static TextureFormat GetFormat(const char *pName)
+{
+    if (!strcmp(pName, "rgba32f")) return TextureFormat::RGBA32F;
+    if (!strcmp(pName, "rgba16f")) return TextureFormat::RGBA16F;
+    if (!strcmp(pName, "r11g11b10f")) return TextureFormat::R11G11B10F;
+    if (!strcmp(pName, "rgb9e5")) return TextureFormat::RGB9E5;
+
+    return TextureFormat::Unidentified;
+}
+
+static void LogPrecisionLoss(const char *pPreset, const char *pStage, const LUT2D &lut, TextureFormat format)
+{
+    LUTErrorReport report = LUTFormat::GetPrecisionLoss(lut, format);
+
+    LOG_INFO("{:>16} {:<14} max abs {:.3e}, mean abs {:.3e}, max rel {:.3e}", pPreset, pStage, report.MaxAbsError, report.MeanAbsError,
+             report.MaxRelError);
+}
+
+static void PrintUsage(const char *pProgram)
+{
+    printf("Usage: %s <presets.ffd> <output.luta> [--lanes N] [--threads-per-lane N] [--format rgba32f|rgba16f|r11g11b10f|rgb9e5]\n", pProgram);
+}
+
+int main(int argc, char **argv)
+{
+    Logger::Init();
+
+    if (argc < 3)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    u32 laneCount = 0;
+    u32 threadsPerLane = 0;
+    TextureFormat format = TextureFormat::RGBA32F;
+
+    // A typo must not bake an archive with different settings, every option takes a value
+    for (int i = 3; i < argc; i += 2)
+    {
+        bool isKnown = !strcmp(argv[i], "--lanes") || !strcmp(argv[i], "--threads-per-lane") || !strcmp(argv[i], "--format");
+        if (!isKnown || i + 1 >= argc)
+        {
+            if (isKnown)
+                LOG_WARN("Option '{}' needs a value.", argv[i]);
+            else
+                LOG_WARN("Unknown option '{}'.", argv[i]);
+
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        if (!strcmp(argv[i], "--lanes"))
+            laneCount = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--threads-per-lane"))
+            threadsPerLane = atoi(argv[i + 1]);
+        else
+            format = GetFormat(argv[i + 1]);
+    }
+
+    if (format == TextureFormat::Unidentified)
+    {
+        LOG_WARN("Unknown storage format, use one of rgba32f, rgba16f, r11g11b10f or rgb9e5.");
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    eastl::vector<AtmospherePreset> presets;
+    LoadPresets(argv[1], presets);
+
+    if (presets.empty())
+    {
+        LOG_ERROR("No presets found in '{}'.", argv[1]);
+        return 1;
+    }
+
+    PresetBaker baker;
+    baker.Init(laneCount, threadsPerLane);
+
+    LOG_INFO("Baking {} presets on {} lanes x {} threads...", presets.size(), baker.GetLaneCount(), baker.GetThreadsPerLane());
+
+    // Archives have to be the same no matter which CPU baked them
+    PresetBakeSettings settings;
+    settings.MultiScatter.MaxKernelISA = KernelISA::SSE;
+
+    eastl::vector<PresetLUTs> outputs(presets.size());
+
+    Timer timer;
+    baker.Bake(presets.data(), presets.size(), settings, outputs.data());
+
+    LOG_INFO("Baked in {:.2f}s.", timer.elapsed());
+
+    LUTArchiveWriter writer;
+    for (u32 i = 0; i < presets.size(); i++)
+    {
+        writer.Add(presets[i].Name, LUTStage::Transmittance, outputs[i].Transmittance, format);
+        writer.Add(presets[i].Name, LUTStage::MultiScatter, outputs[i].MultiScatter, format);
+        writer.Add(presets[i].Name, LUTStage::SkyView, outputs[i].SkyView, format);
+    }
+
+    if (format != TextureFormat::RGBA32F)
+    {
+        LOG_INFO("Precision loss of the storage format:");
+
+        for (u32 i = 0; i < presets.size(); i++)
+        {
+            const char *pName = presets[i].Name.c_str();
+
+            LogPrecisionLoss(pName, "transmittance", outputs[i].Transmittance, format);
+            LogPrecisionLoss(pName, "multi scatter", outputs[i].MultiScatter, format);
+            LogPrecisionLoss(pName, "sky-view", outputs[i].SkyView, format);
+        }
+    }
+
+    if (!writer.Write(argv[2])) return 1;
+
+    LOG_INFO("Wrote {}.", argv[2]);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,910 @@
+#include "Utils/Random.hh"
+#include "Utils/Timer.hh"
+
+#include "Scripting/ffd.hh"
+#include "Scripting/ffdDocument.hh"
+
+#include "CPU/TransmittanceBaker.hh"
+#include "CPU/MultiScatterBaker.hh"
+#include "CPU/SkyViewBaker.hh"
+#include "CPU/AerialPerspective.hh"
+#include "CPU/LUTFormat.hh"
+#include "CPU/SampleSets.hh"
+#include "CPU/Spectral.hh"
+#include "CPU/AmortizedBaker.hh"
+#include "CPU/FinalPass.hh"
+#include "CPU/ImageWriter.hh"
+
+#include <EASTL/sort.h>
+
+#include <filesystem>
+
+using namespace lr;
+
+/// Times every CPU LUT stage across step counts, resolutions and thread counts.
+/// Error is RMSE (RGB) against a high step bake of the same stage, inputs of a stage are always
+/// the reference LUTs of the previous stages so only the stage being measured contributes.
+
+static constexpr u32 kRepeatCount = 3;
+
+struct BenchContext
+{
+    Atmosphere Atmos;
+    eastl::vector<XMFLOAT2> MSSamples;
+    eastl::vector<u32> ThreadCounts;
+
+    bool Quick = false;
+    const char *pImageDir = nullptr;  // final pass images are written here if set
+
+    TransmittanceBaker TransmittanceRef;
+    MultiScatterBaker MultiScatterRef;
+    SkyViewBaker SkyViewRef;
+    AerialPerspectiveBuilder FroxelRef;
+
+    SkyViewSettings SkyView;
+    AerialPerspectiveSettings Froxel;
+    CameraFrustum Frustum = {};
+};
+
+static float GetRMSE(const eastl::vector<XMFLOAT4> &texels, const eastl::vector<XMFLOAT4> &reference)
+{
+    double total = 0.0;
+
+    for (u32 i = 0; i < texels.size(); i++)
+    {
+        XMVECTOR error = XMLoadFloat4(&texels[i]) - XMLoadFloat4(&reference[i]);
+        total += XMVectorGetX(XMVector3Dot(error, error));
+    }
+
+    return sqrt(total / (texels.size() * 3));
+}
+
+/// `lut` is bilinearly sampled at texel centers of `reference`, so lower resolutions include their interpolation error
+static float GetRMSE(const LUT2D &lut, const LUT2D &reference)
+{
+    double total = 0.0;
+
+    for (u32 y = 0; y < reference.Height; y++)
+    {
+        for (u32 x = 0; x < reference.Width; x++)
+        {
+            XMVECTOR value = lut.Sample((x + 0.5f) / reference.Width, (y + 0.5f) / reference.Height);
+            XMVECTOR error = value - XMLoadFloat4(&reference.At(x, y));
+            total += XMVectorGetX(XMVector3Dot(error, error));
+        }
+    }
+
+    return sqrt(total / (reference.Texels.size() * 3));
+}
+
+/// Best of `kRepeatCount` runs in seconds
+template<typename Func>
+static double Measure(Func func)
+{
+    double best = DBL_MAX;
+
+    for (u32 i = 0; i < kRepeatCount; i++)
+    {
+        Timer timer;
+        func();
+        best = eastl::min(best, timer.elapsed());
+    }
+
+    return best;
+}
+
+static void PrintHeader(const char *pStage)
+{
+    printf("\n%s\n", pStage);
+    printf("%-28s %-10s %8s %12s %12s %12s\n", "config", "size", "threads", "ms", "ns/texel", "rmse");
+}
+
+static void PrintResult(const char *pConfig, const char *pSize, u32 threadCount, double seconds, u32 texelCount, float rmse)
+{
+    printf("%-28s %-10s %8u %12.3f %12.2f %12.3e\n", pConfig, pSize, threadCount, seconds * 1e3, seconds * 1e9 / texelCount, rmse);
+}
+
+static void BakeReferences(BenchContext &ctx, ThreadPool *pPool)
+{
+    IntegratorSettings transmittanceSettings;
+    transmittanceSettings.Mode = IntegratorMode::Adaptive;
+    transmittanceSettings.RelativeError = 1e-7f;
+    transmittanceSettings.MinSteps = 1 << 12;
+    transmittanceSettings.MaxSteps = 1 << 16;
+
+    ctx.TransmittanceRef.Init(256, 64, transmittanceSettings);
+    ctx.TransmittanceRef.Bake(ctx.Atmos, pPool);
+
+    MultiScatterSettings multiScatterSettings;
+    multiScatterSettings.StepCount = ctx.Quick ? 512 : 2048;
+    multiScatterSettings.MaxKernelISA = KernelISA::SSE;
+
+    ctx.MultiScatterRef.Init(32, 32, multiScatterSettings);
+    ctx.MultiScatterRef.Bake(ctx.Atmos, ctx.TransmittanceRef.GetLUT(), ctx.MSSamples.data(), ctx.MSSamples.size(), pPool);
+
+    SkyViewSettings skyViewSettings = ctx.SkyView;
+    skyViewSettings.StepCount = ctx.Quick ? 256 : 1024;
+
+    ctx.SkyViewRef.Init(200, 100);
+    ctx.SkyViewRef.Bake(ctx.Atmos, skyViewSettings, ctx.TransmittanceRef.GetLUT(), ctx.MultiScatterRef.GetLUT(), pPool);
+
+    AerialPerspectiveSettings froxelSettings = ctx.Froxel;
+    froxelSettings.StepsPerSlice = ctx.Quick ? 16 : 64;
+
+    ctx.FroxelRef.Init(32, 32, 32);
+    ctx.FroxelRef.Build(
+        ctx.Atmos, froxelSettings, ctx.Frustum, ctx.TransmittanceRef.GetLUT(), ctx.MultiScatterRef.GetLUT(), pPool);
+}
+
+static void BenchTransmittance(BenchContext &ctx, ThreadPool *pPool, u32 threadCount)
+{
+    struct Config
+    {
+        const char *pName;
+        IntegratorMode Mode;
+        u32 StepCount;
+        float RelativeError;
+    };
+
+    static const Config kConfigs[] = {
+        { "uniform 40", IntegratorMode::Uniform, 40, 0 },
+        { "uniform 200", IntegratorMode::Uniform, 200, 0 },
+        { "uniform 1000", IntegratorMode::Uniform, 1000, 0 },
+        { "adaptive 1e-2", IntegratorMode::Adaptive, 0, 1e-2f },
+        { "adaptive 1e-3", IntegratorMode::Adaptive, 0, 1e-3f },
+        { "chapman", IntegratorMode::Chapman, 0, 0 },
+    };
+
+    const XMUINT2 kSizes[] = { { 64, 16 }, { 256, 64 } };
+
+    for (const XMUINT2 &size : kSizes)
+    {
+        for (const Config &config : kConfigs)
+        {
+            IntegratorSettings settings;
+            settings.Mode = config.Mode;
+            if (config.StepCount) settings.StepCount = config.StepCount;
+            if (config.RelativeError > 0) settings.RelativeError = config.RelativeError;
+
+            TransmittanceBaker baker;
+            baker.Init(size.x, size.y, settings);
+
+            double seconds = Measure([&] {
+                baker.Bake(ctx.Atmos, pPool);
+            });
+
+            float rmse = GetRMSE(baker.GetLUT(), ctx.TransmittanceRef.GetLUT());
+
+            PrintResult(config.pName, Format("{}x{}", size.x, size.y).c_str(), threadCount, seconds, size.x * size.y, rmse);
+        }
+    }
+}
+
+static void BenchMultiScatter(BenchContext &ctx, ThreadPool *pPool, u32 threadCount)
+{
+    // Ground row marches through the planet like the shader does, less than 32 steps overflows there
+    const u32 kStepCounts[] = { 32, 64, 256 };
+
+    for (u32 stepCount : kStepCounts)
+    {
+        MultiScatterSettings settings;
+        settings.StepCount = stepCount;
+
+        MultiScatterBaker baker;
+        baker.Init(32, 32, settings);
+
+        double seconds = Measure([&] {
+            baker.Bake(ctx.Atmos, ctx.TransmittanceRef.GetLUT(), ctx.MSSamples.data(), ctx.MSSamples.size(), pPool);
+        });
+
+        float rmse = GetRMSE(baker.GetLUT(), ctx.MultiScatterRef.GetLUT());
+
+        PrintResult(Format("steps {}", stepCount).c_str(), "32x32", threadCount, seconds, 32 * 32, rmse);
+    }
+}
+
+static void BenchSkyView(BenchContext &ctx, ThreadPool *pPool, u32 threadCount)
+{
+    const u32 kStepCounts[] = { 16, 32, 48, 96 };
+    const u32 kTileSizes[] = { 16, 32, 64 };
+
+    for (u32 tileSize : kTileSizes)
+    {
+        for (u32 stepCount : kStepCounts)
+        {
+            SkyViewSettings settings = ctx.SkyView;
+            settings.StepCount = stepCount;
+
+            SkyViewBaker baker;
+            baker.Init(200, 100, tileSize);
+
+            double seconds = Measure([&] {
+                baker.Bake(ctx.Atmos, settings, ctx.TransmittanceRef.GetLUT(), ctx.MultiScatterRef.GetLUT(), pPool);
+            });
+
+            float rmse = GetRMSE(baker.GetLUT(), ctx.SkyViewRef.GetLUT());
+
+            PrintResult(Format("steps {} tile {}", stepCount, tileSize).c_str(), "200x100", threadCount, seconds, 200 * 100, rmse);
+        }
+    }
+}
+
+static void BenchFroxels(BenchContext &ctx, ThreadPool *pPool, u32 threadCount)
+{
+    const u32 kStepCounts[] = { 1, 2, 4 };
+
+    for (u32 stepCount : kStepCounts)
+    {
+        AerialPerspectiveSettings settings = ctx.Froxel;
+        settings.StepsPerSlice = stepCount;
+
+        AerialPerspectiveBuilder builder;
+        builder.Init(32, 32, 32);
+
+        double seconds = Measure([&] {
+            builder.Build(ctx.Atmos, settings, ctx.Frustum, ctx.TransmittanceRef.GetLUT(), ctx.MultiScatterRef.GetLUT(), pPool);
+        });
+
+        float rmse = GetRMSE(builder.GetInScattering().Texels, ctx.FroxelRef.GetInScattering().Texels);
+
+        PrintResult(Format("steps/slice {}", stepCount).c_str(), "32x32x32", threadCount, seconds, 32 * 32 * 32, rmse);
+    }
+}
+
+/// Convergence of the MS bake per sample set and direction mapping. Everything, reference included, runs without
+/// the shader's half sample quirk and at the same step count so only the sampling error is measured.
+static void BenchMultiScatterSampling(BenchContext &ctx, ThreadPool *pPool)
+{
+    struct SampleSet
+    {
+        const char *pName;
+        SampleSetType Type;
+    };
+
+    struct Sampling
+    {
+        const char *pName;
+        MultiScatterSampling Mode;
+    };
+
+    static const SampleSet kSets[] = {
+        { "poisson", SampleSetType::PoissonDisc },
+        { "stratified", SampleSetType::Stratified },
+        { "sobol", SampleSetType::Sobol },
+    };
+
+    static const Sampling kSamplings[] = {
+        { "uniform", MultiScatterSampling::Uniform },
+        { "phase", MultiScatterSampling::PhaseImportance },
+    };
+
+    const u32 kSampleCounts[] = { 16, 32, 64, 128 };
+
+    MultiScatterSettings settings;
+    settings.StepCount = 64;
+    settings.ShaderSampleQuirk = false;
+
+    eastl::vector<XMFLOAT2> samples;
+    GenerateStratifiedSamples(ctx.Quick ? 1024 : 4096, samples);
+
+    MultiScatterBaker reference;
+    reference.Init(32, 32, settings);
+    reference.Bake(ctx.Atmos, ctx.TransmittanceRef.GetLUT(), samples.data(), samples.size(), pPool);
+
+    printf("\nMulti scattering sampling (reference: stratified uniform, %zu samples)\n", samples.size());
+    printf("%-28s %-10s %8s %12s %12s %12s\n", "config", "size", "samples", "ms", "ns/texel", "rmse");
+
+    for (const SampleSet &set : kSets)
+    {
+        for (const Sampling &sampling : kSamplings)
+        {
+            for (u32 sampleCount : kSampleCounts)
+            {
+                GenerateSamples(set.Type, sampleCount, samples);
+
+                MultiScatterSettings bakeSettings = settings;
+                bakeSettings.Sampling = sampling.Mode;
+
+                MultiScatterBaker baker;
+                baker.Init(32, 32, bakeSettings);
+
+                double seconds = Measure([&] {
+                    baker.Bake(ctx.Atmos, ctx.TransmittanceRef.GetLUT(), samples.data(), samples.size(), pPool);
+                });
+
+                float rmse = GetRMSE(baker.GetLUT(), reference.GetLUT());
+
+                PrintResult(Format("{} {}", set.pName, sampling.pName).c_str(), "32x32", sampleCount, seconds, 32 * 32, rmse);
+            }
+        }
+    }
+}
+
+/// Single threaded, error is of the round trip against the unpacked LUT
+static void BenchStorageFormats(BenchContext &ctx)
+{
+    struct Stage
+    {
+        const char *pName;
+        const LUT2D *pLUT;
+    };
+
+    struct StorageFormat
+    {
+        const char *pName;
+        TextureFormat Format;
+    };
+
+    const Stage kStages[] = {
+        { "transmittance", &ctx.TransmittanceRef.GetLUT() },
+        { "multi scatter", &ctx.MultiScatterRef.GetLUT() },
+        { "sky-view", &ctx.SkyViewRef.GetLUT() },
+    };
+
+    static const StorageFormat kFormats[] = {
+        { "rgba16f", TextureFormat::RGBA16F },
+        { "r11g11b10f", TextureFormat::R11G11B10F },
+        { "rgb9e5", TextureFormat::RGB9E5 },
+    };
+
+    printf("\nStorage formats\n");
+    printf("%-14s %-12s %6s %12s %12s %12s %12s %12s\n", "stage", "format", "bytes", "enc ns/tex", "dec ns/tex", "max abs", "max rel",
+           "rmse");
+
+    for (const Stage &stage : kStages)
+    {
+        const LUT2D &lut = *stage.pLUT;
+        u32 texelCount = lut.Texels.size();
+
+        for (const StorageFormat &format : kFormats)
+        {
+            PackedLUT2D packed;
+            LUT2D decoded;
+
+            double encodeSeconds = Measure([&] {
+                packed.Pack(lut, format.Format);
+            });
+
+            double decodeSeconds = Measure([&] {
+                packed.Unpack(decoded);
+            });
+
+            LUTErrorReport report = CompareLUTs(decoded, lut);
+
+            printf("%-14s %-12s %6u %12.2f %12.2f %12.3e %12.3e %12.3e\n", stage.pName, format.pName, TextureFormatToSize(format.Format),
+                   encodeSeconds * 1e9 / texelCount, decodeSeconds * 1e9 / texelCount, report.MaxAbsError, report.MaxRelError,
+                   GetRMSE(decoded, lut));
+        }
+    }
+}
+
+static XMFLOAT3 GetHorizonAverage(const LUT2D &lut)
+{
+    // Middle tenth of the rows, sky-view latitude mapping puts the horizon at v = 0.5
+    u32 beginY = lut.Height * 9 / 20;
+    u32 endY = lut.Height * 11 / 20;
+
+    XMVECTOR total = XMVectorZero();
+    for (u32 y = beginY; y < endY; y++)
+    {
+        for (u32 x = 0; x < lut.Width; x++) total += XMLoadFloat4(&lut.At(x, y));
+    }
+
+    XMFLOAT3 average;
+    XMStoreFloat3(&average, total / (float)((endY - beginY) * lut.Width));
+
+    return average;
+}
+
+/// Sky-view of the RGB chain against the spectral one across sun elevations, error is against 32 bins.
+/// RGB uses the reference LUTs, shader quirks included. Transmittance and MS are baked once per bin count,
+/// the timings are of the sky-view only.
+static void BenchSpectral(BenchContext &ctx, ThreadPool *pPool)
+{
+    const float kSunElevations[] = { 45, 10, 3, 1, -1 };
+    const u32 kBinCounts[] = { 8, 16, 32 };
+
+    SpectralBakeSettings settings;
+    settings.SkyView = ctx.SkyView;
+    settings.SkyView.StepCount = 64;
+
+    eastl::vector<XMFLOAT2> samples;
+    GenerateSamples(SampleSetType::Sobol, 64, samples);
+
+    SpectralBaker bakers[eastl::size(kBinCounts)];
+    for (u32 i = 0; i < eastl::size(kBinCounts); i++)
+    {
+        settings.BinCount = kBinCounts[i];
+
+        bakers[i].Init(settings);
+        bakers[i].Bake(ctx.Atmos, samples.data(), samples.size(), pPool);
+    }
+
+    SkyViewBaker rgbBaker;
+    rgbBaker.Init(settings.SkyViewSize.x, settings.SkyViewSize.y);
+
+    printf("\nSpectral sky-view (horizon is the average of the middle rows)\n");
+    printf("%-14s %8s %12s %12s %12s %12s %12s\n", "config", "sun", "ms", "horizon r", "horizon g", "horizon b", "rmse");
+
+    for (float elevation : kSunElevations)
+    {
+        float radians = XMConvertToRadians(elevation);
+
+        SkyViewSettings skyView = settings.SkyView;
+        skyView.SunDirection = XMFLOAT3(0, sinf(radians), cosf(radians));
+
+        // Reference has to be baked for this elevation before anything is compared against it
+        double spectralSeconds[eastl::size(kBinCounts)];
+        for (u32 i = 0; i < eastl::size(kBinCounts); i++)
+        {
+            spectralSeconds[i] = Measure([&] {
+                bakers[i].BakeSkyView(skyView, pPool);
+            });
+        }
+
+        const LUT2D &reference = bakers[eastl::size(kBinCounts) - 1].GetSkyViewLUT();
+
+        for (u32 i = 0; i < eastl::size(kBinCounts); i++)
+        {
+            XMFLOAT3 horizon = GetHorizonAverage(bakers[i].GetSkyViewLUT());
+            float rmse = GetRMSE(bakers[i].GetSkyViewLUT().Texels, reference.Texels);
+
+            printf("%-14s %8.1f %12.3f %12.4f %12.4f %12.4f %12.3e\n", Format("{} bins", bakers[i].GetAtmosphere().BinCount).c_str(), elevation,
+                   spectralSeconds[i] * 1e3, horizon.x, horizon.y, horizon.z, rmse);
+        }
+
+        double seconds = Measure([&] {
+            rgbBaker.Bake(ctx.Atmos, skyView, ctx.TransmittanceRef.GetLUT(), ctx.MultiScatterRef.GetLUT(), pPool);
+        });
+
+        XMFLOAT3 horizon = GetHorizonAverage(rgbBaker.GetLUT());
+        float rmse = GetRMSE(rgbBaker.GetLUT().Texels, reference.Texels);
+
+        printf("%-14s %8.1f %12.3f %12.4f %12.4f %12.4f %12.3e\n", "rgb", elevation, seconds * 1e3, horizon.x, horizon.y, horizon.z, rmse);
+    }
+}
+
+/// Weather transition: Mie scattering changes every frame and the chain is rebaked within a per-frame budget.
+/// Frame times are of the calling thread, the tail matters more than the average so p99, max and frames over
+/// twice the budget are reported. Published LUTs are compared against blocking bakes of the same inputs.
+static void BenchAmortized(BenchContext &ctx)
+{
+    const float kBudgets[] = { 500, 1000, 2000 };
+    const u32 kPublishCount = ctx.Quick ? 1 : 3;
+
+    AmortizedBakeSettings settings;
+
+    Atmosphere atmos = ctx.Atmos;
+    double blockingSeconds = Measure([&] {
+        TransmittanceBaker transmittance;
+        transmittance.Init(settings.TransmittanceSize.x, settings.TransmittanceSize.y, settings.Transmittance);
+        transmittance.Bake(atmos, nullptr);
+
+        MultiScatterBaker multiScatter;
+        multiScatter.Init(settings.MultiScatterSize.x, settings.MultiScatterSize.y, settings.MultiScatter);
+        multiScatter.Bake(atmos, transmittance.GetLUT(), ctx.MSSamples.data(), ctx.MSSamples.size(), nullptr);
+
+        SkyViewBaker skyView;
+        skyView.Init(settings.SkyViewSize.x, settings.SkyViewSize.y);
+        skyView.Bake(atmos, ctx.SkyView, transmittance.GetLUT(), multiScatter.GetLUT(), nullptr);
+    });
+
+    printf("\nAmortized updates, blocking chain takes %.3fms on one thread\n", blockingSeconds * 1e3);
+    printf("%-14s %12s %12s %12s %12s %12s %12s %12s\n", "budget (us)", "avg (us)", "p99 (us)", "max (us)", "over 2x", "publishes",
+           "frames/pub", "rmse");
+
+    for (float budget : kBudgets)
+    {
+        AmortizedLUTBaker baker;
+        baker.Init(settings, ctx.MSSamples.data(), ctx.MSSamples.size());
+
+        // First bake is blocking by design
+        baker.SetInputs(atmos, ctx.SkyView);
+        baker.Update(budget);
+
+        eastl::vector<double> frameTimesUS;
+        u32 publishCount = 0;
+        u32 frame = 0;
+
+        for (; publishCount < kPublishCount; frame++)
+        {
+            Atmosphere weather = ctx.Atmos;
+            weather.MieScatterVal *= 1.0f + 0.5f * sinf(frame * 0.05f);
+            baker.SetInputs(weather, ctx.SkyView);
+
+            Timer timer;
+            publishCount += baker.Update(budget);
+            frameTimesUS.push_back(timer.elapsed() * 1e6);
+        }
+
+        double totalUS = 0.0;
+        u32 overBudgetCount = 0;
+        for (double frameUS : frameTimesUS)
+        {
+            totalUS += frameUS;
+            overBudgetCount += frameUS > budget * 2.0;
+        }
+
+        eastl::sort(frameTimesUS.begin(), frameTimesUS.end());
+        double p99US = frameTimesUS[(frameTimesUS.size() - 1) * 99 / 100];
+        double maxUS = frameTimesUS.back();
+
+        // Published set has to match a blocking bake of its own inputs
+        const AmortizedLUTSet &front = baker.GetFront();
+
+        TransmittanceBaker transmittance;
+        transmittance.Init(settings.TransmittanceSize.x, settings.TransmittanceSize.y, settings.Transmittance);
+        transmittance.Bake(front.Atmos, nullptr);
+
+        MultiScatterBaker multiScatter;
+        multiScatter.Init(settings.MultiScatterSize.x, settings.MultiScatterSize.y, settings.MultiScatter);
+        multiScatter.Bake(front.Atmos, transmittance.GetLUT(), ctx.MSSamples.data(), ctx.MSSamples.size(), nullptr);
+
+        SkyViewBaker skyView;
+        skyView.Init(settings.SkyViewSize.x, settings.SkyViewSize.y);
+        skyView.Bake(front.Atmos, front.SkyView, transmittance.GetLUT(), multiScatter.GetLUT(), nullptr);
+
+        float rmse = GetRMSE(front.pTransmittance->Texels, transmittance.GetLUT().Texels);
+        rmse = eastl::max(rmse, GetRMSE(front.pMultiScatter->Texels, multiScatter.GetLUT().Texels));
+        rmse = eastl::max(rmse, GetRMSE(front.pSkyView->Texels, skyView.GetLUT().Texels));
+
+        printf("%-14.0f %12.1f %12.1f %12.1f %12u %12u %12u %12.3e\n", budget, totalUS / frame, p99US, maxUS, overBudgetCount, publishCount,
+               baker.GetScheduler().GetLastFrameCount(), rmse);
+    }
+}
+
+/// Headless final pass of the bench frustum, per-pixel `Shade` against scanline batches on one thread.
+/// Differences are 8 bit pixels that don't match, batched LUT coordinates use approximate asin/atan2.
+static void BenchFinalPass(BenchContext &ctx)
+{
+    const u32 kWidth = ctx.Quick ? 640 : 1920;
+    const u32 kHeight = ctx.Quick ? 360 : 1080;
+
+    FinalPassSettings settings;
+    settings.SunDirection = ctx.SkyView.SunDirection;
+    settings.SunIntensity = ctx.SkyView.SunIntensity;
+    settings.EyePosition = ctx.SkyView.EyePosition;
+
+    FinalPassLUTs luts;
+    luts.pSkyView = &ctx.SkyViewRef.GetLUT();
+    luts.pTransmittance = &ctx.TransmittanceRef.GetLUT();
+    luts.pMultiScatter = &ctx.MultiScatterRef.GetLUT();
+
+    ImageRGBA8 reference, image;
+    reference.Resize(kWidth, kHeight);
+    image.Resize(kWidth, kHeight);
+
+    LUT2D luminance;
+    luminance.Resize(kWidth, kHeight);
+
+    double scalarSeconds = Measure([&] {
+        for (u32 y = 0; y < kHeight; y++)
+        {
+            for (u32 x = 0; x < kWidth; x++)
+            {
+                float u = (x + 0.5f) / kWidth;
+                float v = (y + 0.5f) / kHeight;
+
+                XMVECTOR direction = FinalPass::GetViewDirection(ctx.Frustum, u, v);
+                XMVECTOR color = FinalPass::Shade(*luts.pSkyView, settings, direction, XMFLOAT2(u, v));
+
+                XMStoreUByteN4((XMUBYTEN4 *)&reference.Pixels[y * kWidth + x], XMVectorSetW(color, 1.0f));
+            }
+        }
+    });
+
+    double batchedSeconds = Measure([&] {
+        FinalPass::RenderFrustumRows(ctx.Atmos, luts, settings, ctx.Frustum, image, 0, kHeight, &luminance);
+    });
+
+    u32 differentCount = 0;
+    for (u32 i = 0; i < image.Pixels.size(); i++) differentCount += image.Pixels[i] != reference.Pixels[i];
+
+    printf("\nFinal pass %ux%u, one thread\n", kWidth, kHeight);
+    printf("%-14s %12s %12s\n", "path", "time (ms)", "different");
+    printf("%-14s %12.3f %12s\n", "per pixel", scalarSeconds * 1e3, "-");
+    printf("%-14s %12.3f %12u\n", "scanlines", batchedSeconds * 1e3, differentCount);
+
+    if (!ctx.pImageDir) return;
+
+    eastl::string pngPath = Format("{}/final.png", ctx.pImageDir);
+    eastl::string exrPath = Format("{}/final.exr", ctx.pImageDir);
+
+    Timer timer;
+    bool written = WriteImagePNG(pngPath, image) && WriteImageEXR(exrPath, luminance);
+    printf("%s %s and %s in %.3fms\n", written ? "Wrote" : "Couldn't write", pngPath.c_str(), exrPath.c_str(), timer.elapsed() * 1e3);
+}
+
+/// Synthetic presets file, every category has scalars, arrays, comments and a nested block
+static eastl::string GetConfigSource(u32 categoryCount)
+{
+    eastl::string source = "// Generated for the parser bench\n";
+
+    for (u32 i = 0; i < categoryCount; i++)
+    {
+        source += Format("Preset_{}\n{{\n", i);
+        source += Format("    Name = \"Preset number {}\"\n", i);
+        source += Format("    PlanetRadius = {}\n    AtmosRadius = {}\n", 6360 + i, 6460.5 + i);
+        source += Format("    Enabled = {}\n", i % 2 ? "true" : "false");
+        source += "    /* Per channel */\n    RayleighScatter = [5.802, 13.558, 33.1]\n";
+        source += "    Tags = [\"sky\", \"earth\", \"day\"]\n";
+        source += "    Mie\n    {\n        Scatter = 3.996\n        Absorb = 4.40\n        Asymmetry = -0.8\n    }\n";
+        source += "}\n";
+    }
+
+    return source;
+}
+
+static bool IsSameCategory(ffd::Category &a, ffd::Category &b)
+{
+    if (a.m_Numbers != b.m_Numbers || a.m_Strings != b.m_Strings || a.m_Bools != b.m_Bools) return false;
+    if (a.m_ArrayNumbers != b.m_ArrayNumbers || a.m_ArrayString != b.m_ArrayString) return false;
+    if (a.m_Childeren.size() != b.m_Childeren.size()) return false;
+
+    for (auto &[name, pChild] : a.m_Childeren)
+    {
+        auto childIt = b.m_Childeren.find(name);
+        if (childIt == b.m_Childeren.end() || !IsSameCategory(*pChild, *childIt->second)) return false;
+    }
+
+    return true;
+}
+
+/// Generated flex/bison parser against the hand-written one, both build the same `ffd::Category` tree
+static void BenchConfigParsing(BenchContext &ctx)
+{
+    const u32 kCategoryCount = ctx.Quick ? 2000 : 20000;
+    eastl::string source = GetConfigSource(kCategoryCount);
+
+    double bisonSeconds = Measure([&] {
+        ffd file;
+        file.FromMemoryBison(source.data(), source.size());
+    });
+
+    double handwrittenSeconds = Measure([&] {
+        ffd file;
+        file.FromMemory(source.data(), source.size());
+    });
+
+    ffd bisonFile, handwrittenFile;
+    bisonFile.FromMemoryBison(source.data(), source.size());
+    handwrittenFile.FromMemory(source.data(), source.size());
+
+    bool isSame = IsSameCategory(bisonFile.Global(), handwrittenFile.Global());
+    double megabytes = source.size() / (1024.0 * 1024.0);
+
+    printf("\nConfig parsing, %u categories, %.2f MB\n", kCategoryCount, megabytes);
+    printf("%-14s %12s %12s %12s\n", "path", "time (ms)", "MB/s", "same");
+    printf("%-14s %12.3f %12.1f %12s\n", "bison", bisonSeconds * 1e3, megabytes / bisonSeconds, "-");
+    printf("%-14s %12.3f %12.1f %12s\n", "hand-written", handwrittenSeconds * 1e3, megabytes / handwrittenSeconds, isSame ? "yes" : "no");
+}
+
+static bool IsSameDocument(ffd::Category &category, ffdDocument::Category document)
+{
+    for (auto &[name, value] : category.m_Numbers)
+        if (document.AsFloat(name) != (float)value) return false;
+
+    for (auto &[name, value] : category.m_Strings)
+        if (document.AsString(name) != eastl::string_view(value.data(), value.size())) return false;
+
+    for (auto &[name, value] : category.m_Bools)
+        if (document.AsBool(name) != value) return false;
+
+    for (auto &[name, values] : category.m_ArrayNumbers)
+    {
+        if (document.GetNumberArraySize(name) != values.size()) return false;
+        for (u32 i = 0; i < values.size(); i++)
+            if (document.AsFloat(name, i) != (float)values[i]) return false;
+    }
+
+    for (auto &[name, values] : category.m_ArrayString)
+    {
+        if (document.GetStringArraySize(name) != values.size()) return false;
+        for (u32 i = 0; i < values.size(); i++)
+            if (document.AsString(name, i) != eastl::string_view(values[i].data(), values[i].size())) return false;
+    }
+
+    for (auto &[name, pChild] : category.m_Childeren)
+        if (!IsSameDocument(*pChild, document[name])) return false;
+
+    return true;
+}
+
+/// `ffd::Category` maps against the flat `ffdDocument`, same calls as a settings read would do
+static void BenchConfigLookup(BenchContext &ctx)
+{
+    const u32 kCategoryCount = 2000;
+    const u32 kLookupCount = ctx.Quick ? 100000 : 1000000;
+
+    eastl::string source = GetConfigSource(kCategoryCount);
+
+    ffd file;
+    file.FromMemory(source.data(), source.size());
+
+    ffdDocument document;
+    document.FromMemory(source.data(), source.size());
+
+    eastl::vector<eastl::string> names(kCategoryCount);
+    for (u32 i = 0; i < kCategoryCount; i++) names[i] = Format("Preset_{}", i);
+
+    eastl::vector<u32> order(kLookupCount);
+    for (u32 &i : order) i = Random::UInt(0, kCategoryCount - 1);
+
+    float treeSum = 0, flatSum = 0, keySum = 0;
+
+    double treeSeconds = Measure([&] {
+        for (u32 i : order)
+        {
+            ffd::Category &category = file[names[i]];
+            treeSum += category.AsFloat("PlanetRadius") + category["Mie"].AsFloat("Scatter") + category.AsFloat("RayleighScatter", 2);
+        }
+    });
+
+    double flatSeconds = Measure([&] {
+        for (u32 i : order)
+        {
+            ffdDocument::Category category = document[names[i]];
+            flatSum += category.AsFloat("PlanetRadius") + category["Mie"].AsFloat("Scatter") + category.AsFloat("RayleighScatter", 2);
+        }
+    });
+
+    // Same reads with the names hashed at compile time
+    double keySeconds = Measure([&] {
+        for (u32 i : order)
+        {
+            ffdDocument::Category category = document[names[i]];
+            keySum += category.Get<float>("PlanetRadius"_k) + category.Get<float>("Mie.Scatter"_k) + category.Get<float>("RayleighScatter"_k, 2);
+        }
+    });
+
+    bool isSame = treeSum == flatSum && IsSameDocument(file.Global(), document.Global());
+
+    printf("\nConfig lookups, %u categories, %u x 3 reads\n", kCategoryCount, kLookupCount);
+    printf("%-14s %12s %12s %12s\n", "path", "time (ms)", "ns/read", "same");
+    printf("%-14s %12.3f %12.1f %12s\n", "category tree", treeSeconds * 1e3, treeSeconds * 1e9 / (kLookupCount * 3), "-");
+    printf("%-14s %12.3f %12.1f %12s\n", "flat", flatSeconds * 1e3, flatSeconds * 1e9 / (kLookupCount * 3), isSame ? "yes" : "no");
+    printf("%-14s %12.3f %12.1f %12s\n", "flat, _k keys", keySeconds * 1e3, keySeconds * 1e9 / (kLookupCount * 3), keySum == flatSum ? "yes" : "no");
+    printf("Flat document is %.1f KB\n", document.GetMemorySize() / 1024.0);
+}
+
+/// Text parsed into a flat document against the compiled blob mapped in place
+static void BenchConfigLoading(BenchContext &ctx)
+{
+    const u32 kCategoryCount = ctx.Quick ? 2000 : 20000;
+    eastl::string source = GetConfigSource(kCategoryCount);
+
+    eastl::string path = (std::filesystem::temp_directory_path() / "AtmosphereBench.ffdb").string().c_str();
+
+    {
+        ffdDocument document;
+        document.FromMemory(source.data(), source.size());
+        if (!document.WriteBinary(path)) return;
+    }
+
+    double textSeconds = Measure([&] {
+        ffdDocument document;
+        document.FromMemory(source.data(), source.size());
+    });
+
+    double mappedSeconds = Measure([&] {
+        ffdDocument document;
+        document.FromBinaryFile(path);
+    });
+
+    bool isSame = false;
+    size_t compiledSize = 0;
+
+    // Mapping has to be closed before the file can be removed
+    {
+        ffd file;
+        file.FromMemory(source.data(), source.size());
+
+        ffdDocument compiled;
+        isSame = compiled.FromBinaryFile(path) && IsSameDocument(file.Global(), compiled.Global());
+        compiledSize = compiled.GetMemorySize();
+    }
+
+    std::filesystem::remove(path.c_str());
+
+    printf("\nConfig loading, %u categories, %.1f KB compiled\n", kCategoryCount, compiledSize / 1024.0);
+    printf("%-14s %12s %12s\n", "path", "time (ms)", "same");
+    printf("%-14s %12.3f %12s\n", "text", textSeconds * 1e3, "-");
+    printf("%-14s %12.3f %12s\n", "mapped", mappedSeconds * 1e3, isSame ? "yes" : "no");
+}
+
+int main(int argc, char **argv)
+{
+    Logger::Init();
+
+    BenchContext ctx;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--quick"))
+            ctx.Quick = true;
+        else if (!strcmp(argv[i], "--images") && i + 1 < argc)
+            ctx.pImageDir = argv[++i];
+    }
+
+    if (ctx.pImageDir)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(ctx.pImageDir, error);
+
+        if (error)
+        {
+            printf("Couldn't create image directory %s: %s\n", ctx.pImageDir, error.message().c_str());
+            return 1;
+        }
+    }
+
+    // Same MS sample set as the app
+    constexpr u32 kMSSampleCount = 128;
+    constexpr u32 kMSSampleSeed = 0;
+
+    SampleSetCache sampleCache;
+    sampleCache.Init("Cache/Samples");
+    sampleCache.GetPoissonDisc(kMSSampleCount, kMSSampleSeed, ctx.MSSamples);
+
+    printf("MS samples: %u point Poisson disc, seed %u\n", kMSSampleCount, kMSSampleSeed);
+
+    ctx.SkyView.EyePosition = XMFLOAT3(0, ctx.Atmos.PlanetRadius + 200, 0);
+    ctx.SkyView.SunDirection = XMFLOAT3(0, 0.5, 0.866);
+
+    ctx.Froxel.EyePosition = ctx.SkyView.EyePosition;
+    ctx.Froxel.SunDirection = ctx.SkyView.SunDirection;
+
+    // 90 degree horizontal FOV looking at the horizon
+    ctx.Frustum.PointX = XMFLOAT3(1, 0.5, -1);
+    ctx.Frustum.PointY = XMFLOAT3(1, 0.5, 1);
+    ctx.Frustum.PointZ = XMFLOAT3(1, -0.5, -1);
+    ctx.Frustum.PointW = XMFLOAT3(1, -0.5, 1);
+
+    u32 processorCount = eastl::max(EA::Thread::GetProcessorCount(), 1);
+    for (u32 i = 1; i < processorCount; i *= 2) ctx.ThreadCounts.push_back(i);
+    ctx.ThreadCounts.push_back(processorCount);
+
+    {
+        ThreadPool pool;
+        pool.Init(processorCount);
+
+        Timer timer;
+        BakeReferences(ctx, &pool);
+        printf("Reference bakes took %.2fs\n", timer.elapsed());
+    }
+
+    BenchStorageFormats(ctx);
+    BenchAmortized(ctx);
+    BenchFinalPass(ctx);
+    BenchConfigParsing(ctx);
+    BenchConfigLookup(ctx);
+    BenchConfigLoading(ctx);
+
+    {
+        ThreadPool pool;
+        pool.Init(processorCount);
+
+        BenchMultiScatterSampling(ctx, &pool);
+        BenchSpectral(ctx, &pool);
+    }
+
+    for (u32 threadCount : ctx.ThreadCounts)
+    {
+        ThreadPool pool;
+        pool.Init(threadCount);
+
+        PrintHeader("Transmittance");
+        BenchTransmittance(ctx, &pool, threadCount);
+
+        PrintHeader("Multi scattering");
+        BenchMultiScatter(ctx, &pool, threadCount);
+
+        PrintHeader("Sky-view");
+        BenchSkyView(ctx, &pool, threadCount);
+
+        PrintHeader("Aerial perspective");
+        BenchFroxels(ctx, &pool, threadCount);
+    }
+
+    return 0;
+}
\ No newline at end of file
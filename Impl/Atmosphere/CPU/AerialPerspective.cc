@@ -0,0 +1,211 @@
+#include "AerialPerspective.hh"
+
+#include "AtmosphereMath.hh"
+#include "AtmosphereKernels.hh"
+
+using namespace AtmosMath;
+
+void AerialPerspectiveBuilder::Init(u32 width, u32 height, u32 depth)
+{
+    m_InScattering.Resize(width, height, depth);
+    m_Transmittance.Resize(width, height, depth);
+
+    u32 pixelCount = width * height;
+    m_RayData.resize(pixelCount * 6);
+
+    m_pDirX = m_RayData.data();
+    m_pDirY = m_pDirX + pixelCount;
+    m_pDirZ = m_pDirY + pixelCount;
+    m_pMaxDistance = m_pDirZ + pixelCount;
+    m_pRayleighPhase = m_pMaxDistance + pixelCount;
+    m_pMiePhase = m_pRayleighPhase + pixelCount;
+}
+
+void AerialPerspectiveBuilder::Build(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const CameraFrustum &frustum,
+                                     const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT, ThreadPool *pPool)
+{
+    PrepareRays(atmos, settings, frustum);
+
+    if (!pPool)
+    {
+        for (u32 i = 0; i < m_InScattering.Depth; i++) IntegrateSlice(atmos, settings, transmittanceLUT, multiScatterLUT, i);
+        AccumulateRows(0, m_InScattering.Height);
+        return;
+    }
+
+    pPool->ParallelFor(m_InScattering.Depth, 1, [&](u32 begin, u32 end, u32) {
+        for (u32 i = begin; i < end; i++) IntegrateSlice(atmos, settings, transmittanceLUT, multiScatterLUT, i);
+    });
+
+    pPool->ParallelFor(m_InScattering.Height, 1, [&](u32 begin, u32 end, u32) {
+        AccumulateRows(begin, end);
+    });
+}
+
+float AerialPerspectiveBuilder::GetSliceDistance(u32 slice, float maxDistance)
+{
+    float z = (float)(slice + 1) / m_InScattering.Depth;
+    return maxDistance * z * z;
+}
+
+void AerialPerspectiveBuilder::PrepareRays(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const CameraFrustum &frustum)
+{
+    const AtmosKernels &kernels = GetAtmosKernels();
+    const u32 width = m_InScattering.Width;
+    const u32 height = m_InScattering.Height;
+    const u32 pixelCount = width * height;
+
+    XMVECTOR topLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointX));
+    XMVECTOR topRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointY));
+    XMVECTOR bottomLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointZ));
+    XMVECTOR bottomRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointW));
+
+    XMVECTOR eyePosition = XMLoadFloat3(&settings.EyePosition);
+    XMVECTOR sunDirection = XMLoadFloat3(&settings.SunDirection);
+
+    // Reuse phase outputs as cosTheta inputs
+    float *pCosTheta = m_pMiePhase;
+
+    for (u32 y = 0; y < height; y++)
+    {
+        float v = (y + 0.5f) / height;
+
+        for (u32 x = 0; x < width; x++)
+        {
+            float u = (x + 0.5f) / width;
+            u32 i = y * width + x;
+
+            // Same as `Final.hlsl`
+            XMVECTOR direction = XMVector3Normalize(XMVectorLerp(XMVectorLerp(topLeft, topRight, u), XMVectorLerp(bottomLeft, bottomRight, u), v));
+
+            m_pDirX[i] = XMVectorGetX(direction);
+            m_pDirY[i] = XMVectorGetY(direction);
+            m_pDirZ[i] = XMVectorGetZ(direction);
+
+            // Nothing scatters behind the ground or outside the atmosphere
+            float maxDistance = 0.0f;
+            if (!GetQuadraticIntersection3D(eyePosition, direction, atmos.PlanetRadius, maxDistance))
+                GetQuadraticIntersection3D(eyePosition, direction, atmos.AtmosRadius, maxDistance);
+
+            m_pMaxDistance[i] = maxDistance;
+            pCosTheta[i] = XMVectorGetX(XMVector3Dot(direction, sunDirection));
+        }
+    }
+
+    // Rayleigh phase is evaluated with -cosTheta in the shaders
+    for (u32 i = 0; i < pixelCount; i++) m_pRayleighPhase[i] = -pCosTheta[i];
+
+    kernels.RayleighPhase(m_pRayleighPhase, m_pRayleighPhase, pixelCount);
+    kernels.MiePhase(atmos, pCosTheta, m_pMiePhase, pixelCount);
+}
+
+void AerialPerspectiveBuilder::IntegrateSlice(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const LUT2D &transmittanceLUT,
+                                              const LUT2D &multiScatterLUT, u32 slice)
+{
+    const AtmosKernels &kernels = GetAtmosKernels();
+    const u32 pixelCount = m_InScattering.Width * m_InScattering.Height;
+    const u32 stepCount = eastl::max(settings.StepsPerSlice, 1u);
+
+    float sliceBegin = slice > 0 ? GetSliceDistance(slice - 1, settings.MaxDistance) : 0.0f;
+    float sliceEnd = GetSliceDistance(slice, settings.MaxDistance);
+
+    /// Per pixel sample data (SoA) so density terms are evaluated by SIMD kernels across the whole slice
+    thread_local eastl::vector<float> scratch;
+    scratch.resize(pixelCount * 10);
+
+    float *pStepSize = scratch.data();
+    float *pAltitude = pStepSize + pixelCount;
+    float *pSunTheta = pAltitude + pixelCount;
+    float *pExtinctionR = pSunTheta + pixelCount;
+    float *pExtinctionG = pExtinctionR + pixelCount;
+    float *pExtinctionB = pExtinctionG + pixelCount;
+    float *pRayleighR = pExtinctionB + pixelCount;
+    float *pRayleighG = pRayleighR + pixelCount;
+    float *pRayleighB = pRayleighG + pixelCount;
+    float *pMie = pRayleighB + pixelCount;
+
+    XMFLOAT4 *pInScattering = &m_InScattering.At(0, 0, slice);
+    XMFLOAT4 *pTransmittance = &m_Transmittance.At(0, 0, slice);
+
+    for (u32 i = 0; i < pixelCount; i++)
+    {
+        float begin = bx::min(sliceBegin, m_pMaxDistance[i]);
+        float end = bx::min(sliceEnd, m_pMaxDistance[i]);
+        pStepSize[i] = (end - begin) / stepCount;
+
+        pInScattering[i] = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+        pTransmittance[i] = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    XMVECTOR sunDirection = XMLoadFloat3(&settings.SunDirection);
+    const XMFLOAT3 &eye = settings.EyePosition;
+
+    for (u32 step = 0; step < stepCount; step++)
+    {
+        // Midpoint of every sub step, segment starts at the (clamped) slice begin
+        for (u32 i = 0; i < pixelCount; i++)
+        {
+            float t = bx::min(sliceBegin, m_pMaxDistance[i]) + (step + 0.5f) * pStepSize[i];
+
+            XMVECTOR position = XMVectorSet(eye.x + m_pDirX[i] * t, eye.y + m_pDirY[i] * t, eye.z + m_pDirZ[i] * t, 0.0f);
+            float h = XMVectorGetX(XMVector3Length(position));
+
+            pAltitude[i] = h - atmos.PlanetRadius;
+            pSunTheta[i] = XMVectorGetX(XMVector3Dot(sunDirection, position / h));
+        }
+
+        kernels.ExtinctionSum(atmos, pAltitude, pExtinctionR, pExtinctionG, pExtinctionB, pixelCount);
+        kernels.Scattering(atmos, pAltitude, pRayleighR, pRayleighG, pRayleighB, pMie, pixelCount);
+
+        for (u32 i = 0; i < pixelCount; i++)
+        {
+            if (pStepSize[i] <= 0.0f) continue;
+
+            XMVECTOR extinction = XMVectorSet(pExtinctionR[i], pExtinctionG[i], pExtinctionB[i], 1.0f);
+            XMVECTOR stepTrans = XMVectorExpE(extinction * -pStepSize[i]);
+
+            XMVECTOR sunTrans = SampleLUT(transmittanceLUT, atmos, pAltitude[i], pSunTheta[i]);
+            XMVECTOR MS = SampleLUT(multiScatterLUT, atmos, pAltitude[i], pSunTheta[i]);
+
+            // Same as `LUT.hlsl`
+            XMVECTOR rayleighInScat = XMVectorSet(pRayleighR[i], pRayleighG[i], pRayleighB[i], 0.0f) * (XMVectorReplicate(m_pRayleighPhase[i]) + MS);
+            XMVECTOR mieInScat = pMie[i] * (XMVectorReplicate(m_pMiePhase[i]) + MS);
+            XMVECTOR scatteringPhase = (rayleighInScat + mieInScat) * sunTrans;
+
+            XMVECTOR integral = (scatteringPhase - scatteringPhase * stepTrans) / extinction;
+
+            XMVECTOR transmittance = XMLoadFloat4(&pTransmittance[i]);
+            XMVECTOR inScattering = XMLoadFloat4(&pInScattering[i]) + settings.SunIntensity * (integral * transmittance);
+
+            XMStoreFloat4(&pInScattering[i], XMVectorSetW(inScattering, 1.0f));
+            XMStoreFloat4(&pTransmittance[i], XMVectorSetW(transmittance * stepTrans, 1.0f));
+        }
+    }
+}
+
+void AerialPerspectiveBuilder::AccumulateRows(u32 begin, u32 end)
+{
+    const u32 width = m_InScattering.Width;
+
+    for (u32 y = begin; y < end; y++)
+    {
+        for (u32 x = 0; x < width; x++)
+        {
+            XMVECTOR inScattering = XMVectorZero();
+            XMVECTOR transmittance = XMVectorReplicate(1.0f);
+
+            // Slices hold their own segment, light of a segment is dimmed by everything in front of it
+            for (u32 z = 0; z < m_InScattering.Depth; z++)
+            {
+                XMFLOAT4 &segmentInScattering = m_InScattering.At(x, y, z);
+                XMFLOAT4 &segmentTransmittance = m_Transmittance.At(x, y, z);
+
+                inScattering += transmittance * XMLoadFloat4(&segmentInScattering);
+                transmittance *= XMLoadFloat4(&segmentTransmittance);
+
+                XMStoreFloat4(&segmentInScattering, XMVectorSetW(inScattering, 1.0f));
+                XMStoreFloat4(&segmentTransmittance, XMVectorSetW(transmittance, 1.0f));
+            }
+        }
+    }
+}
\ No newline at end of file
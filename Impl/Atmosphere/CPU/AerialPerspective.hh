@@ -0,0 +1,66 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+#include "Graphics/Camera3D.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+
+struct AerialPerspectiveSettings
+{
+    XMFLOAT3 EyePosition = { 0, 0, 0 };
+    float SunIntensity = 10;
+    XMFLOAT3 SunDirection = { 0, 1, 0 };
+    float MaxDistance = 32000;  // m, distance of the last slice along view rays
+
+    u32 StepsPerSlice = 2;
+};
+
+/// Camera frustum aligned volume (froxels) of in-scattered light and transmittance from the eye.
+/// Slices are spaced quadratically so near ones are thinner, `GetSliceDistance` gives the far edge of a slice.
+/// Compositing a surface at slice `z`: color * Transmittance + InScattering.
+class AerialPerspectiveBuilder
+{
+public:
+    void Init(u32 width, u32 height, u32 depth);
+
+    /// First every slice integrates only its own segment (parallel over slices), then segments are
+    /// accumulated front to back (parallel over rows). Runs on the calling thread if `pPool` is null.
+    void Build(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const CameraFrustum &frustum, const LUT2D &transmittanceLUT,
+               const LUT2D &multiScatterLUT, ThreadPool *pPool);
+
+    float GetSliceDistance(u32 slice, float maxDistance);
+
+public:
+    LUT3D &GetInScattering()
+    {
+        return m_InScattering;
+    }
+
+    LUT3D &GetTransmittance()
+    {
+        return m_Transmittance;
+    }
+
+private:
+    void PrepareRays(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const CameraFrustum &frustum);
+    void IntegrateSlice(const Atmosphere &atmos, const AerialPerspectiveSettings &settings, const LUT2D &transmittanceLUT,
+                        const LUT2D &multiScatterLUT, u32 slice);
+    void AccumulateRows(u32 begin, u32 end);
+
+    LUT3D m_InScattering;
+    LUT3D m_Transmittance;
+
+    /// Per pixel (SoA), filled once per build
+    eastl::vector<float> m_RayData;
+    float *m_pDirX = nullptr;
+    float *m_pDirY = nullptr;
+    float *m_pDirZ = nullptr;
+    float *m_pMaxDistance = nullptr;
+    float *m_pRayleighPhase = nullptr;
+    float *m_pMiePhase = nullptr;
+};
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "AmortizedBaker.hh"
+
+#include "Utils/Hash.hh"
+
+using namespace lr;
+
+void AmortizedLUTBaker::Init(const AmortizedBakeSettings &settings, const XMFLOAT2 *pSamples, u32 sampleCount)
+{
+    m_Settings = settings;
+    m_Samples.assign(pSamples, pSamples + sampleCount);
+
+    m_TransmittanceBaker.Init(settings.TransmittanceSize.x, settings.TransmittanceSize.y, settings.Transmittance);
+    m_MultiScatterBaker.Init(settings.MultiScatterSize.x, settings.MultiScatterSize.y, settings.MultiScatter);
+    m_SkyViewBaker.Init(settings.SkyViewSize.x, settings.SkyViewSize.y, settings.SkyViewTileSize);
+
+    // Back buffers are swapped into the bakers, they have to be the same size
+    LUT2D *pBakerLUTs[StageCount] = { &m_TransmittanceBaker.GetLUT(), &m_MultiScatterBaker.GetLUT(), &m_SkyViewBaker.GetLUT() };
+    for (u32 i = 0; i < StageCount; i++)
+    {
+        for (LUT2D &buffer : m_Buffers[i]) buffer.Resize(pBakerLUTs[i]->Width, pBakerLUTs[i]->Height);
+    }
+
+    // Slices are single texels, a whole row doesn't fit small budgets
+    LUTUpdateStage &transmittance = m_Stages[Transmittance];
+    transmittance.SliceCount = settings.TransmittanceSize.x * settings.TransmittanceSize.y;
+    transmittance.Run = [this](u32 begin, u32 end) {
+        m_TransmittanceBaker.BakeTexels(m_BakeAtmos, begin, end);
+    };
+
+    // A texel integrates every sample direction, slices are single directions to keep them short
+    LUTUpdateStage &multiScatter = m_Stages[MultiScatter];
+    multiScatter.SliceCount = m_MultiScatterBaker.BeginBake(sampleCount);
+    multiScatter.Run = [this](u32 begin, u32 end) {
+        m_MultiScatterBaker.BakeSamples(m_BakeAtmos, GetBakeInput(Transmittance), m_Samples.data(), begin, end);
+    };
+    multiScatter.Finish = [this] {
+        m_MultiScatterBaker.ReduceTexels(m_Samples.size(), 0, m_Settings.MultiScatterSize.x * m_Settings.MultiScatterSize.y);
+    };
+
+    LUTUpdateStage &skyView = m_Stages[SkyView];
+    skyView.SliceCount = m_SkyViewBaker.GetTileCount();
+    skyView.Run = [this](u32 begin, u32 end) {
+        const LUT2D &transmittanceLUT = GetBakeInput(Transmittance);
+        const LUT2D &multiScatterLUT = GetBakeInput(MultiScatter);
+
+        for (u32 tile = begin; tile < end; tile++)
+            m_SkyViewBaker.BakeTile(m_BakeAtmos, m_BakeSkyView, transmittanceLUT, multiScatterLUT, tile);
+    };
+
+    m_HasPublished = false;
+    m_Front = 0;
+}
+
+void AmortizedLUTBaker::SetInputs(const Atmosphere &atmos, const SkyViewSettings &skyView)
+{
+    m_Atmos = atmos;
+    m_SkyView = skyView;
+
+    // Settings are fixed after `Init`, MS only depends on the atmosphere
+    m_Hashes[Transmittance] = Hash::FNV64(atmos);
+    m_Hashes[MultiScatter] = m_Hashes[Transmittance];
+    m_Hashes[SkyView] = Hash::FNV64(skyView, m_Hashes[MultiScatter]);
+}
+
+bool AmortizedLUTBaker::Update(float budgetUS)
+{
+    if (!m_Scheduler.IsBusy())
+    {
+        u32 firstStage = GetFirstDirtyStage();
+        if (firstStage == StageCount) return false;
+
+        BeginUpdate(firstStage);
+    }
+
+    if (!m_HasPublished)
+        m_Scheduler.Flush();
+    else if (!m_Scheduler.Update(budgetUS))
+        return false;
+
+    Publish();
+
+    return true;
+}
+
+u32 AmortizedLUTBaker::GetFirstDirtyStage()
+{
+    if (!m_HasPublished) return Transmittance;
+
+    for (u32 i = 0; i < StageCount; i++)
+    {
+        if (m_Hashes[i] != m_PublishedHashes[i]) return i;
+    }
+
+    return StageCount;
+}
+
+void AmortizedLUTBaker::BeginUpdate(u32 firstStage)
+{
+    m_BakeAtmos = m_Atmos;
+    m_BakeSkyView = m_SkyView;
+
+    LUTUpdateStage *pStages[StageCount];
+    for (u32 i = 0; i < StageCount; i++)
+    {
+        m_BakeHashes[i] = m_Hashes[i];
+        m_Rebaking[i] = i >= firstStage;
+        pStages[i] = &m_Stages[i];
+    }
+
+    m_Scheduler.Begin(pStages + firstStage, StageCount - firstStage);
+}
+
+void AmortizedLUTBaker::Publish()
+{
+    u32 back = m_Front.load(eastl::memory_order_relaxed) ^ 1;
+    AmortizedLUTSet &set = m_Sets[back];
+
+    LUT2D *pBakerLUTs[StageCount] = { &m_TransmittanceBaker.GetLUT(), &m_MultiScatterBaker.GetLUT(), &m_SkyViewBaker.GetLUT() };
+    const LUT2D **ppSetLUTs[StageCount] = { &set.pTransmittance, &set.pMultiScatter, &set.pSkyView };
+
+    for (u32 i = 0; i < StageCount; i++)
+    {
+        if (m_Rebaking[i])
+        {
+            // Buffer that isn't front is only referenced by the set being overwritten
+            u32 buffer = m_BufferFront[i] ^ 1;
+            m_Buffers[i][buffer].Texels.swap(pBakerLUTs[i]->Texels);
+            m_BufferFront[i] = buffer;
+
+            m_PublishedHashes[i] = m_BakeHashes[i];
+            m_Rebaking[i] = false;
+        }
+
+        *ppSetLUTs[i] = &m_Buffers[i][m_BufferFront[i]];
+    }
+
+    set.Atmos = m_BakeAtmos;
+    set.SkyView = m_BakeSkyView;
+
+    m_Front.store(back, eastl::memory_order_release);
+    m_HasPublished = true;
+}
+
+const LUT2D &AmortizedLUTBaker::GetBakeInput(u32 stage)
+{
+    if (m_Rebaking[stage])
+    {
+        if (stage == Transmittance) return m_TransmittanceBaker.GetLUT();
+        if (stage == MultiScatter) return m_MultiScatterBaker.GetLUT();
+    }
+
+    return m_Buffers[stage][m_BufferFront[stage]];
+}
\ No newline at end of file
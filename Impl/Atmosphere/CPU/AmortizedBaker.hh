@@ -0,0 +1,117 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+#include "LUTUpdateScheduler.hh"
+#include "MultiScatterBaker.hh"
+#include "OpticalDepth.hh"
+#include "SkyViewBaker.hh"
+#include "TransmittanceBaker.hh"
+
+struct AmortizedBakeSettings
+{
+    XMUINT2 TransmittanceSize = { 256, 64 };
+    IntegratorSettings Transmittance;
+
+    XMUINT2 MultiScatterSize = { 32, 32 };
+    MultiScatterSettings MultiScatter;
+
+    XMUINT2 SkyViewSize = { 200, 100 };
+    u32 SkyViewTileSize = 8;  // smaller than a full bake's tiles, a slice is one tile
+};
+
+/// Published LUTs of `AmortizedLUTBaker`, all three always belong to the same inputs
+struct AmortizedLUTSet
+{
+    const LUT2D *pTransmittance = nullptr;
+    const LUT2D *pMultiScatter = nullptr;
+    const LUT2D *pSkyView = nullptr;
+
+    /// Inputs the LUTs were baked with
+    Atmosphere Atmos;
+    SkyViewSettings SkyView;
+};
+
+/// Transmittance -> MS -> sky-view chain rebaked a few texels/tiles per frame through `LUTUpdateScheduler`.
+/// Every stage bakes into its own back buffer, finished LUTs are published together by flipping an atomic index,
+/// so readers never see a half baked LUT or LUTs of different inputs. Only stages whose inputs changed are rebaked.
+/// Slices run on the calling thread, the budget is wall time of that thread.
+class AmortizedLUTBaker
+{
+public:
+    /// `pSamples` are the MS directions like `MultiScatterBaker::Bake` takes them, they are copied
+    void Init(const AmortizedBakeSettings &settings, const XMFLOAT2 *pSamples, u32 sampleCount);
+
+    /// Latest inputs, a change is picked up once the update in flight is published. An update is never
+    /// restarted, so continuous changes (weather transitions) still publish at a steady rate.
+    void SetInputs(const Atmosphere &atmos, const SkyViewSettings &skyView);
+
+    /// Once per frame, returns true when new LUTs were published.
+    /// First bake runs in one go regardless of the budget, there's nothing to show before it.
+    bool Update(float budgetUS);
+
+public:
+    /// Empty until the first `Update`. Stays valid until the second publish after the call,
+    /// a reader on another thread can't hold on to it longer than one update.
+    const AmortizedLUTSet &GetFront()
+    {
+        return m_Sets[m_Front.load(eastl::memory_order_acquire)];
+    }
+
+    LUTUpdateScheduler &GetScheduler()
+    {
+        return m_Scheduler;
+    }
+
+private:
+    enum Stage : u32
+    {
+        Transmittance,
+        MultiScatter,
+        SkyView,
+
+        StageCount
+    };
+
+    /// First stage whose inputs differ from the published ones, `StageCount` if none
+    u32 GetFirstDirtyStage();
+
+    void BeginUpdate(u32 firstStage);
+    void Publish();
+
+    /// LUT the later stages read while baking, back buffer if the stage is part of the update
+    const LUT2D &GetBakeInput(u32 stage);
+
+    AmortizedBakeSettings m_Settings;
+    eastl::vector<XMFLOAT2> m_Samples;
+
+    TransmittanceBaker m_TransmittanceBaker;
+    MultiScatterBaker m_MultiScatterBaker;
+    SkyViewBaker m_SkyViewBaker;
+
+    LUTUpdateScheduler m_Scheduler;
+    LUTUpdateStage m_Stages[StageCount];
+
+    /// Latest inputs, and the snapshot the update in flight bakes with
+    Atmosphere m_Atmos;
+    SkyViewSettings m_SkyView;
+    Atmosphere m_BakeAtmos;
+    SkyViewSettings m_BakeSkyView;
+
+    u64 m_Hashes[StageCount] = {};
+    u64 m_BakeHashes[StageCount] = {};
+    u64 m_PublishedHashes[StageCount] = {};
+    bool m_Rebaking[StageCount] = {};
+    bool m_HasPublished = false;
+
+    /// Bakers write into their own LUT, publishing swaps it with the stage's back buffer
+    LUT2D m_Buffers[StageCount][2];
+    u32 m_BufferFront[StageCount] = {};
+
+    AmortizedLUTSet m_Sets[2];
+    eastl::atomic<u32> m_Front = 0;
+};
\ No newline at end of file
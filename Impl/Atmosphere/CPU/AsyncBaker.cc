@@ -0,0 +1,98 @@
+#include "AsyncBaker.hh"
+
+using namespace lr;
+
+AsyncLUTBaker::~AsyncLUTBaker()
+{
+    Shutdown();
+}
+
+void AsyncLUTBaker::Init(const AsyncBakeSettings &settings, const XMFLOAT2 *pSamples, u32 sampleCount)
+{
+    Shutdown();
+
+    m_Settings = settings;
+    m_Samples.assign(pSamples, pSamples + sampleCount);
+
+    u32 threadCount = settings.ThreadCount;
+    if (threadCount == 0) threadCount = eastl::max(EA::Thread::GetProcessorCount() - 1, 1);
+
+    m_Pool.Init(threadCount);
+
+    // Bakers swap their texels with result buffers, every one of them has to be the same size
+    m_Results.ForEachBuffer([&](AsyncBakeResult &result) {
+        result.Transmittance.Resize(settings.TransmittanceSize.x, settings.TransmittanceSize.y);
+        result.MultiScatter.Resize(settings.MultiScatterSize.x, settings.MultiScatterSize.y);
+    });
+
+    m_Quit = false;
+    m_Running = true;
+    m_WorkerThread.Begin(WorkerEntry, this);
+}
+
+void AsyncLUTBaker::Shutdown()
+{
+    if (!m_Running) return;
+
+    m_Quit = true;
+    m_WakeSema.Post();
+    m_WorkerThread.WaitForEnd();
+
+    m_Pool.Shutdown();
+    m_Running = false;
+}
+
+void AsyncLUTBaker::Request(const AsyncBakeRequest &request)
+{
+    m_Requests.GetWriteBuffer() = request;
+    m_Requests.Publish();
+
+    m_WakeSema.Post();
+}
+
+AsyncBakeResult *AsyncLUTBaker::Poll()
+{
+    if (!m_Results.Poll()) return nullptr;
+
+    return &m_Results.GetReadBuffer();
+}
+
+intptr_t AsyncLUTBaker::WorkerEntry(void *pContext)
+{
+    AsyncLUTBaker *pBaker = (AsyncLUTBaker *)pContext;
+
+    for (;;)
+    {
+        pBaker->m_WakeSema.Wait();
+        if (pBaker->m_Quit.load()) break;
+
+        // Every request posts once, requests that collapsed into one wake the worker with nothing new
+        if (!pBaker->m_Requests.Poll()) continue;
+
+        pBaker->m_Baking = true;
+        pBaker->Bake(pBaker->m_Requests.GetReadBuffer());
+        pBaker->m_Baking = false;
+    }
+
+    return 0;
+}
+
+void AsyncLUTBaker::Bake(const AsyncBakeRequest &request)
+{
+    Timer timer;
+
+    m_TransmittanceBaker.Init(m_Settings.TransmittanceSize.x, m_Settings.TransmittanceSize.y, request.Transmittance);
+    m_TransmittanceBaker.Bake(request.Atmos, &m_Pool);
+
+    m_MultiScatterBaker.Init(m_Settings.MultiScatterSize.x, m_Settings.MultiScatterSize.y, request.MultiScatter);
+    m_MultiScatterBaker.Bake(request.Atmos, m_TransmittanceBaker.GetLUT(), m_Samples.data(), m_Samples.size(), &m_Pool);
+
+    // Result buffer's old texels go back to the bakers, they are overwritten by the next bake
+    AsyncBakeResult &result = m_Results.GetWriteBuffer();
+    result.Request = request;
+    result.Transmittance.Texels.swap(m_TransmittanceBaker.GetLUT().Texels);
+    result.MultiScatter.Texels.swap(m_MultiScatterBaker.GetLUT().Texels);
+    result.BakeSeconds = timer.elapsed();
+
+    m_Results.Publish();
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <eathread/eathread_thread.h>
+#include <eathread/eathread_semaphore.h>
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+#include "LUTMailbox.hh"
+#include "MultiScatterBaker.hh"
+#include "OpticalDepth.hh"
+#include "TransmittanceBaker.hh"
+
+struct AsyncBakeSettings
+{
+    XMUINT2 TransmittanceSize = { 256, 64 };
+    XMUINT2 MultiScatterSize = { 32, 32 };
+
+    /// Threads of the worker's pool, worker included. 0 leaves one processor to the render thread.
+    u32 ThreadCount = 0;
+};
+
+/// Everything a bake depends on besides the sizes
+struct AsyncBakeRequest
+{
+    Atmosphere Atmos;
+    IntegratorSettings Transmittance;
+    MultiScatterSettings MultiScatter;
+
+    /// Opaque to the baker, handed back with the result (ie. LUT graph hashes)
+    u64 TransmittanceTag = 0;
+    u64 MultiScatterTag = 0;
+};
+
+struct AsyncBakeResult
+{
+    AsyncBakeRequest Request;
+
+    LUT2D Transmittance;
+    LUT2D MultiScatter;
+
+    double BakeSeconds = 0.0;
+};
+
+/// Bakes transmittance and MS on a worker thread that owns the bakers and its own pool.
+/// Requests go in and results come out through `LUTMailbox`es, so the render thread never waits on the worker:
+/// requests that arrive during a bake collapse into the latest one, results that aren't polled in time are
+/// replaced by newer ones.
+class AsyncLUTBaker
+{
+public:
+    ~AsyncLUTBaker();
+
+    /// `pSamples` are the MS directions like `MultiScatterBaker::Bake` takes them, they are copied
+    void Init(const AsyncBakeSettings &settings, const XMFLOAT2 *pSamples, u32 sampleCount);
+
+    /// Waits for the bake in flight, requests that haven't started are dropped
+    void Shutdown();
+
+    /// Render thread only, never blocks
+    void Request(const AsyncBakeRequest &request);
+
+    /// Render thread only, never blocks. Latest finished bake if there is a new one, valid until the next `Poll`.
+    AsyncBakeResult *Poll();
+
+public:
+    bool IsBaking()
+    {
+        return m_Baking.load(eastl::memory_order_relaxed);
+    }
+
+private:
+    static intptr_t WorkerEntry(void *pContext);
+    void Bake(const AsyncBakeRequest &request);
+
+    AsyncBakeSettings m_Settings;
+    eastl::vector<XMFLOAT2> m_Samples;
+
+    /// Worker only
+    TransmittanceBaker m_TransmittanceBaker;
+    MultiScatterBaker m_MultiScatterBaker;
+    ThreadPool m_Pool;
+
+    LUTMailbox<AsyncBakeRequest> m_Requests;
+    LUTMailbox<AsyncBakeResult> m_Results;
+
+    EA::Thread::Thread m_WorkerThread;
+    EA::Thread::Semaphore m_WakeSema{ 0 };
+    eastl::atomic<bool> m_Quit = false;
+    eastl::atomic<bool> m_Baking = false;
+    bool m_Running = false;
+};
\ No newline at end of file
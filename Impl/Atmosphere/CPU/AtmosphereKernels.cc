@@ -0,0 +1,167 @@
+#include "AtmosphereKernels.hh"
+
+#include "AtmosphereMath.hh"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace AtmosMath;
+
+static void ExtinctionSumScalar(const Atmosphere &atmos, const float *pAltitude, float *pR, float *pG, float *pB, u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+    {
+        XMFLOAT3 extinction;
+        XMStoreFloat3(&extinction, GetExtinctionSum(atmos, pAltitude[i]));
+
+        pR[i] = extinction.x;
+        pG[i] = extinction.y;
+        pB[i] = extinction.z;
+    }
+}
+
+static void ExtinctionSumTotalScalar(const Atmosphere &atmos, const float *pAltitude, float *pTotalRGB, u32 count)
+{
+    XMVECTOR total = XMVectorZero();
+    for (u32 i = 0; i < count; i++) total += GetExtinctionSum(atmos, pAltitude[i]);
+
+    pTotalRGB[0] += XMVectorGetX(total);
+    pTotalRGB[1] += XMVectorGetY(total);
+    pTotalRGB[2] += XMVectorGetZ(total);
+}
+
+static void ScatteringScalar(const Atmosphere &atmos, const float *pAltitude, float *pRayleighR, float *pRayleighG, float *pRayleighB, float *pMie,
+                             u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+    {
+        XMVECTOR rayleigh;
+        GetScattering(atmos, pAltitude[i], rayleigh, pMie[i]);
+
+        pRayleighR[i] = XMVectorGetX(rayleigh);
+        pRayleighG[i] = XMVectorGetY(rayleigh);
+        pRayleighB[i] = XMVectorGetZ(rayleigh);
+    }
+}
+
+static void RayleighPhaseScalar(const float *pCosTheta, float *pPhase, u32 count)
+{
+    for (u32 i = 0; i < count; i++) pPhase[i] = GetRayleighPhase(pCosTheta[i]);
+}
+
+static void MiePhaseScalar(const Atmosphere &atmos, const float *pCosTheta, float *pPhase, u32 count)
+{
+    for (u32 i = 0; i < count; i++) pPhase[i] = GetMiePhase(atmos, pCosTheta[i]);
+}
+
+static void QuadraticIntersectionScalar(const float *pOriginX, const float *pOriginY, const float *pOriginZ, const float *pDirX, const float *pDirY,
+                                        const float *pDirZ, float radius, float *pT, u8 *pHit, u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+    {
+        XMVECTOR origin = XMVectorSet(pOriginX[i], pOriginY[i], pOriginZ[i], 0.0f);
+        XMVECTOR direction = XMVectorSet(pDirX[i], pDirY[i], pDirZ[i], 0.0f);
+
+        pHit[i] = GetQuadraticIntersection3D(origin, direction, radius, pT[i]);
+    }
+}
+
+static bool IsAVX2Supported()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    bool osxsave = info[2] & (1 << 27);
+    bool avx = info[2] & (1 << 28);
+    bool fma = info[2] & (1 << 12);
+    if (!osxsave || !avx || !fma) return false;
+
+    // OS has to save YMM registers
+    if ((_xgetbv(0) & 6) != 6) return false;
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+KernelISA GetBestKernelISA()
+{
+    static KernelISA kBestISA = IsAVX2Supported() ? KernelISA::AVX2 : KernelISA::SSE;
+    return kBestISA;
+}
+
+const char *KernelISAToString(KernelISA isa)
+{
+    switch (isa)
+    {
+        case KernelISA::Scalar: return "Scalar";
+        case KernelISA::SSE: return "SSE";
+        case KernelISA::AVX2: return "AVX2";
+        default: return "Unknown";
+    }
+}
+
+static eastl::array<AtmosKernels, (u32)KernelISA::Count> CreateKernelTables()
+{
+    eastl::array<AtmosKernels, (u32)KernelISA::Count> tables;
+
+    AtmosKernels &scalar = tables[(u32)KernelISA::Scalar];
+    scalar.ISA = KernelISA::Scalar;
+    scalar.Lanes = 1;
+    scalar.ExtinctionSum = ExtinctionSumScalar;
+    scalar.ExtinctionSumTotal = ExtinctionSumTotalScalar;
+    scalar.Scattering = ScatteringScalar;
+    scalar.RayleighPhase = RayleighPhaseScalar;
+    scalar.MiePhase = MiePhaseScalar;
+    scalar.QuadraticIntersection = QuadraticIntersectionScalar;
+
+    FillKernelsSSE(tables[(u32)KernelISA::SSE]);
+    FillKernelsAVX2(tables[(u32)KernelISA::AVX2]);
+
+    return tables;
+}
+
+const AtmosKernels &GetAtmosKernels(KernelISA isa)
+{
+    static eastl::array<AtmosKernels, (u32)KernelISA::Count> kTables = CreateKernelTables();
+
+    if (isa > GetBestKernelISA()) isa = GetBestKernelISA();
+
+    return kTables[(u32)isa];
+}
+
+const AtmosKernels &GetAtmosKernels()
+{
+    return GetAtmosKernels(GetBestKernelISA());
+}
+
+AtmosKernelParams GetKernelParams(const Atmosphere &atmos)
+{
+    AtmosKernelParams params;
+    params.RayleighScatter[0] = atmos.RayleighScatterVal.x;
+    params.RayleighScatter[1] = atmos.RayleighScatterVal.y;
+    params.RayleighScatter[2] = atmos.RayleighScatterVal.z;
+    params.RayleighDensity = atmos.RayleighDensity;
+
+    params.MieScatter = atmos.MieScatterVal;
+    params.MieAbsorption = atmos.MieAbsorptionVal;
+    params.MieDensity = atmos.MieDensity;
+    params.MieAsymmetry = atmos.MieAsymmetry;
+
+    params.OzoneAbsorption[0] = atmos.OzoneAbsorption.x;
+    params.OzoneAbsorption[1] = atmos.OzoneAbsorption.y;
+    params.OzoneAbsorption[2] = atmos.OzoneAbsorption.z;
+    params.OzoneHeight = atmos.OzoneHeight;
+    params.OzoneThickness = atmos.OzoneThickness;
+
+    return params;
+}
\ No newline at end of file
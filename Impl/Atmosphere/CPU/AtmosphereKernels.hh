@@ -0,0 +1,74 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <stdint.h>
+
+// Included without the pch by ISA specific translation units, so nothing here may pull in EASTL or DirectXMath.
+// Anything with an inline body would be emitted with their instruction set and could be picked by the linker.
+struct Atmosphere;
+
+/// Batched versions of `AtmosMath` functions, every pointer is an array of `count` samples (SoA).
+/// Tables are filled per instruction set, `GetAtmosKernels()` picks the best one the CPU supports.
+enum class KernelISA : uint8_t
+{
+    Scalar,
+    SSE,
+    AVX2,
+
+    Count
+};
+
+/// `Atmosphere` values the SIMD kernels read, plain floats so they don't need its definition
+struct AtmosKernelParams
+{
+    float RayleighScatter[3];
+    float RayleighDensity;
+
+    float MieScatter;
+    float MieAbsorption;
+    float MieDensity;
+    float MieAsymmetry;
+
+    float OzoneAbsorption[3];
+    float OzoneHeight;
+    float OzoneThickness;
+};
+
+struct AtmosKernels
+{
+    KernelISA ISA = KernelISA::Scalar;
+    uint32_t Lanes = 1;
+
+    /// GetExtinctionSum, output is split into channels
+    void (*ExtinctionSum)(const Atmosphere &atmos, const float *pAltitude, float *pR, float *pG, float *pB, uint32_t count) = nullptr;
+
+    /// Sum of GetExtinctionSum over all samples, what transmittance integrals need
+    void (*ExtinctionSumTotal)(const Atmosphere &atmos, const float *pAltitude, float *pTotalRGB, uint32_t count) = nullptr;
+
+    /// GetScattering, Rayleigh is split into channels
+    void (*Scattering)(const Atmosphere &atmos, const float *pAltitude, float *pRayleighR, float *pRayleighG, float *pRayleighB, float *pMie,
+                       uint32_t count) = nullptr;
+
+    void (*RayleighPhase)(const float *pCosTheta, float *pPhase, uint32_t count) = nullptr;
+    void (*MiePhase)(const Atmosphere &atmos, const float *pCosTheta, float *pPhase, uint32_t count) = nullptr;
+
+    /// GetQuadraticIntersection3D, `pHit` is the return value. `pT` is left untouched when discriminant is negative.
+    void (*QuadraticIntersection)(const float *pOriginX, const float *pOriginY, const float *pOriginZ, const float *pDirX, const float *pDirY,
+                                  const float *pDirZ, float radius, float *pT, uint8_t *pHit, uint32_t count) = nullptr;
+};
+
+KernelISA GetBestKernelISA();
+const char *KernelISAToString(KernelISA isa);
+
+/// Falls back to the next best table if `isa` is not compiled in or not supported
+const AtmosKernels &GetAtmosKernels(KernelISA isa);
+const AtmosKernels &GetAtmosKernels();
+
+AtmosKernelParams GetKernelParams(const Atmosphere &atmos);
+
+/// Filled by per ISA translation units
+void FillKernelsSSE(AtmosKernels &kernels);
+void FillKernelsAVX2(AtmosKernels &kernels);
\ No newline at end of file
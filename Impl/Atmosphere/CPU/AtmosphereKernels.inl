@@ -0,0 +1,224 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+/// Shared body of SIMD kernels. Included by every ISA translation unit after it defines `SimdF`,
+/// a float vector type with `kLanes`, Load/Store/Set1, arithmetic operators, Min/Max/Abs/Sqrt,
+/// Round, Pow2 (from integral floats), compare masks, Select and MoveMask.
+/// Leftover samples go through the scalar table, ISA specific TUs must not emit DirectXMath inlines so
+/// `Atmosphere` is only read through `GetKernelParams`.
+
+namespace
+{
+    constexpr float kPI = 3.14159265358f;
+
+    const AtmosKernels &Scalar()
+    {
+        return GetAtmosKernels(KernelISA::Scalar);
+    }
+
+    // Cephes expf, ~2 ulp in [-87, 88] which covers every density profile we evaluate
+    inline SimdF ExpFast(SimdF x)
+    {
+        x = SimdF::Min(SimdF::Max(x, SimdF::Set1(-87.3365f)), SimdF::Set1(88.3762f));
+
+        SimdF fx = SimdF::Round(x * SimdF::Set1(1.44269504088896341f));
+        x = x - fx * SimdF::Set1(0.693359375f);
+        x = x - fx * SimdF::Set1(-2.12194440e-4f);
+
+        SimdF y = SimdF::Set1(1.9875691500e-4f);
+        y = y * x + SimdF::Set1(1.3981999507e-3f);
+        y = y * x + SimdF::Set1(8.3334519073e-3f);
+        y = y * x + SimdF::Set1(4.1665795894e-2f);
+        y = y * x + SimdF::Set1(1.6666665459e-1f);
+        y = y * x + SimdF::Set1(5.0000001201e-1f);
+        y = y * x * x + x + SimdF::Set1(1.0f);
+
+        return y * SimdF::Pow2(fx);
+    }
+
+    struct ExtinctionSIMD
+    {
+        ExtinctionSIMD(const AtmosKernelParams &params)
+            : RayleighR(SimdF::Set1(params.RayleighScatter[0])), RayleighG(SimdF::Set1(params.RayleighScatter[1])),
+              RayleighB(SimdF::Set1(params.RayleighScatter[2])), RayleighInvDensity(SimdF::Set1(-1.0f / params.RayleighDensity)),
+              Mie(SimdF::Set1(params.MieScatter + params.MieAbsorption)), MieInvDensity(SimdF::Set1(-1.0f / params.MieDensity)),
+              OzoneR(SimdF::Set1(params.OzoneAbsorption[0])), OzoneG(SimdF::Set1(params.OzoneAbsorption[1])), OzoneB(SimdF::Set1(params.OzoneAbsorption[2])),
+              OzoneHeight(SimdF::Set1(params.OzoneHeight)), OzoneInvThickness(SimdF::Set1(1.0f / params.OzoneThickness))
+        {
+        }
+
+        inline void Evaluate(SimdF altitude, SimdF &r, SimdF &g, SimdF &b) const
+        {
+            SimdF rayleigh = ExpFast(altitude * RayleighInvDensity);
+            SimdF mie = Mie * ExpFast(altitude * MieInvDensity);
+            SimdF ozone = SimdF::Max(SimdF::Set1(0.0f), SimdF::Set1(1.0f) - SimdF::Abs(altitude - OzoneHeight) * OzoneInvThickness);
+
+            r = RayleighR * rayleigh + mie + OzoneR * ozone;
+            g = RayleighG * rayleigh + mie + OzoneG * ozone;
+            b = RayleighB * rayleigh + mie + OzoneB * ozone;
+        }
+
+        SimdF RayleighR, RayleighG, RayleighB, RayleighInvDensity;
+        SimdF Mie, MieInvDensity;
+        SimdF OzoneR, OzoneG, OzoneB, OzoneHeight, OzoneInvThickness;
+    };
+
+    void ExtinctionSumSIMD(const Atmosphere &atmos, const float *pAltitude, float *pR, float *pG, float *pB, uint32_t count)
+    {
+        ExtinctionSIMD extinction(GetKernelParams(atmos));
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF r, g, b;
+            extinction.Evaluate(SimdF::Load(pAltitude + i), r, g, b);
+
+            SimdF::Store(pR + i, r);
+            SimdF::Store(pG + i, g);
+            SimdF::Store(pB + i, b);
+        }
+
+        Scalar().ExtinctionSum(atmos, pAltitude + i, pR + i, pG + i, pB + i, count - i);
+    }
+
+    void ExtinctionSumTotalSIMD(const Atmosphere &atmos, const float *pAltitude, float *pTotalRGB, uint32_t count)
+    {
+        ExtinctionSIMD extinction(GetKernelParams(atmos));
+
+        SimdF totalR = SimdF::Set1(0.0f);
+        SimdF totalG = SimdF::Set1(0.0f);
+        SimdF totalB = SimdF::Set1(0.0f);
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF r, g, b;
+            extinction.Evaluate(SimdF::Load(pAltitude + i), r, g, b);
+
+            totalR = totalR + r;
+            totalG = totalG + g;
+            totalB = totalB + b;
+        }
+
+        pTotalRGB[0] += SimdF::HorizontalSum(totalR);
+        pTotalRGB[1] += SimdF::HorizontalSum(totalG);
+        pTotalRGB[2] += SimdF::HorizontalSum(totalB);
+
+        Scalar().ExtinctionSumTotal(atmos, pAltitude + i, pTotalRGB, count - i);
+    }
+
+    void ScatteringSIMD(const Atmosphere &atmos, const float *pAltitude, float *pRayleighR, float *pRayleighG, float *pRayleighB, float *pMie,
+                        uint32_t count)
+    {
+        AtmosKernelParams params = GetKernelParams(atmos);
+
+        SimdF rayleighR = SimdF::Set1(params.RayleighScatter[0]);
+        SimdF rayleighG = SimdF::Set1(params.RayleighScatter[1]);
+        SimdF rayleighB = SimdF::Set1(params.RayleighScatter[2]);
+        SimdF rayleighInvDensity = SimdF::Set1(-1.0f / params.RayleighDensity);
+        SimdF mieVal = SimdF::Set1(params.MieScatter + params.MieAbsorption);
+        SimdF mieInvDensity = SimdF::Set1(-1.0f / params.MieDensity);
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF altitude = SimdF::Load(pAltitude + i);
+            SimdF rayleigh = ExpFast(altitude * rayleighInvDensity);
+
+            SimdF::Store(pRayleighR + i, rayleighR * rayleigh);
+            SimdF::Store(pRayleighG + i, rayleighG * rayleigh);
+            SimdF::Store(pRayleighB + i, rayleighB * rayleigh);
+            SimdF::Store(pMie + i, mieVal * ExpFast(altitude * mieInvDensity));
+        }
+
+        Scalar().Scattering(atmos, pAltitude + i, pRayleighR + i, pRayleighG + i, pRayleighB + i, pMie + i, count - i);
+    }
+
+    void RayleighPhaseSIMD(const float *pCosTheta, float *pPhase, uint32_t count)
+    {
+        SimdF k = SimdF::Set1(3.0f / (16.0f * kPI));
+        SimdF one = SimdF::Set1(1.0f);
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF cosTheta = SimdF::Load(pCosTheta + i);
+            SimdF::Store(pPhase + i, k * (one + cosTheta * cosTheta));
+        }
+
+        Scalar().RayleighPhase(pCosTheta + i, pPhase + i, count - i);
+    }
+
+    void MiePhaseSIMD(const Atmosphere &atmos, const float *pCosTheta, float *pPhase, uint32_t count)
+    {
+        const float g = GetKernelParams(atmos).MieAsymmetry;
+        const float g2 = g * g;
+
+        SimdF one = SimdF::Set1(1.0f);
+        SimdF scaledNum = SimdF::Set1((3.0f / (8.0f * kPI)) * (1.0f - g2));
+        SimdF denomScale = SimdF::Set1(2.0f + g2);
+        SimdF onePlusG2 = SimdF::Set1(1.0f + g2);
+        SimdF twoG = SimdF::Set1(2.0f * g);
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF cosTheta = SimdF::Load(pCosTheta + i);
+
+            // pow(x, 1.5) = x * sqrt(x)
+            SimdF base = SimdF::Abs(onePlusG2 - twoG * cosTheta);
+            SimdF denom = denomScale * base * SimdF::Sqrt(base);
+
+            SimdF::Store(pPhase + i, scaledNum * (one + cosTheta * cosTheta) / denom);
+        }
+
+        Scalar().MiePhase(atmos, pCosTheta + i, pPhase + i, count - i);
+    }
+
+    void QuadraticIntersectionSIMD(const float *pOriginX, const float *pOriginY, const float *pOriginZ, const float *pDirX, const float *pDirY,
+                                   const float *pDirZ, float radius, float *pT, uint8_t *pHit, uint32_t count)
+    {
+        SimdF zero = SimdF::Set1(0.0f);
+        SimdF radius2 = SimdF::Set1(radius * radius);
+
+        uint32_t i = 0;
+        for (; i + SimdF::kLanes <= count; i += SimdF::kLanes)
+        {
+            SimdF ox = SimdF::Load(pOriginX + i), oy = SimdF::Load(pOriginY + i), oz = SimdF::Load(pOriginZ + i);
+            SimdF dx = SimdF::Load(pDirX + i), dy = SimdF::Load(pDirY + i), dz = SimdF::Load(pDirZ + i);
+
+            SimdF a = dx * dx + dy * dy + dz * dz;
+            SimdF b = SimdF::Set1(2.0f) * (ox * dx + oy * dy + oz * dz);
+            SimdF c = ox * ox + oy * oy + oz * oz - radius2;
+            SimdF discriminant = b * b - SimdF::Set1(4.0f) * a * c;
+
+            SimdF valid = SimdF::CmpGE(discriminant, zero);
+            SimdF root = SimdF::Sqrt(SimdF::Max(discriminant, zero));
+
+            // Inside the sphere we want the far hit, outside the near one
+            SimdF signedRoot = SimdF::Select(SimdF::CmpLE(c, zero), root, zero - root);
+            SimdF t = (zero - b + signedRoot) / (a * SimdF::Set1(2.0f));
+
+            SimdF::Store(pT + i, SimdF::Select(valid, t, SimdF::Load(pT + i)));
+
+            uint32_t hitBits = SimdF::MoveMask(SimdF::And(valid, SimdF::CmpLE(b, zero)));
+            for (uint32_t lane = 0; lane < SimdF::kLanes; lane++) pHit[i + lane] = (hitBits >> lane) & 1;
+        }
+
+        Scalar().QuadraticIntersection(pOriginX + i, pOriginY + i, pOriginZ + i, pDirX + i, pDirY + i, pDirZ + i, radius, pT + i, pHit + i, count - i);
+    }
+
+    void FillKernelsSIMD(AtmosKernels &kernels, KernelISA isa)
+    {
+        kernels.ISA = isa;
+        kernels.Lanes = SimdF::kLanes;
+        kernels.ExtinctionSum = ExtinctionSumSIMD;
+        kernels.ExtinctionSumTotal = ExtinctionSumTotalSIMD;
+        kernels.Scattering = ScatteringSIMD;
+        kernels.RayleighPhase = RayleighPhaseSIMD;
+        kernels.MiePhase = MiePhaseSIMD;
+        kernels.QuadraticIntersection = QuadraticIntersectionSIMD;
+    }
+
+}  // namespace
\ No newline at end of file
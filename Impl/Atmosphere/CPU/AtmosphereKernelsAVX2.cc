@@ -0,0 +1,62 @@
+// This file is compiled with AVX2/FMA enabled. It can't share the PCH with the rest of the target and may only
+// include headers without inline functions, their AVX2 copies could replace the baseline ones at link time.
+#include "AtmosphereKernels.hh"
+
+#include <immintrin.h>
+
+namespace
+{
+    struct SimdF
+    {
+        constexpr static uint32_t kLanes = 8;
+
+        __m256 V;
+
+        // clang-format off
+        static SimdF Load(const float *p)           { return { _mm256_loadu_ps(p) }; }
+        static void Store(float *p, SimdF v)        { _mm256_storeu_ps(p, v.V); }
+        static SimdF Set1(float v)                  { return { _mm256_set1_ps(v) }; }
+
+        SimdF operator+(SimdF o) const              { return { _mm256_add_ps(V, o.V) }; }
+        SimdF operator-(SimdF o) const              { return { _mm256_sub_ps(V, o.V) }; }
+        SimdF operator*(SimdF o) const              { return { _mm256_mul_ps(V, o.V) }; }
+        SimdF operator/(SimdF o) const              { return { _mm256_div_ps(V, o.V) }; }
+
+        static SimdF Min(SimdF a, SimdF b)          { return { _mm256_min_ps(a.V, b.V) }; }
+        static SimdF Max(SimdF a, SimdF b)          { return { _mm256_max_ps(a.V, b.V) }; }
+        static SimdF Abs(SimdF a)                   { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.V) }; }
+        static SimdF Sqrt(SimdF a)                  { return { _mm256_sqrt_ps(a.V) }; }
+        static SimdF Round(SimdF a)                 { return { _mm256_round_ps(a.V, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+
+        static SimdF CmpGE(SimdF a, SimdF b)        { return { _mm256_cmp_ps(a.V, b.V, _CMP_GE_OQ) }; }
+        static SimdF CmpLE(SimdF a, SimdF b)        { return { _mm256_cmp_ps(a.V, b.V, _CMP_LE_OQ) }; }
+        static SimdF And(SimdF a, SimdF b)          { return { _mm256_and_ps(a.V, b.V) }; }
+        static SimdF Select(SimdF m, SimdF a, SimdF b) { return { _mm256_blendv_ps(b.V, a.V, m.V) }; }
+        static uint32_t MoveMask(SimdF m)           { return _mm256_movemask_ps(m.V); }
+        // clang-format on
+
+        // `n` has to be an integral float in exponent range
+        static SimdF Pow2(SimdF n)
+        {
+            __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n.V), _mm256_set1_epi32(127));
+            return { _mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23)) };
+        }
+
+        static float HorizontalSum(SimdF v)
+        {
+            __m128 sums = _mm_add_ps(_mm256_castps256_ps128(v.V), _mm256_extractf128_ps(v.V, 1));
+            __m128 shuffled = _mm_movehdup_ps(sums);
+            sums = _mm_add_ps(sums, shuffled);
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+    };
+
+}  // namespace
+
+#include "AtmosphereKernels.inl"
+
+void FillKernelsAVX2(AtmosKernels &kernels)
+{
+    FillKernelsSIMD(kernels, KernelISA::AVX2);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "AtmosphereKernels.hh"
+
+#include <emmintrin.h>
+
+namespace
+{
+    /// SSE2 only, it's the x64 baseline so no dispatch check is needed
+    struct SimdF
+    {
+        constexpr static u32 kLanes = 4;
+
+        __m128 V;
+
+        // clang-format off
+        static SimdF Load(const float *p)           { return { _mm_loadu_ps(p) }; }
+        static void Store(float *p, SimdF v)        { _mm_storeu_ps(p, v.V); }
+        static SimdF Set1(float v)                  { return { _mm_set1_ps(v) }; }
+
+        SimdF operator+(SimdF o) const              { return { _mm_add_ps(V, o.V) }; }
+        SimdF operator-(SimdF o) const              { return { _mm_sub_ps(V, o.V) }; }
+        SimdF operator*(SimdF o) const              { return { _mm_mul_ps(V, o.V) }; }
+        SimdF operator/(SimdF o) const              { return { _mm_div_ps(V, o.V) }; }
+
+        static SimdF Min(SimdF a, SimdF b)          { return { _mm_min_ps(a.V, b.V) }; }
+        static SimdF Max(SimdF a, SimdF b)          { return { _mm_max_ps(a.V, b.V) }; }
+        static SimdF Abs(SimdF a)                   { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.V) }; }
+        static SimdF Sqrt(SimdF a)                  { return { _mm_sqrt_ps(a.V) }; }
+        static SimdF Round(SimdF a)                 { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.V)) }; }
+
+        static SimdF CmpGE(SimdF a, SimdF b)        { return { _mm_cmpge_ps(a.V, b.V) }; }
+        static SimdF CmpLE(SimdF a, SimdF b)        { return { _mm_cmple_ps(a.V, b.V) }; }
+        static SimdF And(SimdF a, SimdF b)          { return { _mm_and_ps(a.V, b.V) }; }
+        static SimdF Select(SimdF m, SimdF a, SimdF b) { return { _mm_or_ps(_mm_and_ps(m.V, a.V), _mm_andnot_ps(m.V, b.V)) }; }
+        static u32 MoveMask(SimdF m)                { return _mm_movemask_ps(m.V); }
+        // clang-format on
+
+        // `n` has to be an integral float in exponent range
+        static SimdF Pow2(SimdF n)
+        {
+            __m128i exponent = _mm_add_epi32(_mm_cvtps_epi32(n.V), _mm_set1_epi32(127));
+            return { _mm_castsi128_ps(_mm_slli_epi32(exponent, 23)) };
+        }
+
+        static float HorizontalSum(SimdF v)
+        {
+            __m128 shuffled = _mm_shuffle_ps(v.V, v.V, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(v.V, shuffled);
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+        }
+    };
+
+}  // namespace
+
+#include "AtmosphereKernels.inl"
+
+void FillKernelsSSE(AtmosKernels &kernels)
+{
+    FillKernelsSIMD(kernels, KernelISA::SSE);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+
+/// CPU port of `Resources/Shaders/Atmos/Common.hlsl` and `Raymarch.hlsl`, keep them in sync.
+namespace AtmosMath
+{
+    constexpr float PI = 3.14159265358f;
+
+    inline XMVECTOR SampleLUT(const LUT2D &lut, const Atmosphere &atmos, float altitude, float theta)
+    {
+        float u = 0.5f + 0.5f * theta;
+        float v = bx::clamp(altitude / (atmos.AtmosRadius - atmos.PlanetRadius), 0.0f, 1.0f);
+
+        return lut.Sample(u, v);
+    }
+
+    inline XMVECTOR GetExtinctionSum(const Atmosphere &atmos, float altitude)
+    {
+        XMVECTOR rayleigh = XMLoadFloat3(&atmos.RayleighScatterVal) * expf(-altitude / atmos.RayleighDensity);
+        float mie = (atmos.MieScatterVal + atmos.MieAbsorptionVal) * expf(-altitude / atmos.MieDensity);
+        XMVECTOR ozone = XMLoadFloat3(&atmos.OzoneAbsorption) * bx::max(0.0f, 1.0f - fabsf(altitude - atmos.OzoneHeight) / atmos.OzoneThickness);
+
+        return rayleigh + XMVectorReplicate(mie) + ozone;
+    }
+
+    inline void GetScattering(const Atmosphere &atmos, float altitude, XMVECTOR &rayleigh, float &mie)
+    {
+        rayleigh = XMLoadFloat3(&atmos.RayleighScatterVal) * expf(-altitude / atmos.RayleighDensity);
+        mie = (atmos.MieScatterVal + atmos.MieAbsorptionVal) * expf(-altitude / atmos.MieDensity);
+    }
+
+    inline float GetRayleighPhase(float cosTheta)
+    {
+        constexpr float k = 3.0f / (16.0f * PI);
+        return k * (1.0f + cosTheta * cosTheta);
+    }
+
+    inline float GetMiePhase(const Atmosphere &atmos, float cosTheta)
+    {
+        const float g = atmos.MieAsymmetry;
+        const float g2 = g * g;
+        constexpr float scale = 3.0f / (8.0f * PI);
+
+        float num = (1.0f - g2) * (1.0f + cosTheta * cosTheta);
+        float denom = (2.0f + g2) * powf(fabsf(1.0f + g2 - 2.0f * g * cosTheta), 1.5f);
+
+        return scale * num / denom;
+    }
+
+    // Finds if a point intersects with a circle, returns false if ray hits ground
+    inline bool SolveQuadratic(FXMVECTOR origin, FXMVECTOR direction, float radius)
+    {
+        float a = XMVectorGetX(XMVector3Dot(direction, direction));
+        float b = 2.0f * XMVectorGetX(XMVector3Dot(origin, direction));
+        float c = XMVectorGetX(XMVector3Dot(origin, origin)) - radius * radius;
+        float discriminant = b * b - 4.0f * a * c;
+
+        return (discriminant >= 0.0f) && (b <= 0.0f);
+    }
+
+    // Out T = distance from origin
+    inline bool GetQuadraticIntersection3D(FXMVECTOR origin, FXMVECTOR direction, float radius, float &t)
+    {
+        float a = XMVectorGetX(XMVector3Dot(direction, direction));
+        float b = 2.0f * XMVectorGetX(XMVector3Dot(origin, direction));
+        float c = XMVectorGetX(XMVector3Dot(origin, origin)) - radius * radius;
+        float discriminant = b * b - 4.0f * a * c;
+
+        if (discriminant < 0.0f) return false;
+
+        if (c <= 0.0f)
+            t = (-b + sqrtf(discriminant)) / (a * 2.0f);
+        else
+            t = (-b + -sqrtf(discriminant)) / (a * 2.0f);
+
+        return (b <= 0.0f);
+    }
+
+    /// Entry point is pushed this far below the top, so the march starts inside the atmosphere
+    constexpr float kTopAtmosphereOffset = 10.0f;
+
+    /// Port of `MoveToTopAtmosphere` in `Atmos/Raymarch.hlsl`. Moves `origin` to where `direction` enters
+    /// the atmosphere, returns false if the ray misses it. Origins already inside are left untouched.
+    inline bool MoveToTopAtmosphere(const Atmosphere &atmos, XMVECTOR &origin, FXMVECTOR direction)
+    {
+        float h = XMVectorGetX(XMVector3Length(origin));
+        if (h < atmos.AtmosRadius) return true;
+
+        float t = 0.0f;
+        if (!GetQuadraticIntersection3D(origin, direction, atmos.AtmosRadius, t)) return false;
+
+        XMVECTOR up = origin / h;
+        origin += direction * t - up * kTopAtmosphereOffset;
+
+        return true;
+    }
+
+}  // namespace AtmosMath
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "FinalPass.hh"
+
+#include <emmintrin.h>
+
+#include <bx/math.h>
+
+#include "AtmosphereMath.hh"
+#include "SkyViewBaker.hh"
+
+using namespace AtmosMath;
+
+void ImageRGBA8::Resize(u32 width, u32 height)
+{
+    Width = width;
+    Height = height;
+
+    Pixels.resize(width * height);
+}
+
+/// Random threshold of `FixHDR`, lane-wise
+static XMVECTOR GetDitherThreshold(XMVECTOR seedX, XMVECTOR seedY)
+{
+    XMVECTOR noise = XMVectorSin((seedX * 12.9898f + seedY * 78.233f) * 2.0f) * 43758.5453f;
+    return noise - XMVectorFloor(noise);
+}
+
+static XMVECTOR Dither(XMVECTOR threshold, XMVECTOR color)
+{
+    color *= 255.0f;
+
+    XMVECTOR floorColor = XMVectorFloor(color);
+    XMVECTOR roundUp = XMVectorLess(threshold, color - floorColor);
+    color = XMVectorSelect(floorColor, XMVectorCeiling(color), roundUp);
+
+    return color / 255.0f;
+}
+
+namespace FinalPass
+{
+    XMVECTOR ACES(XMVECTOR x)
+    {
+        constexpr float a = 2.51f;
+        constexpr float b = 0.03f;
+        constexpr float c = 2.43f;
+        constexpr float d = 0.59f;
+        constexpr float e = 0.14f;
+
+        XMVECTOR mapped = XMVectorAbs((x * (a * x + XMVectorReplicate(b))) / (x * (c * x + XMVectorReplicate(d)) + XMVectorReplicate(e)));
+
+        // XMVectorPow is a powf per lane
+        return XMVectorSaturate(XMVectorExp2(XMVectorLog2(mapped) * (1.0f / 1.7f)));
+    }
+
+    XMVECTOR FixHDR(XMFLOAT2 seed, XMVECTOR color)
+    {
+        XMVECTOR threshold = GetDitherThreshold(XMVectorReplicate(seed.x), XMVectorReplicate(seed.y));
+        return Dither(threshold, color);
+    }
+
+    XMVECTOR GetViewDirection(const CameraFrustum &frustum, float u, float v)
+    {
+        XMVECTOR topLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointX));
+        XMVECTOR topRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointY));
+        XMVECTOR bottomLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointZ));
+        XMVECTOR bottomRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointW));
+
+        return XMVector3Normalize(XMVectorLerp(XMVectorLerp(topLeft, topRight, u), XMVectorLerp(bottomLeft, bottomRight, u), v));
+    }
+
+    XMVECTOR GetSun(const FinalPassSettings &settings, XMVECTOR rayDirection)
+    {
+        float sunCos = XMVectorGetX(XMVector3Dot(rayDirection, XMLoadFloat3(&settings.SunDirection)));
+        float radCos = cosf(settings.SunRadius * PI / 180.0f);
+
+        if (sunCos > radCos) return XMVectorReplicate(settings.SunIntensity);
+
+        return XMVectorZero();
+    }
+
+    XMVECTOR SampleSky(const LUT2D &skyViewLUT, XMVECTOR rayDirection)
+    {
+        XMFLOAT3 direction;
+        XMStoreFloat3(&direction, rayDirection);
+
+        float l = asinf(bx::clamp(direction.y, -1.0f, 1.0f));
+        float u = atan2f(direction.z, direction.x) / (2.0f * PI);
+        float v = 0.5f - 0.5f * bx::sign(l) * sqrtf(fabsf(l) / (0.5f * PI));
+
+        // Final pass samples with wrap on U
+        return skyViewLUT.SampleWrapU(u, v);
+    }
+
+    bool IsAboveAtmosphere(const Atmosphere &atmos, const FinalPassSettings &settings)
+    {
+        return XMVectorGetX(XMVector3Length(XMLoadFloat3(&settings.EyePosition))) >= atmos.AtmosRadius;
+    }
+
+    XMVECTOR RaymarchSky(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT, const FinalPassSettings &settings,
+                         XMVECTOR rayDirection)
+    {
+        XMVECTOR origin = XMLoadFloat3(&settings.EyePosition);
+        if (!MoveToTopAtmosphere(atmos, origin, rayDirection)) return XMVectorZero();
+
+        SkyViewSettings skyView;
+        XMStoreFloat3(&skyView.EyePosition, origin);
+        skyView.StepCount = settings.StepCount;
+        skyView.SunDirection = settings.SunDirection;
+        skyView.SunIntensity = settings.SunIntensity;
+
+        return SkyViewBaker::CalculateLuminance(atmos, skyView, transmittanceLUT, multiScatterLUT, rayDirection);
+    }
+
+    XMVECTOR Resolve(const FinalPassSettings &settings, XMVECTOR luminance, XMVECTOR rayDirection, XMFLOAT2 seed)
+    {
+        XMVECTOR color = ACES(luminance);
+        color = FixHDR(seed, color);
+
+        color += GetSun(settings, rayDirection);
+
+        return XMVectorSaturate(color);
+    }
+
+    XMVECTOR Shade(const LUT2D &skyViewLUT, const FinalPassSettings &settings, XMVECTOR rayDirection, XMFLOAT2 seed)
+    {
+        return Resolve(settings, SampleSky(skyViewLUT, rayDirection), rayDirection, seed);
+    }
+
+    void RenderPanoramaRows(const LUT2D &skyViewLUT, const FinalPassSettings &settings, ImageRGBA8 &image, u32 begin, u32 end)
+    {
+        for (u32 y = begin; y < end; y++)
+        {
+            float v = (y + 0.5f) / image.Height;
+            float elevation = (0.5f - v) * PI;
+
+            for (u32 x = 0; x < image.Width; x++)
+            {
+                float u = (x + 0.5f) / image.Width;
+                float azimuth = 2.0f * PI * u;
+
+                float cosElevation = cosf(elevation);
+                XMVECTOR direction = XMVectorSet(cosElevation * cosf(azimuth), sinf(elevation), cosElevation * sinf(azimuth), 0.0f);
+
+                XMVECTOR color = Shade(skyViewLUT, settings, direction, XMFLOAT2(u, v));
+                color = XMVectorSetW(color, 1.0f);
+
+                XMStoreUByteN4((XMUBYTEN4 *)&image.Pixels[y * image.Width + x], color);
+            }
+        }
+    }
+
+    void RenderFrustumRows(const Atmosphere &atmos, const FinalPassLUTs &luts, const FinalPassSettings &settings, const CameraFrustum &frustum,
+                           ImageRGBA8 &image, u32 begin, u32 end, LUT2D *pLuminance)
+    {
+        const u32 width = image.Width;
+        const u32 batchCount = (width + 3) / 4;
+        const bool aboveAtmosphere = IsAboveAtmosphere(atmos, settings);
+
+        XMVECTOR topLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointX));
+        XMVECTOR topRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointY));
+        XMVECTOR bottomLeft = XMVector3Normalize(XMLoadFloat3(&frustum.PointZ));
+        XMVECTOR bottomRight = XMVector3Normalize(XMLoadFloat3(&frustum.PointW));
+
+        XMVECTOR sunX = XMVectorReplicate(settings.SunDirection.x);
+        XMVECTOR sunY = XMVectorReplicate(settings.SunDirection.y);
+        XMVECTOR sunZ = XMVectorReplicate(settings.SunDirection.z);
+        XMVECTOR sunIntensity = XMVectorReplicate(settings.SunIntensity);
+        XMVECTOR radCos = XMVectorReplicate(cosf(settings.SunRadius * PI / 180.0f));
+
+        // Pixel centers of a batch, same as `(x + 0.5f) / width` per pixel
+        XMVECTOR laneOffset = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+
+        /// Scanline in SoA, padded to whole batches
+        thread_local eastl::vector<float> scratch;
+        scratch.resize(batchCount * 4 * 8);
+
+        float *pDirX = scratch.data();
+        float *pDirY = pDirX + batchCount * 4;
+        float *pDirZ = pDirY + batchCount * 4;
+        float *pU = pDirZ + batchCount * 4;
+        float *pV = pU + batchCount * 4;
+        float *pLumR = pV + batchCount * 4;
+        float *pLumG = pLumR + batchCount * 4;
+        float *pLumB = pLumG + batchCount * 4;
+
+        for (u32 y = begin; y < end; y++)
+        {
+            float v = (y + 0.5f) / image.Height;
+            XMVECTOR seedY = XMVectorReplicate(v);
+
+            // Same bilinear frustum as `GetViewDirection`, rows are lerped first
+            XMFLOAT3 left, right;
+            XMStoreFloat3(&left, XMVectorLerp(topLeft, bottomLeft, v));
+            XMStoreFloat3(&right, XMVectorLerp(topRight, bottomRight, v));
+
+            for (u32 i = 0; i < batchCount * 4; i += 4)
+            {
+                XMVECTOR u = (XMVectorReplicate((float)i) + laneOffset) / (float)width;
+
+                XMVECTOR dirX = XMVectorReplicate(left.x) + (right.x - left.x) * u;
+                XMVECTOR dirY = XMVectorReplicate(left.y) + (right.y - left.y) * u;
+                XMVECTOR dirZ = XMVectorReplicate(left.z) + (right.z - left.z) * u;
+
+                XMVECTOR length = XMVectorSqrt(dirX * dirX + dirY * dirY + dirZ * dirZ);
+                dirX /= length;
+                dirY /= length;
+                dirZ /= length;
+
+                XMStoreFloat4((XMFLOAT4 *)(pDirX + i), dirX);
+                XMStoreFloat4((XMFLOAT4 *)(pDirY + i), dirY);
+                XMStoreFloat4((XMFLOAT4 *)(pDirZ + i), dirZ);
+
+                // Sky-view LUT coordinates of `SampleSky`
+                XMVECTOR l = XMVectorASin(XMVectorClamp(dirY, XMVectorReplicate(-1.0f), XMVectorReplicate(1.0f)));
+                XMVECTOR lutU = XMVectorATan2(dirZ, dirX) / (2.0f * PI);
+
+                XMVECTOR signedRoot = XMVectorOrInt(XMVectorSqrt(XMVectorAbs(l) / (0.5f * PI)), XMVectorAndInt(l, g_XMNegativeZero));
+                XMVECTOR lutV = XMVectorReplicate(0.5f) - 0.5f * signedRoot;
+
+                XMStoreFloat4((XMFLOAT4 *)(pU + i), lutU);
+                XMStoreFloat4((XMFLOAT4 *)(pV + i), lutV);
+            }
+
+            for (u32 x = 0; x < batchCount * 4; x++)
+            {
+                // Padding stays black
+                XMVECTOR luminance = XMVectorZero();
+
+                if (x < width && aboveAtmosphere)
+                    luminance = RaymarchSky(atmos, *luts.pTransmittance, *luts.pMultiScatter, settings, XMVectorSet(pDirX[x], pDirY[x], pDirZ[x], 0.0f));
+                else if (x < width)
+                    luminance = luts.pSkyView->SampleWrapU(pU[x], pV[x]);
+
+                XMFLOAT4 texel;
+                XMStoreFloat4(&texel, XMVectorSetW(luminance, 1.0f));
+
+                pLumR[x] = texel.x;
+                pLumG[x] = texel.y;
+                pLumB[x] = texel.z;
+
+                if (pLuminance && x < width) pLuminance->At(x, y) = texel;
+            }
+
+            // Tone map, dither and add the sun, then pack like XMStoreUByteN4
+            u32 *pRow = &image.Pixels[y * width];
+
+            for (u32 i = 0; i < batchCount * 4; i += 4)
+            {
+                XMVECTOR seedX = (XMVectorReplicate((float)i) + laneOffset) / (float)width;
+                XMVECTOR threshold = GetDitherThreshold(seedX, seedY);
+
+                XMVECTOR r = Dither(threshold, ACES(XMLoadFloat4((XMFLOAT4 *)(pLumR + i))));
+                XMVECTOR g = Dither(threshold, ACES(XMLoadFloat4((XMFLOAT4 *)(pLumG + i))));
+                XMVECTOR b = Dither(threshold, ACES(XMLoadFloat4((XMFLOAT4 *)(pLumB + i))));
+
+                XMVECTOR sunCos = XMLoadFloat4((XMFLOAT4 *)(pDirX + i)) * sunX + XMLoadFloat4((XMFLOAT4 *)(pDirY + i)) * sunY
+                                  + XMLoadFloat4((XMFLOAT4 *)(pDirZ + i)) * sunZ;
+                XMVECTOR sun = XMVectorSelect(XMVectorZero(), sunIntensity, XMVectorGreater(sunCos, radCos));
+
+                __m128i red = _mm_cvttps_epi32(XMVectorSaturate(r + sun) * 255.0f);
+                __m128i green = _mm_cvttps_epi32(XMVectorSaturate(g + sun) * 255.0f);
+                __m128i blue = _mm_cvttps_epi32(XMVectorSaturate(b + sun) * 255.0f);
+
+                __m128i packed = _mm_or_si128(red, _mm_slli_epi32(green, 8));
+                packed = _mm_or_si128(packed, _mm_slli_epi32(blue, 16));
+                packed = _mm_or_si128(packed, _mm_set1_epi32(0xff000000));
+
+                if (i + 4 <= width)
+                {
+                    _mm_storeu_si128((__m128i *)(pRow + i), packed);
+                    continue;
+                }
+
+                alignas(16) u32 tail[4];
+                _mm_store_si128((__m128i *)tail, packed);
+                memcpy(pRow + i, tail, (width - i) * sizeof(u32));
+            }
+        }
+    }
+
+}  // namespace FinalPass
\ No newline at end of file
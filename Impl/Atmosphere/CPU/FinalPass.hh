@@ -0,0 +1,83 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Graphics/Camera3D.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+
+/// RGBA8 image, rows top to bottom
+struct ImageRGBA8
+{
+    void Resize(u32 width, u32 height);
+
+    u32 Width = 0;
+    u32 Height = 0;
+
+    eastl::vector<u32> Pixels;
+};
+
+struct FinalPassSettings
+{
+    XMFLOAT3 SunDirection = { 0, 1, 0 };
+    float SunRadius = 0.4;  // degrees
+    float SunIntensity = 10;
+
+    /// Only used above the atmosphere, where every pixel is marched
+    XMFLOAT3 EyePosition = { 0, 0, 0 };
+    u32 StepCount = 48;
+};
+
+/// Transmittance and MS are only read above the atmosphere
+struct FinalPassLUTs
+{
+    const LUT2D *pSkyView = nullptr;
+    const LUT2D *pTransmittance = nullptr;
+    const LUT2D *pMultiScatter = nullptr;
+};
+
+/// CPU port of `Atmos/Final.hlsl`, keep them in sync.
+/// ACES and dithering are lane-wise, the per-pixel functions and the 4 pixel batches of
+/// `RenderFrustumRows` share them and give bit identical results.
+namespace FinalPass
+{
+    XMVECTOR ACES(XMVECTOR color);
+
+    /// Dithers to 8 bits, `seed` is the texcoord
+    XMVECTOR FixHDR(XMFLOAT2 seed, XMVECTOR color);
+
+    /// View direction of `PSMain`, `u` and `v` are the texcoord
+    XMVECTOR GetViewDirection(const CameraFrustum &frustum, float u, float v);
+
+    XMVECTOR GetSun(const FinalPassSettings &settings, XMVECTOR rayDirection);
+
+    /// Sky-view LUT lookup of `PSMain`
+    XMVECTOR SampleSky(const LUT2D &skyViewLUT, XMVECTOR rayDirection);
+
+    /// Sky-view LUT is parameterized around an eye inside the atmosphere, above it `PSMain` marches every pixel
+    bool IsAboveAtmosphere(const Atmosphere &atmos, const FinalPassSettings &settings);
+
+    /// Per-pixel path of `PSMain`, ray enters at the top of the atmosphere. Black where it misses.
+    XMVECTOR RaymarchSky(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT, const FinalPassSettings &settings,
+                         XMVECTOR rayDirection);
+
+    /// Tone maps sky luminance and adds the sun, [0, 1]
+    XMVECTOR Resolve(const FinalPassSettings &settings, XMVECTOR luminance, XMVECTOR rayDirection, XMFLOAT2 seed);
+
+    /// Tone mapped color of a single view direction from inside the atmosphere, [0, 1]
+    XMVECTOR Shade(const LUT2D &skyViewLUT, const FinalPassSettings &settings, XMVECTOR rayDirection, XMFLOAT2 seed);
+
+    /// Equirectangular panorama, x is azimuth [0, 360) and y is elevation from +90 to -90
+    void RenderPanoramaRows(const LUT2D &skyViewLUT, const FinalPassSettings &settings, ImageRGBA8 &image, u32 begin, u32 end);
+
+    /// What the GPU pass draws for `frustum`, headless. Scanlines go in 4 pixel batches, only LUT fetches
+    /// (or marches above the atmosphere) are per pixel. LUT coordinates use DirectXMath approximations of asin/atan2,
+    /// so a few pixels can be 1 LSB off from `Shade`. `pLuminance` receives the luminance before tone mapping,
+    /// it has to be the size of `image`.
+    void RenderFrustumRows(const Atmosphere &atmos, const FinalPassLUTs &luts, const FinalPassSettings &settings, const CameraFrustum &frustum,
+                           ImageRGBA8 &image, u32 begin, u32 end, LUT2D *pLuminance = nullptr);
+
+}  // namespace FinalPass
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "ImageWriter.hh"
+
+#include <bx/endian.h>
+
+#include "LUTFormat.hh"
+
+/// Largest payload of a stored deflate block
+static constexpr u32 kMaxStoredBlockSize = 65535;
+
+/// PNG filter byte + RGBA8 pixels
+static u32 GetPNGRowSize(u32 width)
+{
+    return 1 + width * 4;
+}
+
+static u32 GetStoredBlockCount(u32 size)
+{
+    return (size + kMaxStoredBlockSize - 1) / kMaxStoredBlockSize;
+}
+
+/// Half float B, G, R planes
+static u32 GetEXRRowSize(u32 width)
+{
+    return width * 3 * sizeof(u16);
+}
+
+template<typename T>
+static void AppendLE(eastl::vector<u8> &buffer, T value)
+{
+    value = bx::toLittleEndian(value);
+    buffer.insert(buffer.end(), (u8 *)&value, (u8 *)&value + sizeof(T));
+}
+
+static void AppendString(eastl::vector<u8> &buffer, const char *pString)
+{
+    buffer.insert(buffer.end(), pString, pString + strlen(pString) + 1);
+}
+
+static void AppendAttribute(eastl::vector<u8> &buffer, const char *pName, const char *pType, u32 size)
+{
+    AppendString(buffer, pName);
+    AppendString(buffer, pType);
+    AppendLE(buffer, size);
+}
+
+ImageStreamWriter::~ImageStreamWriter()
+{
+    if (m_IsOpen) m_File.Close();
+}
+
+bool ImageStreamWriter::Begin(eastl::string_view path, ImageFileFormat format, u32 width, u32 height)
+{
+    if (m_IsOpen) m_File.Close();
+    m_IsOpen = false;
+
+    m_Path = path;
+    m_Format = format;
+    m_Width = width;
+    m_Height = height;
+    m_RowIndex = 0;
+
+    if (width == 0 || height == 0) return false;
+
+    // Whole zlib stream goes into a single IDAT, its length is a 31 bit integer
+    if (format == ImageFileFormat::PNG)
+    {
+        u32 rowSize = GetPNGRowSize(width);
+        u64 idatSize = 2 + (u64)height * (rowSize + 5 * GetStoredBlockCount(rowSize)) + 4;
+
+        if (idatSize > INT32_MAX)
+        {
+            LOG_WARN("Image {} is too large for a single IDAT ({}x{}).", m_Path, width, height);
+            return false;
+        }
+    }
+
+    // `FileStream::Reopen` would close the previous file again
+    m_File = FileStream(m_Path, true);
+    if (!m_File.IsOK())
+    {
+        LOG_WARN("Couldn't open image {} for writing.", m_Path);
+        return false;
+    }
+
+    m_IsOpen = true;
+
+    if (format == ImageFileFormat::PNG)
+        BeginPNG();
+    else
+        BeginEXR();
+
+    return true;
+}
+
+void ImageStreamWriter::BeginPNG()
+{
+    m_File.WritePtr((const u8 *)"\x89PNG\r\n\x1a\n", 8);
+
+    u8 header[17] = { 'I', 'H', 'D', 'R' };
+    *(u32 *)&header[4] = bx::toBigEndian(m_Width);
+    *(u32 *)&header[8] = bx::toBigEndian(m_Height);
+    header[12] = 8;  // bit depth
+    header[13] = 6;  // RGBA
+
+    m_CRC.begin();
+    m_CRC.add(header, sizeof(header));
+
+    WriteBE32(13);
+    m_File.WritePtr(header, sizeof(header));
+    WriteBE32(m_CRC.end());
+
+    // Every row is stored as is, so the deflate stream length only depends on the size
+    u32 rowSize = GetPNGRowSize(m_Width);
+    WriteBE32(2 + m_Height * (rowSize + 5 * GetStoredBlockCount(rowSize)) + 4);
+
+    m_CRC.begin();
+    m_Adler.begin();
+
+    WriteIDAT((const u8 *)"IDAT", 4, false);
+    WriteIDAT((const u8 *)"\x78\x01", 2, false);
+
+    m_RowBuffer.resize(rowSize);
+}
+
+void ImageStreamWriter::BeginEXR()
+{
+    eastl::vector<u8> header;
+
+    AppendLE(header, 20000630u);  // magic
+    AppendLE(header, 2u);         // version, single part scanline
+
+    // Channels have to be sorted by name, 18 bytes each + terminator
+    AppendAttribute(header, "channels", "chlist", 3 * 18 + 1);
+    for (const char *pChannel : { "B", "G", "R" })
+    {
+        AppendString(header, pChannel);
+        AppendLE(header, 1u);  // half
+        AppendLE(header, 0u);  // pLinear + reserved
+        AppendLE(header, 1u);  // x sampling
+        AppendLE(header, 1u);  // y sampling
+    }
+    header.push_back(0);
+
+    AppendAttribute(header, "compression", "compression", 1);
+    header.push_back(0);  // none
+
+    for (const char *pWindow : { "dataWindow", "displayWindow" })
+    {
+        AppendAttribute(header, pWindow, "box2i", 16);
+        AppendLE(header, 0u);
+        AppendLE(header, 0u);
+        AppendLE(header, m_Width - 1);
+        AppendLE(header, m_Height - 1);
+    }
+
+    AppendAttribute(header, "lineOrder", "lineOrder", 1);
+    header.push_back(0);  // increasing Y
+
+    AppendAttribute(header, "pixelAspectRatio", "float", 4);
+    AppendLE(header, 1.0f);
+
+    AppendAttribute(header, "screenWindowCenter", "v2f", 8);
+    AppendLE(header, 0.0f);
+    AppendLE(header, 0.0f);
+
+    AppendAttribute(header, "screenWindowWidth", "float", 4);
+    AppendLE(header, 1.0f);
+
+    header.push_back(0);
+
+    // Scanline blocks are y + size + planes, so the offset table is known up front
+    u64 blockSize = 8 + GetEXRRowSize(m_Width);
+    u64 offset = header.size() + (u64)m_Height * sizeof(u64);
+
+    for (u32 y = 0; y < m_Height; y++) AppendLE(header, offset + y * blockSize);
+
+    m_File.WritePtr(header.data(), header.size());
+
+    m_RowBuffer.resize(8 + GetEXRRowSize(m_Width));
+    m_HalfBuffer.resize(m_Width * 4);
+}
+
+void ImageStreamWriter::WriteRows(const u32 *pPixels, u32 rowCount)
+{
+    assert(m_IsOpen && m_Format == ImageFileFormat::PNG && m_RowIndex + rowCount <= m_Height);
+
+    const u32 rowSize = GetPNGRowSize(m_Width);
+
+    for (u32 i = 0; i < rowCount; i++, m_RowIndex++)
+    {
+        // No filter, pixels are already RGBA in memory
+        m_RowBuffer[0] = 0;
+        memcpy(&m_RowBuffer[1], pPixels + i * m_Width, m_Width * 4);
+
+        for (u32 offset = 0; offset < rowSize; offset += kMaxStoredBlockSize)
+        {
+            u16 size = eastl::min(rowSize - offset, kMaxStoredBlockSize);
+            bool isFinal = m_RowIndex == m_Height - 1 && offset + size == rowSize;
+
+            u8 blockHeader[5] = { isFinal };
+            *(u16 *)&blockHeader[1] = bx::toLittleEndian(size);
+            *(u16 *)&blockHeader[3] = bx::toLittleEndian((u16)~size);
+
+            WriteIDAT(blockHeader, sizeof(blockHeader), false);
+            WriteIDAT(&m_RowBuffer[offset], size, true);
+        }
+    }
+}
+
+void ImageStreamWriter::WriteRows(const XMFLOAT4 *pPixels, u32 rowCount)
+{
+    assert(m_IsOpen && m_Format == ImageFileFormat::EXR && m_RowIndex + rowCount <= m_Height);
+
+    const u32 rowSize = GetEXRRowSize(m_Width);
+    const u16 *pHalfs = m_HalfBuffer.data();
+
+    for (u32 i = 0; i < rowCount; i++, m_RowIndex++)
+    {
+        LUTFormat::Encode(pPixels + i * m_Width, (u8 *)m_HalfBuffer.data(), m_Width, TextureFormat::RGBA16F);
+
+        u8 *pBlock = m_RowBuffer.data();
+        *(u32 *)&pBlock[0] = bx::toLittleEndian(m_RowIndex);
+        *(u32 *)&pBlock[4] = bx::toLittleEndian(rowSize);
+
+        // RGBA halfs -> B, G, R planes
+        u16 *pPlanes = (u16 *)(pBlock + 8);
+        for (u32 x = 0; x < m_Width; x++)
+        {
+            pPlanes[x] = bx::toLittleEndian(pHalfs[x * 4 + 2]);
+            pPlanes[m_Width + x] = bx::toLittleEndian(pHalfs[x * 4 + 1]);
+            pPlanes[m_Width * 2 + x] = bx::toLittleEndian(pHalfs[x * 4 + 0]);
+        }
+
+        m_File.WritePtr(pBlock, 8 + rowSize);
+    }
+}
+
+bool ImageStreamWriter::End()
+{
+    if (!m_IsOpen) return false;
+
+    bool isComplete = m_RowIndex == m_Height;
+
+    if (isComplete && m_Format == ImageFileFormat::PNG)
+    {
+        u32 adler = bx::toBigEndian(m_Adler.end());
+        WriteIDAT((const u8 *)&adler, 4, false);
+        WriteBE32(m_CRC.end());
+
+        WriteBE32(0);
+        m_File.WritePtr((const u8 *)"IEND\xae\x42\x60\x82", 8);
+    }
+
+    m_File.Close();
+    m_IsOpen = false;
+
+    if (!isComplete) LOG_WARN("Image {} is incomplete, {} of {} rows were written.", m_Path, m_RowIndex, m_Height);
+
+    return isComplete;
+}
+
+void ImageStreamWriter::WriteBE32(u32 value)
+{
+    m_File.Write(bx::toBigEndian(value));
+}
+
+void ImageStreamWriter::WriteIDAT(const u8 *pData, u32 size, bool adler)
+{
+    m_CRC.add(pData, size);
+    if (adler) m_Adler.add(pData, size);
+
+    m_File.WritePtr(pData, size);
+}
+
+bool WriteImagePNG(eastl::string_view path, const ImageRGBA8 &image)
+{
+    ImageStreamWriter writer;
+    if (!writer.Begin(path, ImageFileFormat::PNG, image.Width, image.Height)) return false;
+
+    writer.WriteRows(image.Pixels.data(), image.Height);
+    return writer.End();
+}
+
+bool WriteImageEXR(eastl::string_view path, const LUT2D &image)
+{
+    ImageStreamWriter writer;
+    if (!writer.Begin(path, ImageFileFormat::EXR, image.Width, image.Height)) return false;
+
+    writer.WriteRows(image.Texels.data(), image.Height);
+    return writer.End();
+}
\ No newline at end of file
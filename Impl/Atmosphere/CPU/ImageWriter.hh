@@ -0,0 +1,73 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <bx/hash.h>
+
+#include "IO/FileStream.hh"
+
+#include "FinalPass.hh"
+#include "LUT.hh"
+
+enum class ImageFileFormat : u8
+{
+    PNG,  // RGBA8, stored (uncompressed) deflate blocks
+    EXR,  // RGB half floats, uncompressed scanlines
+};
+
+/// Writes an image a band of rows at a time, only the band being written has to be in memory.
+/// Both layouts are chosen so every length, offset and checksum is known before the pixel data,
+/// nothing is patched afterwards and a frame can go to disk while the next one is still rendering.
+/// Rows are top to bottom.
+class ImageStreamWriter
+{
+public:
+    ~ImageStreamWriter();
+
+    bool Begin(eastl::string_view path, ImageFileFormat format, u32 width, u32 height);
+
+    /// PNG only, `width * rowCount` pixels
+    void WriteRows(const u32 *pPixels, u32 rowCount);
+
+    /// EXR only, `width * rowCount` pixels. Alpha is dropped.
+    void WriteRows(const XMFLOAT4 *pPixels, u32 rowCount);
+
+    /// Fails if fewer rows than `height` were written, the file is left incomplete
+    bool End();
+
+public:
+    u32 GetWrittenRowCount()
+    {
+        return m_RowIndex;
+    }
+
+private:
+    void BeginPNG();
+    void BeginEXR();
+
+    void WriteBE32(u32 value);
+
+    /// Goes into the IDAT checksum, `adler` also into the zlib one
+    void WriteIDAT(const u8 *pData, u32 size, bool adler);
+
+    FileStream m_File;
+    bool m_IsOpen = false;
+
+    eastl::string m_Path;
+    ImageFileFormat m_Format = ImageFileFormat::PNG;
+    u32 m_Width = 0;
+    u32 m_Height = 0;
+    u32 m_RowIndex = 0;
+
+    bx::HashCrc32 m_CRC;
+    bx::HashAdler32 m_Adler;
+
+    eastl::vector<u8> m_RowBuffer;
+    eastl::vector<u16> m_HalfBuffer;
+};
+
+/// Whole image versions of `ImageStreamWriter`
+bool WriteImagePNG(eastl::string_view path, const ImageRGBA8 &image);
+bool WriteImageEXR(eastl::string_view path, const LUT2D &image);
\ No newline at end of file
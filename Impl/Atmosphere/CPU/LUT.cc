@@ -0,0 +1,106 @@
+#include "LUT.hh"
+
+void LUT2D::Resize(u32 width, u32 height)
+{
+    Width = width;
+    Height = height;
+
+    Texels.resize(width * height);
+}
+
+XMVECTOR LUT2D::Sample(float u, float v) const
+{
+    float x = u * Width - 0.5f;
+    float y = v * Height - 0.5f;
+
+    float floorX = floorf(x);
+    float floorY = floorf(y);
+
+    float fracX = x - floorX;
+    float fracY = y - floorY;
+
+    i32 x0 = bx::clamp((i32)floorX, 0, (i32)Width - 1);
+    i32 y0 = bx::clamp((i32)floorY, 0, (i32)Height - 1);
+    i32 x1 = bx::clamp((i32)floorX + 1, 0, (i32)Width - 1);
+    i32 y1 = bx::clamp((i32)floorY + 1, 0, (i32)Height - 1);
+
+    XMVECTOR top = XMVectorLerp(XMLoadFloat4(&At(x0, y0)), XMLoadFloat4(&At(x1, y0)), fracX);
+    XMVECTOR bottom = XMVectorLerp(XMLoadFloat4(&At(x0, y1)), XMLoadFloat4(&At(x1, y1)), fracX);
+
+    return XMVectorLerp(top, bottom, fracY);
+}
+
+XMVECTOR LUT2D::SampleWrapU(float u, float v) const
+{
+    float x = u * Width - 0.5f;
+    float y = v * Height - 0.5f;
+
+    float floorX = floorf(x);
+    float floorY = floorf(y);
+
+    float fracX = x - floorX;
+    float fracY = y - floorY;
+
+    i32 x0 = (i32)floorX % (i32)Width;
+    if (x0 < 0) x0 += Width;
+    i32 x1 = (x0 + 1) % (i32)Width;
+
+    i32 y0 = bx::clamp((i32)floorY, 0, (i32)Height - 1);
+    i32 y1 = bx::clamp((i32)floorY + 1, 0, (i32)Height - 1);
+
+    XMVECTOR top = XMVectorLerp(XMLoadFloat4(&At(x0, y0)), XMLoadFloat4(&At(x1, y0)), fracX);
+    XMVECTOR bottom = XMVectorLerp(XMLoadFloat4(&At(x0, y1)), XMLoadFloat4(&At(x1, y1)), fracX);
+
+    return XMVectorLerp(top, bottom, fracY);
+}
+
+void LUT3D::Resize(u32 width, u32 height, u32 depth)
+{
+    Width = width;
+    Height = height;
+    Depth = depth;
+
+    Texels.resize(width * height * depth);
+}
+
+LUTErrorReport CompareLUTs(const LUT2D &lut, const LUT2D &reference)
+{
+    LUTErrorReport report;
+
+    if (lut.Width != reference.Width || lut.Height != reference.Height)
+    {
+        LOG_ERROR("Cannot compare LUTs with different sizes ({}x{} vs {}x{}).", lut.Width, lut.Height, reference.Width, reference.Height);
+        return report;
+    }
+
+    double totalError = 0.0;
+
+    for (u32 y = 0; y < lut.Height; y++)
+    {
+        for (u32 x = 0; x < lut.Width; x++)
+        {
+            const float *pValue = &lut.At(x, y).x;
+            const float *pReference = &reference.At(x, y).x;
+
+            for (u32 c = 0; c < 3; c++)
+            {
+                float error = fabsf(pValue[c] - pReference[c]);
+                totalError += error;
+
+                if (error > report.MaxAbsError)
+                {
+                    report.MaxAbsError = error;
+                    report.WorstX = x;
+                    report.WorstY = y;
+                }
+
+                if (fabsf(pReference[c]) > LUTErrorReport::kRelativeFloor)
+                    report.MaxRelError = eastl::max(report.MaxRelError, error / fabsf(pReference[c]));
+            }
+        }
+    }
+
+    report.MeanAbsError = totalError / (lut.Texels.size() * 3);
+
+    return report;
+}
\ No newline at end of file
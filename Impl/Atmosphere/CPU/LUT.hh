@@ -0,0 +1,76 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Graphics/TextureFormat.hh"
+
+using namespace lr;
+
+/// CPU side copy of a RGBA32F LUT, layout matches what `Texture::Init` expects
+struct LUT2D
+{
+    void Resize(u32 width, u32 height);
+
+    /// Bilinear, clamped to edge. Same as `SampleLevel` with a linear clamp sampler.
+    XMVECTOR Sample(float u, float v) const;
+
+    /// Same as above but wraps around horizontally (`TextureAddress::Wrap` on U)
+    XMVECTOR SampleWrapU(float u, float v) const;
+
+    XMFLOAT4 &At(u32 x, u32 y)
+    {
+        return Texels[y * Width + x];
+    }
+
+    const XMFLOAT4 &At(u32 x, u32 y) const
+    {
+        return Texels[y * Width + x];
+    }
+
+    u32 Width = 0;
+    u32 Height = 0;
+
+    eastl::vector<XMFLOAT4> Texels;
+};
+
+/// CPU side RGBA32F volume, x is fastest then y then z (slice)
+struct LUT3D
+{
+    void Resize(u32 width, u32 height, u32 depth);
+
+    XMFLOAT4 &At(u32 x, u32 y, u32 z)
+    {
+        return Texels[(z * Height + y) * Width + x];
+    }
+
+    const XMFLOAT4 &At(u32 x, u32 y, u32 z) const
+    {
+        return Texels[(z * Height + y) * Width + x];
+    }
+
+    u32 Width = 0;
+    u32 Height = 0;
+    u32 Depth = 0;
+
+    eastl::vector<XMFLOAT4> Texels;
+};
+
+/// RGB error of a LUT against a reference bake
+struct LUTErrorReport
+{
+    float MaxAbsError = 0.0f;
+    float MeanAbsError = 0.0f;
+
+    /// Only counts reference texels above `kRelativeFloor`, relative error of near black texels is noise
+    float MaxRelError = 0.0f;
+    static constexpr float kRelativeFloor = 1e-4f;
+
+    /// Texel with `MaxAbsError`
+    u32 WorstX = 0;
+    u32 WorstY = 0;
+};
+
+/// Sizes have to match
+LUTErrorReport CompareLUTs(const LUT2D &lut, const LUT2D &reference);
\ No newline at end of file
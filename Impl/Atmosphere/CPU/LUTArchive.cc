@@ -0,0 +1,169 @@
+#include "LUTArchive.hh"
+
+#include "IO/FileStream.hh"
+
+#include <filesystem>
+
+static constexpr u64 kDataAlignment = 16;
+
+void LUTArchiveWriter::Add(eastl::string_view name, LUTStage stage, const LUT2D &lut, TextureFormat format)
+{
+    LUTArchiveEntry &entry = m_Entries.emplace_back();
+
+    if (name.size() >= LUTArchiveEntry::kMaxNameLen)
+        LOG_WARN("LUT archive entry name '{}' is too long, it will be truncated.", eastl::string(name));
+
+    u32 nameLen = eastl::min<u32>(name.size(), LUTArchiveEntry::kMaxNameLen - 1);
+    memcpy(entry.Name, name.data(), nameLen);
+
+    entry.Stage = stage;
+    entry.Width = lut.Width;
+    entry.Height = lut.Height;
+    entry.Format = (u32)format;
+    entry.DataSize = lut.Texels.size() * TextureFormatToSize(format);
+
+    m_LUTs.push_back(&lut);
+}
+
+bool LUTArchiveWriter::Write(eastl::string_view path)
+{
+    LUTArchive::Header header;
+    header.EntryCount = m_Entries.size();
+
+    u64 offset = sizeof(LUTArchive::Header) + m_Entries.size() * sizeof(LUTArchiveEntry);
+    for (LUTArchiveEntry &entry : m_Entries)
+    {
+        offset = (offset + kDataAlignment - 1) & ~(kDataAlignment - 1);
+        entry.Offset = offset;
+        offset += entry.DataSize;
+    }
+
+    // Same as `LUTCache`, write next to the archive and rename
+    eastl::string tempPath = eastl::string(path) + ".tmp";
+
+    FileStream file(tempPath, true);
+    if (!file.IsOK())
+    {
+        LOG_WARN("Couldn't open LUT archive {} for writing.", tempPath);
+        return false;
+    }
+
+    file.Write(header);
+    file.WritePtr((u8 *)m_Entries.data(), m_Entries.size() * sizeof(LUTArchiveEntry));
+
+    u64 position = sizeof(LUTArchive::Header) + m_Entries.size() * sizeof(LUTArchiveEntry);
+    const u8 kZeros[kDataAlignment] = {};
+    eastl::vector<u8> encoded;
+
+    for (u32 i = 0; i < m_Entries.size(); i++)
+    {
+        const LUTArchiveEntry &entry = m_Entries[i];
+        const LUT2D &lut = *m_LUTs[i];
+
+        encoded.resize(entry.DataSize);
+        LUTFormat::Encode(lut.Texels.data(), encoded.data(), lut.Texels.size(), (TextureFormat)entry.Format);
+
+        if (entry.Offset > position) file.WritePtr(kZeros, entry.Offset - position);
+        file.WritePtr(encoded.data(), entry.DataSize);
+
+        position = entry.Offset + entry.DataSize;
+    }
+
+    file.Close();
+
+    std::error_code error;
+    std::filesystem::rename(tempPath.c_str(), eastl::string(path).c_str(), error);
+
+    if (error)
+    {
+        LOG_WARN("Couldn't write LUT archive {}.", eastl::string(path));
+        return false;
+    }
+
+    return true;
+}
+
+bool LUTArchive::Open(eastl::string_view path)
+{
+    Close();
+
+    if (!m_File.Open(path)) return false;
+
+    const Header *pHeader = (const Header *)m_File.GetData();
+    if (m_File.GetSize() < sizeof(Header) || pHeader->Magic != Header::kMagic || pHeader->Version != Header::kVersion)
+    {
+        LOG_WARN("{} is not a LUT archive.", eastl::string(path));
+        Close();
+        return false;
+    }
+
+    u64 tableEnd = sizeof(Header) + (u64)pHeader->EntryCount * sizeof(LUTArchiveEntry);
+    if (m_File.GetSize() < tableEnd)
+    {
+        LOG_WARN("LUT archive {} is truncated.", eastl::string(path));
+        Close();
+        return false;
+    }
+
+    m_pEntries = (const LUTArchiveEntry *)(pHeader + 1);
+    m_EntryCount = pHeader->EntryCount;
+
+    for (u32 i = 0; i < m_EntryCount; i++)
+    {
+        const LUTArchiveEntry &entry = m_pEntries[i];
+        TextureFormat format = (TextureFormat)entry.Format;
+
+        if (!LUTFormat::IsSupported(format) || entry.Offset + entry.DataSize > m_File.GetSize()
+            || entry.DataSize != (u64)entry.Width * entry.Height * TextureFormatToSize(format))
+        {
+            LOG_WARN("LUT archive {} has a broken entry '{}'.", eastl::string(path), entry.Name);
+            Close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void LUTArchive::Close()
+{
+    m_File.Close();
+
+    m_pEntries = nullptr;
+    m_EntryCount = 0;
+}
+
+const LUTArchiveEntry *LUTArchive::Find(eastl::string_view name, LUTStage stage) const
+{
+    for (u32 i = 0; i < m_EntryCount; i++)
+    {
+        const LUTArchiveEntry &entry = m_pEntries[i];
+        if (entry.Stage == stage && name == entry.Name) return &entry;
+    }
+
+    return nullptr;
+}
+
+bool LUTArchive::Load(eastl::string_view name, LUTStage stage, LUT2D &lut) const
+{
+    const LUTArchiveEntry *pEntry = Find(name, stage);
+    if (!pEntry) return false;
+
+    lut.Resize(pEntry->Width, pEntry->Height);
+    LUTFormat::Decode(GetData(*pEntry), lut.Texels.data(), lut.Texels.size(), (TextureFormat)pEntry->Format);
+
+    return true;
+}
+
+bool LUTArchive::Load(eastl::string_view name, LUTStage stage, PackedLUT2D &lut) const
+{
+    const LUTArchiveEntry *pEntry = Find(name, stage);
+    if (!pEntry) return false;
+
+    lut.Width = pEntry->Width;
+    lut.Height = pEntry->Height;
+    lut.Format = (TextureFormat)pEntry->Format;
+    lut.Data.assign(GetData(*pEntry), GetData(*pEntry) + pEntry->DataSize);
+
+    return true;
+}
\ No newline at end of file
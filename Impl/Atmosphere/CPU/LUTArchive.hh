@@ -0,0 +1,95 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "IO/MappedFile.hh"
+
+#include "LUTFormat.hh"
+#include "LUTGraph.hh"
+
+/// Entry of a LUT pack, LUTs are found by preset name + stage.
+/// Layout: Header | LUTArchiveEntry[EntryCount] | texels (every blob is 16 byte aligned)
+struct LUTArchiveEntry
+{
+    static constexpr u32 kMaxNameLen = 64;
+
+    char Name[kMaxNameLen] = {};  // null terminated
+    LUTStage Stage = LUTStage::Count;
+    u8 _padding[3] = {};
+
+    u32 Width = 0;
+    u32 Height = 0;
+    u32 Format = 0;  // TextureFormat, one of `LUTFormat`
+
+    u64 Offset = 0;  // from start of the file
+    u64 DataSize = 0;
+};
+
+/// Writes every added LUT into a single file, entries are written in the order they are added
+class LUTArchiveWriter
+{
+public:
+    /// `lut` is not copied, it has to be alive until `Write`. It's encoded into `format` while writing.
+    void Add(eastl::string_view name, LUTStage stage, const LUT2D &lut, TextureFormat format = TextureFormat::RGBA32F);
+
+    bool Write(eastl::string_view path);
+
+private:
+    eastl::vector<LUTArchiveEntry> m_Entries;
+    eastl::vector<const LUT2D *> m_LUTs;
+};
+
+/// Read-only view of a LUT pack, texels are read straight from the mapping
+class LUTArchive
+{
+public:
+    bool Open(eastl::string_view path);
+    void Close();
+
+    /// Returns null if there is no such entry
+    const LUTArchiveEntry *Find(eastl::string_view name, LUTStage stage) const;
+
+    /// Decodes the texels into `lut`, returns false on miss
+    bool Load(eastl::string_view name, LUTStage stage, LUT2D &lut) const;
+
+    /// Copies the texels as they are stored, for uploading without decoding
+    bool Load(eastl::string_view name, LUTStage stage, PackedLUT2D &lut) const;
+
+    /// Texels in `entry.Format`
+    const u8 *GetData(const LUTArchiveEntry &entry) const
+    {
+        return m_File.GetData() + entry.Offset;
+    }
+
+public:
+    u32 GetEntryCount() const
+    {
+        return m_EntryCount;
+    }
+
+    const LUTArchiveEntry &GetEntry(u32 index) const
+    {
+        return m_pEntries[index];
+    }
+
+private:
+    struct Header
+    {
+        static constexpr u32 kMagic = 0x4154554c;  // LUTA
+        static constexpr u32 kVersion = 1;
+
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 EntryCount = 0;
+        u32 _padding = 0;
+    };
+
+    friend class LUTArchiveWriter;
+
+    MappedFile m_File;
+
+    const LUTArchiveEntry *m_pEntries = nullptr;
+    u32 m_EntryCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,430 @@
+#include "LUTFormat.hh"
+
+#include <emmintrin.h>
+
+/// Unsigned floats with a 5 bit exponent (bias 15) and `kMantissaBits` of mantissa. Half floats are the
+/// same thing with a sign bit on top, float11 has 6 bits of mantissa and float10 5.
+///
+/// Normals are rebiased and rounded to nearest even on the integer bits, denormals (below 2^-14) are
+/// rounded by the FPU by adding a magic number whose ULP is the denormal step of the format.
+
+static constexpr u32 kMinNormalBits = 0x38800000;  // 2^-14
+static constexpr u32 kRebias = 112 << 23;          // 127 - 15
+static constexpr u32 kHalfMantissaBits = 10;
+
+static constexpr float kMaxRGB9E5 = 65408.0f;        // (511 / 512) * 2^16
+static constexpr float kMinRGB9E5 = 1.0f / 65536.0f;  // 2^-16, exponent 0
+
+static float AsFloat(u32 bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+static u32 AsUint(float value)
+{
+    u32 bits;
+    memcpy(&bits, &value, sizeof(u32));
+    return bits;
+}
+
+/// 2^15 * (2 - 2^-M), all exponent bits but the last one and full mantissa
+static constexpr u32 GetSmallFloatMaxBits(u32 mantissaBits)
+{
+    return (142u << 23) | (((1u << mantissaBits) - 1) << (23 - mantissaBits));
+}
+
+static u32 EncodeSmallFloat(float value, u32 mantissaBits)
+{
+    const u32 shift = 23 - mantissaBits;
+
+    // Negatives and NaNs become 0
+    value = value > 0.0f ? eastl::min(value, AsFloat(GetSmallFloatMaxBits(mantissaBits))) : 0.0f;
+    u32 bits = AsUint(value);
+
+    if (bits < kMinNormalBits)
+    {
+        float magic = AsFloat((136 - mantissaBits) << 23);
+        return AsUint(value + magic) - AsUint(magic);
+    }
+
+    bits -= kRebias;
+    bits += ((1 << (shift - 1)) - 1) + ((bits >> shift) & 1);
+
+    return bits >> shift;
+}
+
+static float DecodeSmallFloat(u32 value, u32 mantissaBits)
+{
+    // Scaling by 2^112 rebiases normals and denormals alike
+    return AsFloat(value << (23 - mantissaBits)) * AsFloat(239 << 23);
+}
+
+static u16 EncodeHalf(float value)
+{
+    if (value != value) value = 0.0f;
+
+    u32 sign = AsUint(value) & 0x80000000;
+    return (sign >> 16) | EncodeSmallFloat(fabsf(value), kHalfMantissaBits);
+}
+
+static float DecodeHalf(u16 value)
+{
+    float magnitude = DecodeSmallFloat(value & 0x7fff, kHalfMantissaBits);
+    return AsFloat(AsUint(magnitude) | ((u32)(value & 0x8000) << 16));
+}
+
+/// Same as `XMStoreFloat3SE`
+static u32 EncodeTexelRGB9E5(const XMFLOAT4 &texel)
+{
+    float r = texel.x >= 0.0f ? eastl::min(texel.x, kMaxRGB9E5) : 0.0f;
+    float g = texel.y >= 0.0f ? eastl::min(texel.y, kMaxRGB9E5) : 0.0f;
+    float b = texel.z >= 0.0f ? eastl::min(texel.z, kMaxRGB9E5) : 0.0f;
+
+    float maxColor = eastl::max(eastl::max(eastl::max(r, g), b), kMinRGB9E5);
+
+    // Round up so the largest channel still fits 9 bits after its own rounding
+    u32 exponent = (AsUint(maxColor) + 0x4000) >> 23;
+    float scale = AsFloat(0x83000000 - (exponent << 23));
+
+    u32 rm = (u32)nearbyintf(r * scale);
+    u32 gm = (u32)nearbyintf(g * scale);
+    u32 bm = (u32)nearbyintf(b * scale);
+
+    return rm | (gm << 9) | (bm << 18) | ((exponent - 0x6f) << 27);
+}
+
+static XMFLOAT4 DecodeTexelRGB9E5(u32 value)
+{
+    float scale = AsFloat(0x33800000 + ((value >> 27) << 23));
+
+    return XMFLOAT4((value & 0x1ff) * scale, ((value >> 9) & 0x1ff) * scale, ((value >> 18) & 0x1ff) * scale, 1.0f);
+}
+
+/// `value` has to be clamped already
+template<u32 kMantissaBits>
+static __m128i EncodeSmallFloat4(__m128 value)
+{
+    constexpr u32 kShift = 23 - kMantissaBits;
+
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((136 - kMantissaBits) << 23));
+    __m128i bits = _mm_castps_si128(value);
+
+    __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(value, magic)), _mm_castps_si128(magic));
+
+    __m128i normal = _mm_sub_epi32(bits, _mm_set1_epi32(kRebias));
+    __m128i odd = _mm_and_si128(_mm_srli_epi32(normal, kShift), _mm_set1_epi32(1));
+    normal = _mm_add_epi32(normal, _mm_set1_epi32((1 << (kShift - 1)) - 1));
+    normal = _mm_srli_epi32(_mm_add_epi32(normal, odd), kShift);
+
+    // Sign bit is always clear, signed compare is fine
+    __m128i isDenormal = _mm_cmplt_epi32(bits, _mm_set1_epi32(kMinNormalBits));
+
+    return _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+}
+
+template<u32 kMantissaBits>
+static __m128 DecodeSmallFloat4(__m128i value)
+{
+    __m128 magnitude = _mm_castsi128_ps(_mm_slli_epi32(value, 23 - kMantissaBits));
+    return _mm_mul_ps(magnitude, _mm_castsi128_ps(_mm_set1_epi32(239 << 23)));
+}
+
+/// Negatives and NaNs become 0, `_mm_max_ps` returns the second operand if either is NaN
+static __m128 ClampUnsigned4(__m128 value, float maxValue)
+{
+    return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(maxValue));
+}
+
+static __m128i EncodeHalf4(__m128 value)
+{
+    value = _mm_and_ps(value, _mm_cmpord_ps(value, value));
+
+    __m128 sign = _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000)));
+    __m128 magnitude = _mm_min_ps(_mm_xor_ps(value, sign), _mm_set1_ps(AsFloat(GetSmallFloatMaxBits(kHalfMantissaBits))));
+
+    __m128i half = EncodeSmallFloat4<kHalfMantissaBits>(magnitude);
+    half = _mm_or_si128(half, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+
+    // Sign extend so `_mm_packs_epi32` doesn't saturate
+    return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+}
+
+static __m128 DecodeHalf4(__m128i value)
+{
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x8000)), 16);
+    __m128 magnitude = DecodeSmallFloat4<kHalfMantissaBits>(_mm_and_si128(value, _mm_set1_epi32(0x7fff)));
+
+    return _mm_or_ps(magnitude, _mm_castsi128_ps(sign));
+}
+
+static void EncodeRGBA16F(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count)
+{
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i first = EncodeHalf4(_mm_loadu_ps(&pTexels[i].x));
+        __m128i second = EncodeHalf4(_mm_loadu_ps(&pTexels[i + 1].x));
+
+        _mm_storeu_si128((__m128i *)(pOutput + i * 8), _mm_packs_epi32(first, second));
+    }
+
+    LUTFormat::EncodeScalar(pTexels + i, pOutput + i * 8, count - i, TextureFormat::RGBA16F);
+}
+
+static void DecodeRGBA16F(const u8 *pData, XMFLOAT4 *pTexels, u32 count)
+{
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128i packed = _mm_loadu_si128((const __m128i *)(pData + i * 8));
+
+        _mm_storeu_ps(&pTexels[i].x, DecodeHalf4(_mm_unpacklo_epi16(packed, _mm_setzero_si128())));
+        _mm_storeu_ps(&pTexels[i + 1].x, DecodeHalf4(_mm_unpackhi_epi16(packed, _mm_setzero_si128())));
+    }
+
+    LUTFormat::DecodeScalar(pData + i * 8, pTexels + i, count - i, TextureFormat::RGBA16F);
+}
+
+static void EncodeR11G11B10F(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count)
+{
+    const float kMax6 = AsFloat(GetSmallFloatMaxBits(6));
+    const float kMax5 = AsFloat(GetSmallFloatMaxBits(5));
+
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 r = _mm_loadu_ps(&pTexels[i].x);
+        __m128 g = _mm_loadu_ps(&pTexels[i + 1].x);
+        __m128 b = _mm_loadu_ps(&pTexels[i + 2].x);
+        __m128 a = _mm_loadu_ps(&pTexels[i + 3].x);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        __m128i packed = EncodeSmallFloat4<6>(ClampUnsigned4(r, kMax6));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(EncodeSmallFloat4<6>(ClampUnsigned4(g, kMax6)), 11));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(EncodeSmallFloat4<5>(ClampUnsigned4(b, kMax5)), 22));
+
+        _mm_storeu_si128((__m128i *)(pOutput + i * 4), packed);
+    }
+
+    LUTFormat::EncodeScalar(pTexels + i, pOutput + i * 4, count - i, TextureFormat::R11G11B10F);
+}
+
+static void DecodeR11G11B10F(const u8 *pData, XMFLOAT4 *pTexels, u32 count)
+{
+    const __m128i mask11 = _mm_set1_epi32(0x7ff);
+
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i packed = _mm_loadu_si128((const __m128i *)(pData + i * 4));
+
+        __m128 r = DecodeSmallFloat4<6>(_mm_and_si128(packed, mask11));
+        __m128 g = DecodeSmallFloat4<6>(_mm_and_si128(_mm_srli_epi32(packed, 11), mask11));
+        __m128 b = DecodeSmallFloat4<5>(_mm_srli_epi32(packed, 22));
+        __m128 a = _mm_set1_ps(1.0f);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        _mm_storeu_ps(&pTexels[i].x, r);
+        _mm_storeu_ps(&pTexels[i + 1].x, g);
+        _mm_storeu_ps(&pTexels[i + 2].x, b);
+        _mm_storeu_ps(&pTexels[i + 3].x, a);
+    }
+
+    LUTFormat::DecodeScalar(pData + i * 4, pTexels + i, count - i, TextureFormat::R11G11B10F);
+}
+
+static void EncodeRGB9E5(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count)
+{
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 r = _mm_loadu_ps(&pTexels[i].x);
+        __m128 g = _mm_loadu_ps(&pTexels[i + 1].x);
+        __m128 b = _mm_loadu_ps(&pTexels[i + 2].x);
+        __m128 a = _mm_loadu_ps(&pTexels[i + 3].x);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        r = ClampUnsigned4(r, kMaxRGB9E5);
+        g = ClampUnsigned4(g, kMaxRGB9E5);
+        b = ClampUnsigned4(b, kMaxRGB9E5);
+
+        __m128 maxColor = _mm_max_ps(_mm_max_ps(_mm_max_ps(r, g), b), _mm_set1_ps(kMinRGB9E5));
+
+        __m128i exponent = _mm_srli_epi32(_mm_add_epi32(_mm_castps_si128(maxColor), _mm_set1_epi32(0x4000)), 23);
+        __m128 scale = _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32((int)0x83000000), _mm_slli_epi32(exponent, 23)));
+
+        // Default MXCSR rounding is nearest even, same as `nearbyintf`
+        __m128i packed = _mm_cvtps_epi32(_mm_mul_ps(r, scale));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(g, scale)), 9));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(b, scale)), 18));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_sub_epi32(exponent, _mm_set1_epi32(0x6f)), 27));
+
+        _mm_storeu_si128((__m128i *)(pOutput + i * 4), packed);
+    }
+
+    LUTFormat::EncodeScalar(pTexels + i, pOutput + i * 4, count - i, TextureFormat::RGB9E5);
+}
+
+static void DecodeRGB9E5(const u8 *pData, XMFLOAT4 *pTexels, u32 count)
+{
+    const __m128i mask9 = _mm_set1_epi32(0x1ff);
+
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i packed = _mm_loadu_si128((const __m128i *)(pData + i * 4));
+
+        __m128i exponent = _mm_slli_epi32(_mm_srli_epi32(packed, 27), 23);
+        __m128 scale = _mm_castsi128_ps(_mm_add_epi32(_mm_set1_epi32(0x33800000), exponent));
+
+        __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask9)), scale);
+        __m128 g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 9), mask9)), scale);
+        __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 18), mask9)), scale);
+        __m128 a = _mm_set1_ps(1.0f);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        _mm_storeu_ps(&pTexels[i].x, r);
+        _mm_storeu_ps(&pTexels[i + 1].x, g);
+        _mm_storeu_ps(&pTexels[i + 2].x, b);
+        _mm_storeu_ps(&pTexels[i + 3].x, a);
+    }
+
+    LUTFormat::DecodeScalar(pData + i * 4, pTexels + i, count - i, TextureFormat::RGB9E5);
+}
+
+namespace LUTFormat
+{
+    bool IsSupported(TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA32F:
+            case TextureFormat::RGBA16F:
+            case TextureFormat::R11G11B10F:
+            case TextureFormat::RGB9E5: return true;
+            default: return false;
+        }
+    }
+
+    void Encode(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count, TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA32F: memcpy(pOutput, pTexels, count * sizeof(XMFLOAT4)); break;
+            case TextureFormat::RGBA16F: EncodeRGBA16F(pTexels, pOutput, count); break;
+            case TextureFormat::R11G11B10F: EncodeR11G11B10F(pTexels, pOutput, count); break;
+            case TextureFormat::RGB9E5: EncodeRGB9E5(pTexels, pOutput, count); break;
+            default: LOG_ERROR("Texture format {} is not a LUT storage format.", (u32)format); break;
+        }
+    }
+
+    void Decode(const u8 *pData, XMFLOAT4 *pTexels, u32 count, TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA32F: memcpy(pTexels, pData, count * sizeof(XMFLOAT4)); break;
+            case TextureFormat::RGBA16F: DecodeRGBA16F(pData, pTexels, count); break;
+            case TextureFormat::R11G11B10F: DecodeR11G11B10F(pData, pTexels, count); break;
+            case TextureFormat::RGB9E5: DecodeRGB9E5(pData, pTexels, count); break;
+            default: LOG_ERROR("Texture format {} is not a LUT storage format.", (u32)format); break;
+        }
+    }
+
+    void EncodeScalar(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count, TextureFormat format)
+    {
+        for (u32 i = 0; i < count; i++)
+        {
+            const XMFLOAT4 &texel = pTexels[i];
+
+            switch (format)
+            {
+                case TextureFormat::RGBA32F: memcpy(pOutput + i * 16, &texel, sizeof(XMFLOAT4)); break;
+                case TextureFormat::RGBA16F:
+                {
+                    u16 half[4] = { EncodeHalf(texel.x), EncodeHalf(texel.y), EncodeHalf(texel.z), EncodeHalf(texel.w) };
+                    memcpy(pOutput + i * 8, half, sizeof(half));
+                    break;
+                }
+                case TextureFormat::R11G11B10F:
+                {
+                    u32 packed = EncodeSmallFloat(texel.x, 6) | (EncodeSmallFloat(texel.y, 6) << 11) | (EncodeSmallFloat(texel.z, 5) << 22);
+                    memcpy(pOutput + i * 4, &packed, sizeof(u32));
+                    break;
+                }
+                case TextureFormat::RGB9E5:
+                {
+                    u32 packed = EncodeTexelRGB9E5(texel);
+                    memcpy(pOutput + i * 4, &packed, sizeof(u32));
+                    break;
+                }
+                default: LOG_ERROR("Texture format {} is not a LUT storage format.", (u32)format); return;
+            }
+        }
+    }
+
+    void DecodeScalar(const u8 *pData, XMFLOAT4 *pTexels, u32 count, TextureFormat format)
+    {
+        for (u32 i = 0; i < count; i++)
+        {
+            XMFLOAT4 &texel = pTexels[i];
+
+            switch (format)
+            {
+                case TextureFormat::RGBA32F: memcpy(&texel, pData + i * 16, sizeof(XMFLOAT4)); break;
+                case TextureFormat::RGBA16F:
+                {
+                    u16 half[4];
+                    memcpy(half, pData + i * 8, sizeof(half));
+                    texel = XMFLOAT4(DecodeHalf(half[0]), DecodeHalf(half[1]), DecodeHalf(half[2]), DecodeHalf(half[3]));
+                    break;
+                }
+                case TextureFormat::R11G11B10F:
+                {
+                    u32 packed;
+                    memcpy(&packed, pData + i * 4, sizeof(u32));
+                    texel = XMFLOAT4(DecodeSmallFloat(packed & 0x7ff, 6), DecodeSmallFloat((packed >> 11) & 0x7ff, 6),
+                                     DecodeSmallFloat(packed >> 22, 5), 1.0f);
+                    break;
+                }
+                case TextureFormat::RGB9E5:
+                {
+                    u32 packed;
+                    memcpy(&packed, pData + i * 4, sizeof(u32));
+                    texel = DecodeTexelRGB9E5(packed);
+                    break;
+                }
+                default: LOG_ERROR("Texture format {} is not a LUT storage format.", (u32)format); return;
+            }
+        }
+    }
+
+    LUTErrorReport GetPrecisionLoss(const LUT2D &lut, TextureFormat format)
+    {
+        PackedLUT2D packed;
+        packed.Pack(lut, format);
+
+        LUT2D decoded;
+        packed.Unpack(decoded);
+
+        return CompareLUTs(decoded, lut);
+    }
+
+}  // namespace LUTFormat
+
+void PackedLUT2D::Pack(const LUT2D &lut, TextureFormat format)
+{
+    Width = lut.Width;
+    Height = lut.Height;
+    Format = format;
+
+    Data.resize(lut.Texels.size() * TextureFormatToSize(format));
+    LUTFormat::Encode(lut.Texels.data(), Data.data(), lut.Texels.size(), format);
+}
+
+void PackedLUT2D::Unpack(LUT2D &lut) const
+{
+    lut.Resize(Width, Height);
+    LUTFormat::Decode(Data.data(), lut.Texels.data(), lut.Texels.size(), Format);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "LUT.hh"
+
+/// Compact storage formats for baked LUTs, alpha of a LUT is always 1 so it's dropped where the format allows.
+///   RGBA16F:    8 bytes, half floats
+///   R11G11B10F: 4 bytes, unsigned 5 bit exponent floats with 6/6/5 bit mantissas
+///   RGB9E5:     4 bytes, 9 bit mantissas with a shared 5 bit exponent
+/// Encoders round to nearest even and clamp to the largest finite value of the format,
+/// NaNs become 0 and so do negatives in unsigned formats. Decoded alpha is always 1.
+namespace LUTFormat
+{
+    /// RGBA32F and the formats above
+    bool IsSupported(TextureFormat format);
+
+    /// `pOutput` has to hold `count * TextureFormatToSize(format)` bytes. SSE2, 4 texels per iteration.
+    void Encode(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count, TextureFormat format);
+    void Decode(const u8 *pData, XMFLOAT4 *pTexels, u32 count, TextureFormat format);
+
+    /// One texel at a time, reference for the SIMD versions and used for the tails
+    void EncodeScalar(const XMFLOAT4 *pTexels, u8 *pOutput, u32 count, TextureFormat format);
+    void DecodeScalar(const u8 *pData, XMFLOAT4 *pTexels, u32 count, TextureFormat format);
+
+    /// Round trips `lut` through `format`, `CompareLUTs` of the result against the original
+    LUTErrorReport GetPrecisionLoss(const LUT2D &lut, TextureFormat format);
+
+}  // namespace LUTFormat
+
+/// LUT2D encoded into one of the `LUTFormat` formats, what gets uploaded or stored
+struct PackedLUT2D
+{
+    void Pack(const LUT2D &lut, TextureFormat format);
+    void Unpack(LUT2D &lut) const;
+
+    u32 Width = 0;
+    u32 Height = 0;
+    TextureFormat Format = TextureFormat::RGBA32F;
+
+    eastl::vector<u8> Data;
+};
\ No newline at end of file
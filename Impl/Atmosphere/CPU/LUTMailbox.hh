@@ -0,0 +1,62 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+/// Lock-free single producer/single consumer handoff of the latest value (triple buffering).
+/// Producer fills `GetWriteBuffer` and `Publish`es it, consumer `Poll`s and reads `GetReadBuffer`.
+/// Neither side ever waits: a value the consumer didn't pick up in time is replaced by the next one,
+/// and buffers are only swapped, never copied.
+template<typename T>
+class LUTMailbox
+{
+public:
+    /// Producer only
+    T &GetWriteBuffer()
+    {
+        return m_Buffers[m_WriteIndex];
+    }
+
+    /// Producer only, hands the write buffer over and takes the spare one
+    void Publish()
+    {
+        u32 previous = m_Spare.exchange(m_WriteIndex | kFreshBit, eastl::memory_order_acq_rel);
+        m_WriteIndex = previous & kIndexMask;
+    }
+
+    /// Consumer only, returns true if a new value was published since the last `Poll`
+    bool Poll()
+    {
+        if (!(m_Spare.load(eastl::memory_order_relaxed) & kFreshBit)) return false;
+
+        u32 previous = m_Spare.exchange(m_ReadIndex, eastl::memory_order_acq_rel);
+        m_ReadIndex = previous & kIndexMask;
+
+        return true;
+    }
+
+    /// Consumer only, valid until the next `Poll` that returns true
+    T &GetReadBuffer()
+    {
+        return m_Buffers[m_ReadIndex];
+    }
+
+    /// Any thread, sizes buffers and such. Has to happen before both sides start.
+    template<typename Func>
+    void ForEachBuffer(Func func)
+    {
+        for (T &buffer : m_Buffers) func(buffer);
+    }
+
+private:
+    static constexpr u32 kIndexMask = 3;
+    static constexpr u32 kFreshBit = 4;
+
+    T m_Buffers[3];
+
+    /// Sides are on different cache lines, only `m_Spare` is shared
+    alignas(64) u32 m_WriteIndex = 0;
+    alignas(64) eastl::atomic<u32> m_Spare = 1;
+    alignas(64) u32 m_ReadIndex = 2;
+};
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "LUTUpdateScheduler.hh"
+
+#include "Utils/Timer.hh"
+
+/// Weight of a new measurement in the running average, low enough to ride out a preempted slice
+constexpr float kCostSmoothing = 0.25f;
+
+/// Share of the remaining budget one batch of a measured stage may be predicted to take
+constexpr float kBatchShare = 0.25f;
+
+/// Worst slice cost decays by this per batch, so a single preempted slice doesn't shrink batches for good
+constexpr float kWorstCostDecay = 0.95f;
+
+void LUTUpdateScheduler::Begin(LUTUpdateStage *const *ppStages, u32 stageCount)
+{
+    assert(stageCount <= kMaxStages);
+
+    m_Stages.assign(ppStages, ppStages + stageCount);
+
+    m_StageIndex = 0;
+    m_SliceIndex = 0;
+    m_FrameCount = 0;
+}
+
+bool LUTUpdateScheduler::Update(float budgetUS)
+{
+    m_LastUpdateUS = 0.0f;
+    if (!IsBusy()) return false;
+
+    m_FrameCount++;
+
+    lr::Timer timer;
+    float estimatedUS = 0.0f;  // unmeasured stages count with their estimate
+    bool ranSlice = false;
+
+    while (IsBusy())
+    {
+        LUTUpdateStage &stage = *m_Stages[m_StageIndex];
+
+        if (m_SliceIndex < stage.SliceCount)
+        {
+            float cost = eastl::max(stage.MeasureCost ? eastl::max(stage.SliceCostUS, stage.WorstSliceCostUS) : stage.SliceCostUS, 1e-3f);
+            float freeUS = eastl::max(budgetUS - (float)(timer.elapsed() * 1e6) - estimatedUS, 0.0f);
+
+            bool calibrating = stage.MeasureCost && stage.SliceCostUS <= 0.0f;
+
+            // Measured stages only take a share of what's left, the timer is checked again before the next batch
+            float batchUS = stage.MeasureCost ? freeUS * kBatchShare : freeUS;
+
+            u32 batch = calibrating ? 1 : (u32)eastl::min(batchUS / cost, (float)(stage.SliceCount - m_SliceIndex));
+            if (batch == 0)
+            {
+                if (ranSlice && freeUS < cost) break;
+                batch = 1;
+            }
+
+            double batchBegin = timer.elapsed();
+            stage.Run(m_SliceIndex, m_SliceIndex + batch);
+
+            if (stage.MeasureCost)
+            {
+                float sliceUS = (float)((timer.elapsed() - batchBegin) * 1e6) / batch;
+                // Slices below the timer resolution would keep the stage calibrating, which ignores the budget
+                sliceUS = eastl::max(sliceUS, 1e-3f);
+                stage.SliceCostUS = calibrating ? sliceUS : stage.SliceCostUS + (sliceUS - stage.SliceCostUS) * kCostSmoothing;
+                stage.WorstSliceCostUS = eastl::max(sliceUS, stage.WorstSliceCostUS * kWorstCostDecay);
+            }
+            else
+            {
+                estimatedUS += batch * cost;
+            }
+
+            ranSlice = true;
+            m_SliceIndex += batch;
+            if (m_SliceIndex < stage.SliceCount) continue;
+        }
+
+        if (stage.Finish) stage.Finish();
+
+        m_StageIndex++;
+        m_SliceIndex = 0;
+    }
+
+    m_LastUpdateUS = (float)(timer.elapsed() * 1e6) + estimatedUS;
+    if (IsBusy()) return false;
+
+    m_LastFrameCount = m_FrameCount;
+    return true;
+}
+
+void LUTUpdateScheduler::Flush()
+{
+    while (IsBusy()) Update(FLT_MAX);
+}
+
+float LUTUpdateScheduler::GetProgress()
+{
+    if (!IsBusy()) return 1.0f;
+
+    u32 total = 0;
+    u32 done = m_SliceIndex;
+    for (u32 i = 0; i < m_Stages.size(); i++)
+    {
+        total += m_Stages[i]->SliceCount;
+        if (i < m_StageIndex) done += m_Stages[i]->SliceCount;
+    }
+
+    return total ? (float)done / total : 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <EASTL/fixed_vector.h>
+#include <EASTL/functional.h>
+
+/// One pass of an amortized update, split into `SliceCount` equally sized pieces (rows, tiles, texels)
+struct LUTUpdateStage
+{
+    /// Runs slices [begin, end), consecutive slices are batched into one call when they fit the budget
+    using SliceFunc = eastl::function<void(u32 begin, u32 end)>;
+
+    SliceFunc Run;
+    eastl::function<void()> Finish;  // optional, after the last slice (resolves, copies)
+
+    u32 SliceCount = 0;
+
+    /// Replaced by a running average of measured slice times when `MeasureCost` is set, 0 times the first slice alone.
+    /// Stages are owned by the caller, so the estimate carries over to the next update.
+    float SliceCostUS = 0.0f;
+
+    /// Highest recent measured slice time, batches of measured stages are sized from it since slice costs
+    /// vary a lot within a stage (ie. MS texels) and the average lags behind.
+    float WorstSliceCostUS = 0.0f;
+
+    /// GPU dispatches return before the work is done, their cost can't be timed on the CPU and has to be set
+    bool MeasureCost = true;
+};
+
+/// Spreads a chain of LUT passes across frames. Every `Update` runs as many slices as the per-frame budget
+/// allows. Measured stages run in short batches predicted from their worst recent slice cost and the timer
+/// is checked between them, so a frame overshoots by at most about one slice.
+/// Stages run in order, a stage only starts after `Finish` of the previous one.
+/// Scheduler doesn't own any LUTs: callers bake into back buffers and swap them when `Update` returns true.
+class LUTUpdateScheduler
+{
+public:
+    static constexpr u32 kMaxStages = 4;
+
+    /// Drops the update in flight and starts over with `ppStages`, they have to outlive the update
+    void Begin(LUTUpdateStage *const *ppStages, u32 stageCount);
+
+    /// At least one slice runs per call so an update always completes, even if it doesn't fit the budget.
+    /// Returns true on the call that finishes the last stage.
+    bool Update(float budgetUS);
+
+    /// Runs everything that's left in one go, ie. when there's nothing to show yet
+    void Flush();
+
+public:
+    bool IsBusy()
+    {
+        return m_StageIndex < m_Stages.size();
+    }
+
+    /// [0, 1] over all slices of the current update
+    float GetProgress();
+
+    /// Frames the last finished update was spread over
+    u32 GetLastFrameCount()
+    {
+        return m_LastFrameCount;
+    }
+
+    /// Time spent by the last `Update` call, GPU stages count with their estimate
+    float GetLastUpdateUS()
+    {
+        return m_LastUpdateUS;
+    }
+
+private:
+    eastl::fixed_vector<LUTUpdateStage *, kMaxStages, false> m_Stages;
+
+    u32 m_StageIndex = 0;
+    u32 m_SliceIndex = 0;
+
+    u32 m_FrameCount = 0;
+    u32 m_LastFrameCount = 0;
+    float m_LastUpdateUS = 0.0f;
+};
\ No newline at end of file
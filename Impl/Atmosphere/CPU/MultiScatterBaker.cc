@@ -0,0 +1,261 @@
+#include "MultiScatterBaker.hh"
+
+#include "AtmosphereMath.hh"
+#include "AtmosphereKernels.hh"
+
+using namespace AtmosMath;
+
+// https://stackoverflow.com/questions/9600801/evenly-distributing-n-points-on-a-sphere
+static XMVECTOR GetUniformSphereSample(XMFLOAT2 dirSample)
+{
+    float dirX = 1.0f - 2.0f * dirSample.x;  // new direction from 1 to -1
+    float radius = sqrtf(bx::max(0.0f, 1.0f - dirX * dirX));
+    float phi = 2.0f * PI * dirSample.y;
+
+    return XMVectorSet(radius * cosf(phi), radius * sinf(phi), dirX, 0.0f);
+}
+
+/// Inverse CDF of Henyey-Greenstein, cosine of the angle to the lobe axis
+static float SampleHenyeyGreenstein(float g, float u)
+{
+    if (fabsf(g) < 1e-3f) return 1.0f - 2.0f * u;
+
+    float s = (1.0f - g * g) / (1.0f - g + 2.0f * g * u);
+    return bx::clamp((1.0f + g * g - s * s) / (2.0f * g), -1.0f, 1.0f);
+}
+
+void MultiScatterBaker::Init(u32 width, u32 height, const MultiScatterSettings &settings)
+{
+    m_LUT.Resize(width, height);
+    m_Settings = settings;
+}
+
+void MultiScatterBaker::Bake(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const XMFLOAT2 *pSamples, u32 sampleCount,
+                             ThreadPool *pPool)
+{
+    BeginBake(sampleCount);
+
+    u32 texelCount = m_LUT.Width * m_LUT.Height;
+
+    if (!pPool)
+    {
+        BakeSamples(atmos, transmittanceLUT, pSamples, 0, m_Partials.size());
+        ReduceTexels(sampleCount, 0, texelCount);
+        return;
+    }
+
+    pPool->ParallelFor(m_Partials.size(), 8, [&](u32 begin, u32 end, u32) {
+        BakeSamples(atmos, transmittanceLUT, pSamples, begin, end);
+    });
+
+    pPool->ParallelFor(texelCount, 64, [&](u32 begin, u32 end, u32) {
+        ReduceTexels(sampleCount, begin, end);
+    });
+}
+
+u32 MultiScatterBaker::BeginBake(u32 sampleCount)
+{
+    m_IntegratedCount = m_Settings.ShaderSampleQuirk ? sampleCount / 2 : sampleCount;
+    m_Partials.resize(m_LUT.Width * m_LUT.Height * m_IntegratedCount);
+
+    return m_Partials.size();
+}
+
+XMVECTOR MultiScatterBaker::GetSampleDirection(const Atmosphere &atmos, XMFLOAT2 sample, XMVECTOR sunDir, float &weight)
+{
+    weight = 1.0f;
+    if (m_Settings.Sampling == MultiScatterSampling::Uniform) return GetUniformSphereSample(sample);
+
+    // Cornette-Shanks is at most 1.5x Henyey-Greenstein with the same g. Rayleigh, ground and Fms terms are
+    // smooth so most directions stay uniform. X picks the strategy, both parts stay stratified.
+    constexpr float kUniformRatio = 0.75f;
+    const float g = atmos.MieAsymmetry;
+
+    XMVECTOR sampleDir;
+    if (sample.x < kUniformRatio)
+    {
+        sampleDir = GetUniformSphereSample(XMFLOAT2(sample.x / kUniformRatio, sample.y));
+    }
+    else
+    {
+        float cosTheta = SampleHenyeyGreenstein(g, (sample.x - kUniformRatio) / (1.0f - kUniformRatio));
+        float sinTheta = sqrtf(bx::max(0.0f, 1.0f - cosTheta * cosTheta));
+        float phi = 2.0f * PI * sample.y;
+
+        XMVECTOR tangent = XMVector3Normalize(XMVector3Orthogonal(sunDir));
+        XMVECTOR bitangent = XMVector3Cross(sunDir, tangent);
+
+        sampleDir = (sinTheta * cosf(phi)) * tangent + (sinTheta * sinf(phi)) * bitangent + cosTheta * sunDir;
+    }
+
+    float cosTheta = XMVectorGetX(XMVector3Dot(sampleDir, sunDir));
+    float hgPDF = (1.0f - g * g) / (4.0f * PI * powf(bx::max(1.0f + g * g - 2.0f * g * cosTheta, 1e-6f), 1.5f));
+    float pdf = kUniformRatio / (4.0f * PI) + (1.0f - kUniformRatio) * hgPDF;
+
+    weight = 1.0f / (4.0f * PI * pdf);
+
+    return sampleDir;
+}
+
+void MultiScatterBaker::IntegrateSample(const Atmosphere &atmos, const LUT2D &transmittanceLUT, XMVECTOR rayPos, XMVECTOR sunDir, XMVECTOR sampleDir,
+                                        float weight, SamplePartial &partial)
+{
+    const AtmosKernels &kernels = GetAtmosKernels(m_Settings.MaxKernelISA);
+    const u32 stepCount = m_Settings.StepCount;
+
+    float maxDist = 0.0f;
+    bool planetHit = GetQuadraticIntersection3D(rayPos, sampleDir, atmos.PlanetRadius, maxDist);
+    if (!planetHit) GetQuadraticIntersection3D(rayPos, sampleDir, atmos.AtmosRadius, maxDist);
+
+    // Get Rayleigh + Mie phase
+    float cosTheta = XMVectorGetX(XMVector3Dot(sampleDir, sunDir));
+    float rayleighPhase = GetRayleighPhase(-cosTheta);
+    float miePhase = GetMiePhase(atmos, cosTheta);
+
+    /// Gather step positions, density terms are evaluated in batches
+    thread_local eastl::vector<float> scratch;
+    scratch.resize(stepCount * 9);
+
+    float *pAltitude = scratch.data();
+    float *pSunTheta = pAltitude + stepCount;
+    float *pExtinctionR = pSunTheta + stepCount;
+    float *pExtinctionG = pExtinctionR + stepCount;
+    float *pExtinctionB = pExtinctionG + stepCount;
+    float *pRayleighR = pExtinctionB + stepCount;
+    float *pRayleighG = pRayleighR + stepCount;
+    float *pRayleighB = pRayleighG + stepCount;
+    float *pMie = pRayleighB + stepCount;
+
+    float stepSize = maxDist / stepCount;
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        XMVECTOR stepPosition = rayPos + (stepSize * i) * sampleDir;
+        float h = XMVectorGetX(XMVector3Length(stepPosition));
+
+        pAltitude[i] = h - atmos.PlanetRadius;
+        pSunTheta[i] = XMVectorGetX(XMVector3Dot(sunDir, stepPosition / h));
+    }
+
+    kernels.ExtinctionSum(atmos, pAltitude, pExtinctionR, pExtinctionG, pExtinctionB, stepCount);
+    kernels.Scattering(atmos, pAltitude, pRayleighR, pRayleighG, pRayleighB, pMie, stepCount);
+
+    // Ray marching
+    XMVECTOR L2 = XMVectorZero();
+    XMVECTOR Fms = XMVectorZero();
+    XMVECTOR transmittance = XMVectorReplicate(1.0f);
+
+    float t = 0.0f;
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        float nextT = stepSize * i;
+        float deltaT = nextT - t;
+        t = nextT;
+
+        XMVECTOR extinction = XMVectorSet(pExtinctionR[i], pExtinctionG[i], pExtinctionB[i], 1.0f);
+        XMVECTOR altitudeTrans = XMVectorExpE(extinction * -deltaT);  // T(x, x - tv)
+
+        // Shadowing factor --- S(x, x - tw_s)
+        XMVECTOR sunTrans = SampleLUT(transmittanceLUT, atmos, pAltitude[i], pSunTheta[i]);
+
+        // Equation 6
+        XMVECTOR rayleighScat = XMVectorSet(pRayleighR[i], pRayleighG[i], pRayleighB[i], 0.0f);
+        XMVECTOR mieScat = XMVectorReplicate(pMie[i]);
+
+        XMVECTOR scatteringPhase = (rayleighScat * rayleighPhase + mieScat * miePhase) * sunTrans;
+        XMVECTOR integralLum = (scatteringPhase - scatteringPhase * altitudeTrans) / extinction;
+        L2 += integralLum * transmittance;
+
+        // Equation 7, a bit different, cancels phase function
+        XMVECTOR scatteringNoPhase = rayleighScat + mieScat;
+        XMVECTOR integralFactor = (scatteringNoPhase - scatteringNoPhase * altitudeTrans) / extinction;
+        Fms += integralFactor * transmittance;
+
+        transmittance *= altitudeTrans;
+    }
+
+    // Calculate ground albedo
+    if (planetHit)
+    {
+        XMVECTOR intersectPos = rayPos + maxDist * sampleDir;
+
+        float h = XMVectorGetX(XMVector3Length(intersectPos));
+        XMVECTOR up = intersectPos / h;
+
+        float altitude = h - atmos.PlanetRadius;
+        float theta = XMVectorGetX(XMVector3Dot(sunDir, up));
+
+        XMVECTOR sunTrans = SampleLUT(transmittanceLUT, atmos, altitude, theta);
+
+        // magic function, actually called Normal.Light
+        float lightTheta = bx::clamp(XMVectorGetX(XMVector3Dot(up, sunDir)), 0.0f, 1.0f);
+
+        L2 += sunTrans * transmittance * lightTheta * XMLoadFloat3(&m_Settings.TerrainAlbedo) / PI;
+    }
+
+    XMStoreFloat3(&partial.L2, L2 * weight);
+    XMStoreFloat3(&partial.Fms, Fms * weight);
+    partial.Weight = weight;
+}
+
+void MultiScatterBaker::BakeSamples(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const XMFLOAT2 *pSamples, u32 begin, u32 end)
+{
+    for (u32 i = begin; i < end; i++)
+    {
+        u32 texel = i / m_IntegratedCount;
+        u32 sample = i % m_IntegratedCount;
+
+        XMVECTOR rayPos, sunDir;
+        GetTexelRay(atmos, texel, rayPos, sunDir);
+
+        float weight;
+        XMVECTOR sampleDir = GetSampleDirection(atmos, pSamples[sample], sunDir, weight);  // w_s
+
+        IntegrateSample(atmos, transmittanceLUT, rayPos, sunDir, sampleDir, weight, m_Partials[i]);
+    }
+}
+
+void MultiScatterBaker::ReduceTexels(u32 sampleCount, u32 begin, u32 end)
+{
+    for (u32 texel = begin; texel < end; texel++)
+    {
+        // Fixed order sum, that's what keeps the result independent from scheduling
+        XMVECTOR totalL2 = XMVectorZero();
+        XMVECTOR totalFms = XMVectorZero();
+        float totalWeight = 0.0f;
+
+        const SamplePartial *pPartials = &m_Partials[texel * m_IntegratedCount];
+        for (u32 i = 0; i < m_IntegratedCount; i++)
+        {
+            totalL2 += XMLoadFloat3(&pPartials[i].L2);
+            totalFms += XMLoadFloat3(&pPartials[i].Fms);
+            totalWeight += pPartials[i].Weight;
+        }
+
+        // Weighted samples are normalized by their weight sum instead of the count, a few directions with
+        // large weights would otherwise push Fms above 1. Biased but consistent, weights average to 1.
+        float normalization = (float)sampleCount;
+        if (m_Settings.Sampling != MultiScatterSampling::Uniform) normalization = totalWeight * sampleCount / m_IntegratedCount;
+
+        XMVECTOR L2 = totalL2 / normalization;
+        XMVECTOR Fms = totalFms / normalization;
+
+        XMVECTOR result = L2 / (XMVectorReplicate(1.0f) - Fms);
+        XMStoreFloat4(&m_LUT.Texels[texel], XMVectorSetW(result, 1.0f));
+    }
+}
+
+void MultiScatterBaker::GetTexelRay(const Atmosphere &atmos, u32 texel, XMVECTOR &rayPos, XMVECTOR &sunDir)
+{
+    u32 x = texel % m_LUT.Width;
+    u32 y = texel / m_LUT.Width;
+
+    float u = (float)x / m_LUT.Width;
+    float v = (float)y / m_LUT.Height;
+
+    float h = atmos.PlanetRadius + (atmos.AtmosRadius - atmos.PlanetRadius) * v;
+    rayPos = XMVectorSet(0.0f, h, 0.0f, 0.0f);
+
+    // https://www.desmos.com/calculator/guspypmdaa
+    float sunCosTheta = 2.0f * u - 1.0f;  // [0, 1] -> [-1, 1]
+    sunDir = XMVectorSet(0.0f, sunCosTheta, sinf(acosf(sunCosTheta)), 0.0f);
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "AtmosphereKernels.hh"
+#include "LUT.hh"
+
+enum class MultiScatterSampling : u8
+{
+    Uniform,          /// Uniform sphere directions, same mapping as the shader
+    PhaseImportance,  /// A quarter of the directions follow the Mie lobe around the sun, helps low sun texels the most
+};
+
+struct MultiScatterSettings
+{
+    XMFLOAT3 TerrainAlbedo = { 0.3, 0.3, 0.3 };
+    u32 StepCount = 256;
+
+    /// How sample points are mapped to directions
+    MultiScatterSampling Sampling = MultiScatterSampling::Uniform;
+
+    /// Shader only integrates the first half of its samples but still divides by `SampleCount`,
+    /// which halves L2 and Fms. On so LUTs match the GPU bake, turn it off for the actual integral.
+    /// Has to be off for stratified and Sobol sets, half of those sets doesn't cover the sphere.
+    bool ShaderSampleQuirk = true;
+
+    /// Highest kernel set the integrator may use, lower of this and what the CPU supports is picked.
+    /// Output is only bit-identical for the same kernel set, reference and regression bakes pin it to SSE
+    /// so every x64 host produces the same LUT.
+    KernelISA MaxKernelISA = KernelISA::AVX2;
+};
+
+/// CPU version of `Atmos/MultiScatter.hlsl`.
+/// Every (texel, sample direction) pair is integrated as its own job and stored, sums are then
+/// reduced per texel in sample order. Output is bit-identical no matter how many threads ran it.
+class MultiScatterBaker
+{
+public:
+    void Init(u32 width, u32 height, const MultiScatterSettings &settings);
+
+    /// `pSamples` are [0, 1] points on the unit square (same as the GPU sample buffer), see `SampleSets.hh`
+    void Bake(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const XMFLOAT2 *pSamples, u32 sampleCount, ThreadPool *pPool);
+
+    /// Split version of `Bake` for callers that spread a bake across frames, same result.
+    /// `BeginBake` sizes the partial sums and returns the number of (texel, sample) jobs, `BakeSamples` integrates
+    /// a range of them and `ReduceTexels` resolves texels once all of their jobs are done.
+    u32 BeginBake(u32 sampleCount);
+    void BakeSamples(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const XMFLOAT2 *pSamples, u32 begin, u32 end);
+    void ReduceTexels(u32 sampleCount, u32 begin, u32 end);
+
+public:
+    LUT2D &GetLUT()
+    {
+        return m_LUT;
+    }
+
+private:
+    struct SamplePartial
+    {
+        XMFLOAT3 L2;
+        XMFLOAT3 Fms;
+        float Weight;
+    };
+
+    /// `weight` is the uniform sphere PDF over the PDF of `sample` with the current sampling
+    XMVECTOR GetSampleDirection(const Atmosphere &atmos, XMFLOAT2 sample, XMVECTOR sunDir, float &weight);
+
+    void IntegrateSample(const Atmosphere &atmos, const LUT2D &transmittanceLUT, XMVECTOR rayPos, XMVECTOR sunDir, XMVECTOR sampleDir,
+                         float weight, SamplePartial &partial);
+
+    void GetTexelRay(const Atmosphere &atmos, u32 texel, XMVECTOR &rayPos, XMVECTOR &sunDir);
+
+    LUT2D m_LUT;
+    MultiScatterSettings m_Settings;
+
+    u32 m_IntegratedCount = 0;
+    eastl::vector<SamplePartial> m_Partials;
+};
\ No newline at end of file
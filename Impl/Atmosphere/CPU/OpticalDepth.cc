@@ -0,0 +1,256 @@
+#include "OpticalDepth.hh"
+
+#include "AtmosphereKernels.hh"
+
+#include <EASTL/sort.h>
+
+namespace
+{
+    /// One monotonic (in altitude) piece of the ray
+    struct Segment
+    {
+        XMFLOAT3 Origin;
+        XMFLOAT3 Direction;
+
+        float DenseT;  // end with the lowest altitude
+        float Length;
+        float Sign;  // +1 marches away from `DenseT` forwards, -1 backwards
+    };
+
+    /// Adds sum of f(s) = extinction(t(s)) * dt/ds over `sampleCount` points s = first + i * stride
+    void AccumulateSamples(const Atmosphere &atmos, const Segment &segment, float first, float stride, u32 sampleCount, float *pSumRGB)
+    {
+        thread_local eastl::vector<float> scratch;
+        scratch.resize(sampleCount * 5);
+
+        float *pAltitude = scratch.data();
+        float *pWeight = pAltitude + sampleCount;
+        float *pR = pWeight + sampleCount;
+        float *pG = pR + sampleCount;
+        float *pB = pG + sampleCount;
+
+        for (u32 i = 0; i < sampleCount; i++)
+        {
+            float s = first + stride * i;
+            float t = segment.DenseT + segment.Sign * segment.Length * s * s;
+
+            float x = segment.Origin.x + segment.Direction.x * t;
+            float y = segment.Origin.y + segment.Direction.y * t;
+            float z = segment.Origin.z + segment.Direction.z * t;
+
+            pAltitude[i] = sqrtf(x * x + y * y + z * z) - atmos.PlanetRadius;
+            pWeight[i] = 2.0f * segment.Length * s;
+        }
+
+        GetAtmosKernels().ExtinctionSum(atmos, pAltitude, pR, pG, pB, sampleCount);
+
+        for (u32 i = 0; i < sampleCount; i++)
+        {
+            pSumRGB[0] += pR[i] * pWeight[i];
+            pSumRGB[1] += pG[i] * pWeight[i];
+            pSumRGB[2] += pB[i] * pWeight[i];
+        }
+    }
+
+    u32 IntegrateSegment(const Atmosphere &atmos, const Segment &segment, const IntegratorSettings &settings, float *pDepthRGB)
+    {
+        if (segment.Length <= 0.0f) return 0;
+
+        u32 intervals = eastl::max(settings.MinSteps, 1u);
+
+        // f(0) = 0 because dt/ds = 0 there, so interior sum is everything but the half weighted last sample
+        float interior[3] = {};
+        float last[3] = {};
+        AccumulateSamples(atmos, segment, 1.0f / intervals, 1.0f / intervals, intervals - 1, interior);
+        AccumulateSamples(atmos, segment, 1.0f, 0.0f, 1, last);
+
+        u32 sampleCount = intervals;
+
+        float trapezoid[3];
+        float result[3];
+        for (u32 c = 0; c < 3; c++) result[c] = trapezoid[c] = (interior[c] + 0.5f * last[c]) / intervals;
+
+        while (intervals * 2 <= settings.MaxSteps)
+        {
+            // New samples are midpoints of current intervals
+            AccumulateSamples(atmos, segment, 0.5f / intervals, 1.0f / intervals, intervals, interior);
+            sampleCount += intervals;
+            intervals *= 2;
+
+            float maxError = 0.0f;
+            for (u32 c = 0; c < 3; c++)
+            {
+                float refined = (interior[c] + 0.5f * last[c]) / intervals;
+                float error = fabsf(refined - trapezoid[c]) / 3.0f;  // Richardson estimate of trapezoid error
+
+                if (refined > 0.0f) maxError = eastl::max(maxError, error / refined);
+
+                // Trapezoid -> Simpson
+                result[c] = refined + (refined - trapezoid[c]) / 3.0f;
+                trapezoid[c] = refined;
+            }
+
+            if (maxError <= settings.RelativeError) break;
+        }
+
+        for (u32 c = 0; c < 3; c++) pDepthRGB[c] += result[c];
+
+        return sampleCount;
+    }
+
+    constexpr double kPI = 3.14159265358979323846;
+
+    /// exp(y^2) * erfc(y), y >= 0. Direct form underflows for large y, asymptotic series takes over there.
+    double ScaledErfc(double y)
+    {
+        if (y < 5.0) return exp(y * y) * erfc(y);
+
+        double inv2 = 1.0 / (y * y);
+        return (1.0 - 0.5 * inv2 + 0.75 * inv2 * inv2 - 1.875 * inv2 * inv2 * inv2) / (y * sqrt(kPI));
+    }
+
+    /// Chapman function above the horizon, first term of its asymptotic expansion.
+    /// Error is O(1 / x), x = radius / scaleHeight is ~800 for Rayleigh and ~5000 for Mie.
+    double ChapmanUpper(double x, double mu)
+    {
+        return sqrt(0.5 * kPI * x) * ScaledErfc(sqrt(0.5 * x) * mu);
+    }
+
+    /// Integral of exp(-altitude / scaleHeight) from radius `r` along `mu` to infinity
+    double ExponentialLayerDepth(double r, double mu, double planetRadius, double scaleHeight)
+    {
+        double x = r / scaleHeight;
+
+        if (mu >= 0.0) return scaleHeight * exp(-(r - planetRadius) / scaleHeight) * ChapmanUpper(x, mu);
+
+        // Below horizon, full pass through the lowest point minus the upward part behind the observer.
+        // Densities are taken separately so exp(x - x0) can't overflow.
+        double lowestR = r * sqrt(1.0 - mu * mu);
+        double horizontal = scaleHeight * exp(-(lowestR - planetRadius) / scaleHeight) * sqrt(0.5 * kPI * lowestR / scaleHeight);
+        double behind = scaleHeight * exp(-(r - planetRadius) / scaleHeight) * ChapmanUpper(x, -mu);
+
+        return 2.0 * horizontal - behind;
+    }
+
+    /// Same as above but stops at `topRadius`
+    double ExponentialLayerDepth(double r, double mu, double planetRadius, double topRadius, double scaleHeight)
+    {
+        double d2 = r * r * (1.0 - mu * mu);
+        double topMu = sqrt(eastl::max(0.0, 1.0 - d2 / (topRadius * topRadius)));
+
+        return ExponentialLayerDepth(r, mu, planetRadius, scaleHeight) - ExponentialLayerDepth(topRadius, topMu, planetRadius, scaleHeight);
+    }
+
+    /// Integral of sqrt(u^2 + d^2) du from 0 to u
+    double RadiusIntegral(double u, double d)
+    {
+        double radius = sqrt(u * u + d * d);
+        double tail = d > 0.0 ? d * d * asinh(u / d) : 0.0;
+
+        return 0.5 * (u * radius + tail);
+    }
+
+    /// Integral of the ozone tent along the ray, ray is parameterized by u = t + r * mu so radius = sqrt(u^2 + d^2)
+    double OzoneLayerDepth(double r, double mu, double distance, double planetRadius, double ozoneHeight, double ozoneThickness)
+    {
+        double d = r * sqrt(eastl::max(0.0, 1.0 - mu * mu));
+        double center = planetRadius + ozoneHeight;
+
+        double beginU = r * mu;
+        double endU = beginU + distance;
+
+        // Density is linear in radius between breakpoints, radius is monotonic on both sides of u = 0
+        eastl::fixed_vector<double, 8> breakpoints = { beginU, endU };
+        if (beginU < 0.0 && endU > 0.0) breakpoints.push_back(0.0);
+
+        for (double radius : { center - ozoneThickness, center, center + ozoneThickness })
+        {
+            if (radius <= d) continue;
+
+            double crossU = sqrt(radius * radius - d * d);
+            if (crossU > beginU && crossU < endU) breakpoints.push_back(crossU);
+            if (-crossU > beginU && -crossU < endU) breakpoints.push_back(-crossU);
+        }
+
+        eastl::sort(breakpoints.begin(), breakpoints.end());
+
+        double depth = 0.0;
+        for (u32 i = 0; i + 1 < breakpoints.size(); i++)
+        {
+            double a = breakpoints[i];
+            double b = breakpoints[i + 1];
+            if (b <= a) continue;
+
+            double midU = 0.5 * (a + b);
+            double midRadius = sqrt(midU * midU + d * d);
+            if (fabs(midRadius - center) >= ozoneThickness) continue;
+
+            // 1 - |radius - center| / thickness = constant + slope * radius
+            double slope = midRadius < center ? 1.0 / ozoneThickness : -1.0 / ozoneThickness;
+            double constant = 1.0 - slope * center;
+
+            depth += constant * (b - a) + slope * (RadiusIntegral(b, d) - RadiusIntegral(a, d));
+        }
+
+        return depth;
+    }
+
+}  // namespace
+
+namespace OpticalDepth
+{
+    XMVECTOR IntegrateAdaptive(const Atmosphere &atmos, XMVECTOR origin, XMVECTOR direction, float distance, const IntegratorSettings &settings,
+                               u32 *pSampleCount)
+    {
+        direction = XMVector3Normalize(direction);
+
+        // Closest point to planet center, altitude is monotonic on both sides of it
+        float lowestT = bx::clamp(-XMVectorGetX(XMVector3Dot(origin, direction)), 0.0f, distance);
+
+        Segment before;
+        XMStoreFloat3(&before.Origin, origin);
+        XMStoreFloat3(&before.Direction, direction);
+        before.DenseT = lowestT;
+        before.Length = lowestT;
+        before.Sign = -1.0f;
+
+        Segment after = before;
+        after.Length = distance - lowestT;
+        after.Sign = 1.0f;
+
+        float depth[3] = {};
+        u32 sampleCount = IntegrateSegment(atmos, before, settings, depth);
+        sampleCount += IntegrateSegment(atmos, after, settings, depth);
+
+        if (pSampleCount) *pSampleCount = sampleCount;
+
+        return XMVectorSet(depth[0], depth[1], depth[2], 0.0f);
+    }
+
+
+    XMVECTOR Chapman(const Atmosphere &atmos, XMVECTOR origin, XMVECTOR direction)
+    {
+        direction = XMVector3Normalize(direction);
+
+        double r = XMVectorGetX(XMVector3Length(origin));
+        double mu = XMVectorGetX(XMVector3Dot(origin, direction)) / r;
+
+        double planetRadius = atmos.PlanetRadius;
+        double topRadius = atmos.AtmosRadius;
+
+        double rayleigh = ExponentialLayerDepth(r, mu, planetRadius, topRadius, atmos.RayleighDensity);
+        double mie = ExponentialLayerDepth(r, mu, planetRadius, topRadius, atmos.MieDensity);
+
+        // Exact distance to the top, float quadratic loses too much at planet scale
+        double d2 = r * r * (1.0 - mu * mu);
+        double distance = sqrt(eastl::max(0.0, topRadius * topRadius - d2)) - r * mu;
+        double ozone = OzoneLayerDepth(r, mu, distance, planetRadius, atmos.OzoneHeight, atmos.OzoneThickness);
+
+        XMVECTOR depth = XMLoadFloat3(&atmos.RayleighScatterVal) * (float)rayleigh;
+        depth += XMVectorReplicate((atmos.MieScatterVal + atmos.MieAbsorptionVal) * (float)mie);
+        depth += XMLoadFloat3(&atmos.OzoneAbsorption) * (float)ozone;
+
+        return depth;
+    }
+
+}  // namespace OpticalDepth
\ No newline at end of file
@@ -0,0 +1,43 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Atmosphere.hh"
+
+enum class IntegratorMode : u8
+{
+    Uniform,   /// Fixed step count, same as shaders
+    Adaptive,  /// Samples follow the density profile, refined until error target is met
+    Chapman,   /// Closed form, O(1) per ray
+};
+
+struct IntegratorSettings
+{
+    IntegratorMode Mode = IntegratorMode::Uniform;
+
+    /// Uniform only
+    u32 StepCount = 1000;
+
+    /// Adaptive only, step count doubles from `MinSteps` until estimated relative error is below `RelativeError`
+    float RelativeError = 1e-3f;
+    u32 MinSteps = 8;
+    u32 MaxSteps = 1024;
+};
+
+namespace OpticalDepth
+{
+    /// Optical depth of [0, distance] along the ray, per RGB channel.
+    /// Ray is split at its lowest point and each half is sampled densely at the low end (t = s^2 mapping).
+    /// Trapezoid sums are refined by doubling, result is Richardson extrapolated (Simpson).
+    /// `pSampleCount` receives the number of extinction evaluations if not null.
+    XMVECTOR IntegrateAdaptive(const Atmosphere &atmos, XMVECTOR origin, XMVECTOR direction, float distance, const IntegratorSettings &settings,
+                               u32 *pSampleCount = nullptr);
+
+    /// Optical depth from `origin` along `direction` to the top of the atmosphere, no ray marching.
+    /// Rayleigh/Mie layers use the asymptotic Chapman function, ozone tent is integrated exactly.
+    /// Ray must not hit the planet.
+    XMVECTOR Chapman(const Atmosphere &atmos, XMVECTOR origin, XMVECTOR direction);
+
+}  // namespace OpticalDepth
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "PresetBaker.hh"
+
+#include "SkySequenceRenderer.hh"
+#include "TransmittanceBaker.hh"
+
+void PresetBaker::Init(u32 laneCount, u32 threadsPerLane)
+{
+    u32 processorCount = eastl::max(EA::Thread::GetProcessorCount(), 1);
+
+    if (laneCount == 0) laneCount = threadsPerLane ? eastl::max(processorCount / threadsPerLane, 1u) : processorCount;
+    if (threadsPerLane == 0) threadsPerLane = eastl::max(processorCount / laneCount, 1u);
+
+    m_ThreadsPerLane = threadsPerLane;
+
+    m_PresetPool.Init(laneCount);
+
+    // Lane `i` is driven by worker `i` of the preset pool, which is the calling thread of its lane pool
+    m_LanePools.clear();
+    for (u32 i = 0; i < laneCount; i++)
+    {
+        ThreadPool *pPool = m_LanePools.emplace_back(new ThreadPool).get();
+        pPool->Init(threadsPerLane);
+    }
+}
+
+void PresetBaker::Bake(const AtmospherePreset *pPresets, u32 presetCount, const PresetBakeSettings &settings, PresetLUTs *pOutputs)
+{
+    // Doesn't depend on the atmosphere, shared by every preset
+    eastl::vector<XMFLOAT2> samples;
+    GenerateSamples(settings.MultiScatterSampleSet, settings.MultiScatterSampleCount, samples, &m_PresetPool);
+
+    m_PresetPool.ParallelFor(presetCount, 1, [&](u32 begin, u32 end, u32 workerID) {
+        for (u32 i = begin; i < end; i++)
+        {
+            LOG_TRACE("Baking preset '{}'...", pPresets[i].Name);
+            BakePreset(pPresets[i].Atmos, settings, samples, pOutputs[i], m_LanePools[workerID].get());
+        }
+    });
+}
+
+void PresetBaker::BakePreset(const Atmosphere &atmos, const PresetBakeSettings &settings, const eastl::vector<XMFLOAT2> &samples,
+                             PresetLUTs &output, ThreadPool *pPool)
+{
+    TransmittanceBaker transmittanceBaker;
+    transmittanceBaker.Init(settings.TransmittanceSize.x, settings.TransmittanceSize.y, settings.Transmittance);
+    transmittanceBaker.Bake(atmos, pPool);
+
+    MultiScatterBaker multiScatterBaker;
+    multiScatterBaker.Init(settings.MultiScatterSize.x, settings.MultiScatterSize.y, settings.MultiScatter);
+    multiScatterBaker.Bake(atmos, transmittanceBaker.GetLUT(), samples.data(), samples.size(), pPool);
+
+    SkyViewSettings skyViewSettings;
+    skyViewSettings.EyePosition = XMFLOAT3(0, atmos.PlanetRadius + settings.EyeAltitude, 0);
+    skyViewSettings.StepCount = settings.SkyViewStepCount;
+    skyViewSettings.SunDirection = SkySequenceRenderer::GetSunDirection(settings.SunRotation);
+    skyViewSettings.SunIntensity = settings.SunIntensity;
+
+    SkyViewBaker skyViewBaker;
+    skyViewBaker.Init(settings.SkyViewSize.x, settings.SkyViewSize.y);
+    skyViewBaker.Bake(atmos, skyViewSettings, transmittanceBaker.GetLUT(), multiScatterBaker.GetLUT(), pPool);
+
+    output.Transmittance = eastl::move(transmittanceBaker.GetLUT());
+    output.MultiScatter = eastl::move(multiScatterBaker.GetLUT());
+    output.SkyView = eastl::move(skyViewBaker.GetLUT());
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <EASTL/unique_ptr.h>
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+#include "MultiScatterBaker.hh"
+#include "OpticalDepth.hh"
+#include "SampleSets.hh"
+#include "SkyViewBaker.hh"
+
+struct AtmospherePreset
+{
+    eastl::string Name;
+    Atmosphere Atmos;
+};
+
+struct PresetBakeSettings
+{
+    XMUINT2 TransmittanceSize = { 256, 64 };
+    IntegratorSettings Transmittance;
+
+    XMUINT2 MultiScatterSize = { 32, 32 };
+    MultiScatterSettings MultiScatter;  // `ShaderSampleQuirk` has to be off for sets other than Poisson disc
+    SampleSetType MultiScatterSampleSet = SampleSetType::PoissonDisc;
+    u32 MultiScatterSampleCount = 128;
+
+    XMUINT2 SkyViewSize = { 400, 200 };
+    u32 SkyViewStepCount = 48;
+    float SunIntensity = 10;
+    XMFLOAT2 SunRotation = { 90, 45 };  // degrees, same as the app
+    float EyeAltitude = 2;              // m, above `PlanetRadius` of each preset
+};
+
+struct PresetLUTs
+{
+    LUT2D Transmittance;
+    LUT2D MultiScatter;
+    LUT2D SkyView;
+};
+
+/// Runs the full LUT chain (transmittance -> MS -> sky-view) for many atmosphere presets.
+/// Work is scheduled on two levels: presets are spread across lanes by an outer pool, and every
+/// lane owns an inner pool that splits the texels of the preset it is baking.
+/// Few wide lanes suit few presets, many narrow lanes keep cores busy through the serial parts of a chain.
+class PresetBaker
+{
+public:
+    /// 0 picks lanes/threads from the processor count
+    void Init(u32 laneCount = 0, u32 threadsPerLane = 0);
+
+    /// `pOutputs` has `presetCount` elements, output order doesn't depend on scheduling
+    void Bake(const AtmospherePreset *pPresets, u32 presetCount, const PresetBakeSettings &settings, PresetLUTs *pOutputs);
+
+    void BakePreset(const Atmosphere &atmos, const PresetBakeSettings &settings, const eastl::vector<XMFLOAT2> &samples, PresetLUTs &output,
+                    ThreadPool *pPool);
+
+public:
+    u32 GetLaneCount()
+    {
+        return m_LanePools.size();
+    }
+
+    u32 GetThreadsPerLane()
+    {
+        return m_ThreadsPerLane;
+    }
+
+private:
+    ThreadPool m_PresetPool;
+    eastl::vector<eastl::unique_ptr<ThreadPool>> m_LanePools;
+
+    u32 m_ThreadsPerLane = 1;
+};
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "SampleSets.hh"
+
+#include "IO/FileStream.hh"
+#include "IO/MappedFile.hh"
+#include "Utils/Random.hh"
+
+// intrin.h only exists on MSVC
+#ifndef _MSC_VER
+#define CY_NO_INTRIN_H
+#endif
+
+#include <cy/cySampleElim.h>
+#include <cy/cyPoint.h>
+
+#include <filesystem>
+
+using namespace lr;
+
+void GenerateSamples(SampleSetType type, u32 sampleCount, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool)
+{
+    switch (type)
+    {
+        case SampleSetType::PoissonDisc: GeneratePoissonDiscSamples(sampleCount, output, pPool); break;
+        case SampleSetType::Stratified: GenerateStratifiedSamples(sampleCount, output); break;
+        case SampleSetType::Sobol: GenerateSobolSamples(sampleCount, output); break;
+    }
+}
+
+/// Candidates of tile 0 come from `seed` itself, that keeps single tile sets identical to the old generator
+static constexpr u32 kTileSeedStride = 0x9e3779b9;
+
+/// Output samples a tile has to own before a set is split, below that seams cost more than threads win
+static constexpr u32 kMinSamplesPerTile = 1024;
+
+static constexpr u32 kCandidateRatio = 10;
+
+/// Tiles keep this many times their share for the final pass. Lower ratios don't make the final pass much
+/// cheaper but the seam fix has less to pick from, 2x drops the minimum distance from 0.74 to 0.63 of the
+/// maximum Poisson disc radius, 5x keeps 0.70.
+static constexpr u32 kTileOutputRatio = 5;
+
+template<typename PointType, u32 kDimension>
+static void GetTileBounds(u32 tile, u32 tilesPerAxis, PointType &boundsMin, PointType &boundsMax)
+{
+    for (u32 d = 0; d < kDimension; d++, tile /= tilesPerAxis)
+    {
+        boundsMin[d] = (float)(tile % tilesPerAxis) / tilesPerAxis;
+        boundsMax[d] = (float)(tile % tilesPerAxis + 1) / tilesPerAxis;
+    }
+}
+
+template<typename PointType, u32 kDimension>
+static void GenerateCandidates(u32 tile, u32 tilesPerAxis, u32 seed, PointType *pCandidates, u32 candidateCount)
+{
+    PointType boundsMin, boundsMax;
+    GetTileBounds<PointType, kDimension>(tile, tilesPerAxis, boundsMin, boundsMax);
+
+    std::mt19937 random(seed + tile * kTileSeedStride);
+    std::uniform_real_distribution<float> distribution(0, 1);
+
+    for (u32 i = 0; i < candidateCount; i++)
+    {
+        for (u32 d = 0; d < kDimension; d++) pCandidates[i][d] = boundsMin[d] + distribution(random) * (boundsMax[d] - boundsMin[d]);
+    }
+}
+
+template<typename PointType, u32 kDimension>
+static void EliminateTiled(u32 sampleCount, u32 seed, PointType *pOutput, ThreadPool *pPool)
+{
+    cy::WeightedSampleElimination<PointType, float, kDimension> eliminator;
+    eliminator.SetTiling(true);
+
+    u32 tilesPerAxis = eastl::max((u32)powf((float)sampleCount / kMinSamplesPerTile, 1.0f / kDimension), 1u);
+    u32 tileCount = 1;
+    for (u32 d = 0; d < kDimension; d++) tileCount *= tilesPerAxis;
+
+    if (tileCount == 1)
+    {
+        eastl::vector<PointType> candidates(sampleCount * kCandidateRatio);
+        GenerateCandidates<PointType, kDimension>(0, 1, seed, candidates.data(), candidates.size());
+
+        eliminator.Eliminate(candidates.data(), candidates.size(), pOutput, sampleCount);
+        return;
+    }
+
+    // Every tile keeps `kTileOutputRatio`x its share, remainder goes to the first tiles
+    u32 intermediateCount = sampleCount * kTileOutputRatio;
+    eastl::vector<PointType> intermediate(intermediateCount);
+
+    auto getTileOffset = [&](u32 tile) {
+        return tile * (intermediateCount / tileCount) + eastl::min(tile, intermediateCount % tileCount);
+    };
+
+    auto eliminateTiles = [&](u32 begin, u32 end, u32) {
+        eastl::vector<PointType> candidates;
+
+        for (u32 tile = begin; tile < end; tile++)
+        {
+            u32 offset = getTileOffset(tile);
+            u32 outputCount = getTileOffset(tile + 1) - offset;
+
+            candidates.resize(outputCount * kCandidateRatio / kTileOutputRatio);
+            GenerateCandidates<PointType, kDimension>(tile, tilesPerAxis, seed, candidates.data(), candidates.size());
+
+            // Bounds only set the weight radius here, tiles don't wrap
+            PointType boundsMin, boundsMax;
+            GetTileBounds<PointType, kDimension>(tile, tilesPerAxis, boundsMin, boundsMax);
+
+            cy::WeightedSampleElimination<PointType, float, kDimension> tileEliminator;
+            tileEliminator.SetBoundsMin(boundsMin);
+            tileEliminator.SetBoundsMax(boundsMax);
+            tileEliminator.Eliminate(candidates.data(), candidates.size(), &intermediate[offset], outputCount);
+        }
+    };
+
+    if (pPool)
+        pPool->ParallelFor(tileCount, 1, eliminateTiles);
+    else
+        eliminateTiles(0, tileCount, 0);
+
+    // Tiles don't see each other, their borders are denser than the rest and get thinned first here
+    eliminator.Eliminate(intermediate.data(), intermediate.size(), pOutput, sampleCount);
+}
+
+void GeneratePoissonDiscPoints(u32 sampleCount, u32 dimension, u32 seed, float *pOutput, ThreadPool *pPool)
+{
+    static_assert(sizeof(cy::Point2f) == sizeof(float) * 2 && sizeof(cy::Point3f) == sizeof(float) * 3);
+
+    switch (dimension)
+    {
+        case 2: EliminateTiled<cy::Point2f, 2>(sampleCount, seed, (cy::Point2f *)pOutput, pPool); break;
+        case 3: EliminateTiled<cy::Point3f, 3>(sampleCount, seed, (cy::Point3f *)pOutput, pPool); break;
+        default: LOG_ERROR("Poisson disc sets can only be 2D or 3D, not {}D.", dimension); break;
+    }
+}
+
+void GeneratePoissonDiscSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool, u32 seed)
+{
+    output.resize(sampleCount);
+    GeneratePoissonDiscPoints(sampleCount, 2, seed, &output[0].x, pPool);
+}
+
+// Kensler, Correlated Multi-Jittered Sampling (the uncorrelated version with full shuffles)
+void GenerateStratifiedSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output)
+{
+    // Most square grid whose size is exactly `sampleCount`, prime counts end up as a 1 x N latin hypercube
+    u32 columns = (u32)sqrtf((float)sampleCount);
+    while (columns > 1 && sampleCount % columns) columns--;
+    columns = eastl::max(columns, 1u);
+    u32 rows = sampleCount / columns;
+
+    Random::Seed();
+
+    output.resize(sampleCount);
+
+    for (u32 j = 0; j < rows; j++)
+    {
+        for (u32 i = 0; i < columns; i++)
+        {
+            XMFLOAT2 &point = output[j * columns + i];
+            point.x = (i + (j + Random::Float(0, 1)) / rows) / columns;
+            point.y = (j + (i + Random::Float(0, 1)) / columns) / rows;
+        }
+    }
+
+    // Shuffling keeps every point in its own column and row strata
+    for (u32 j = 0; j < rows; j++)
+    {
+        for (u32 i = 0; i < columns; i++)
+        {
+            u32 k = Random::UInt(j, rows - 1);
+            eastl::swap(output[j * columns + i].x, output[k * columns + i].x);
+        }
+    }
+
+    for (u32 i = 0; i < columns; i++)
+    {
+        for (u32 j = 0; j < rows; j++)
+        {
+            u32 k = Random::UInt(i, columns - 1);
+            eastl::swap(output[j * columns + i].y, output[j * columns + k].y);
+        }
+    }
+}
+
+static u32 ReverseBits(u32 bits)
+{
+    bits = (bits << 16) | (bits >> 16);
+    bits = ((bits & 0x00ff00ff) << 8) | ((bits & 0xff00ff00) >> 8);
+    bits = ((bits & 0x0f0f0f0f) << 4) | ((bits & 0xf0f0f0f0) >> 4);
+    bits = ((bits & 0x33333333) << 2) | ((bits & 0xcccccccc) >> 2);
+    bits = ((bits & 0x55555555) << 1) | ((bits & 0xaaaaaaaa) >> 1);
+
+    return bits;
+}
+
+/// Second Sobol dimension, direction numbers are `v_k = v_(k-1) ^ (v_(k-1) >> 1)`
+static u32 GetSobolY(u32 index)
+{
+    u32 result = 0;
+
+    for (u32 v = 1u << 31; index; index >>= 1, v ^= v >> 1)
+    {
+        if (index & 1) result ^= v;
+    }
+
+    return result;
+}
+
+void GenerateSobolSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output)
+{
+    Random::Seed();
+
+    // XOR scramble keeps the net properties and moves the first point off the corner
+    u32 shiftX = Random::UInt(0, UINT32_MAX);
+    u32 shiftY = Random::UInt(0, UINT32_MAX);
+
+    output.resize(sampleCount);
+
+    for (u32 i = 0; i < sampleCount; i++)
+    {
+        // Top 24 bits so the float is exact and never rounds up to 1
+        output[i].x = ((ReverseBits(i) ^ shiftX) >> 8) * (1.0f / (1 << 24));
+        output[i].y = ((GetSobolY(i) ^ shiftY) >> 8) * (1.0f / (1 << 24));
+    }
+}
+
+void SampleSetCache::Init(eastl::string_view directory)
+{
+    m_Directory = directory;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory.c_str(), error);
+
+    if (error) LOG_WARN("Couldn't create sample set directory {}, sets won't be cached.", m_Directory);
+}
+
+void SampleSetCache::GetPoissonDisc(u32 sampleCount, u32 dimension, u32 seed, eastl::vector<float> &output, ThreadPool *pPool)
+{
+    if (Load(sampleCount, dimension, seed, output)) return;
+
+    LOG_TRACE("Generating {}D Poisson disc set of {} samples...", dimension, sampleCount);
+
+    output.resize(sampleCount * dimension);
+    GeneratePoissonDiscPoints(sampleCount, dimension, seed, output.data(), pPool);
+
+    Store(sampleCount, dimension, seed, output);
+}
+
+void SampleSetCache::GetPoissonDisc(u32 sampleCount, u32 seed, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool)
+{
+    eastl::vector<float> points;
+    GetPoissonDisc(sampleCount, 2, seed, points, pPool);
+
+    output.resize(sampleCount);
+    memcpy(output.data(), points.data(), points.size() * sizeof(float));
+}
+
+bool SampleSetCache::Load(u32 sampleCount, u32 dimension, u32 seed, eastl::vector<float> &output)
+{
+    MappedFile file(GetPath(sampleCount, dimension, seed));
+    if (!file.IsOK() || file.GetSize() < sizeof(Header)) return false;
+
+    const Header *pHeader = (const Header *)file.GetData();
+    if (pHeader->Magic != Header::kMagic || pHeader->Version != Header::kVersion) return false;
+    if (pHeader->SampleCount != sampleCount || pHeader->Dimension != dimension || pHeader->Seed != seed) return false;
+
+    u64 dataSize = (u64)sampleCount * dimension * sizeof(float);
+    if (file.GetSize() < sizeof(Header) + dataSize) return false;
+
+    const float *pPoints = (const float *)(pHeader + 1);
+    output.assign(pPoints, pPoints + sampleCount * dimension);
+
+    return true;
+}
+
+void SampleSetCache::Store(u32 sampleCount, u32 dimension, u32 seed, const eastl::vector<float> &points)
+{
+    if (m_Directory.empty()) return;
+
+    Header header;
+    header.SampleCount = sampleCount;
+    header.Dimension = dimension;
+    header.Seed = seed;
+
+    // Same as `LUTCache`, write next to the entry and rename
+    eastl::string path = GetPath(sampleCount, dimension, seed);
+    eastl::string tempPath = path + ".tmp";
+
+    FileStream file(tempPath, true);
+    if (!file.IsOK())
+    {
+        LOG_WARN("Couldn't write sample set {}.", tempPath);
+        return;
+    }
+
+    file.Write(header);
+    file.WritePtr((u8 *)points.data(), points.size() * sizeof(float));
+    file.Close();
+
+    std::error_code error;
+    std::filesystem::rename(tempPath.c_str(), path.c_str(), error);
+
+    if (error) LOG_WARN("Couldn't write sample set {}.", path);
+}
+
+eastl::string SampleSetCache::GetPath(u32 sampleCount, u32 dimension, u32 seed)
+{
+    return Format("{}/{}_{}d_{:08x}.pds", m_Directory, sampleCount, dimension, seed);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+
+using namespace lr;
+
+/// [0, 1] points on the unit square for the multi scattering sample buffer.
+/// Seeds are fixed, same type and count always give the same set.
+enum class SampleSetType : u8
+{
+    PoissonDisc,  /// Weighted sample elimination, what the app uploads to the GPU
+    Stratified,   /// Multi-jittered, stratified on the N x M grid and on both axes
+    Sobol,        /// First two Sobol dimensions with a random digital shift, best with power of two counts
+};
+
+void GenerateSamples(SampleSetType type, u32 sampleCount, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool = nullptr);
+
+/// Weighted sample elimination of 10x as many random candidates, `dimension` is 2 or 3 and `pOutput` gets
+/// `sampleCount * dimension` floats. Large sets are split into tiles that are eliminated down to 5x on `pPool`
+/// with their own k-d trees, then a single tiled pass over the whole domain takes them to `sampleCount`
+/// and removes the seams. Output only depends on count, dimension and seed, never on the thread count.
+/// Small 2D sets with seed 0 are the same as the ones the app always used.
+void GeneratePoissonDiscPoints(u32 sampleCount, u32 dimension, u32 seed, float *pOutput, ThreadPool *pPool = nullptr);
+void GeneratePoissonDiscSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool = nullptr, u32 seed = 0);
+void GenerateStratifiedSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output);
+void GenerateSobolSamples(u32 sampleCount, eastl::vector<XMFLOAT2> &output);
+
+/// Poisson disc sets persisted as `<directory>/<count>_<dimension>d_<seed>.pds`.
+/// Sets are deterministic so entries never go stale, generator changes bump `Header::kVersion`.
+class SampleSetCache
+{
+public:
+    void Init(eastl::string_view directory);
+
+    /// Loads the set or generates and stores it, `output` gets `sampleCount * dimension` floats
+    void GetPoissonDisc(u32 sampleCount, u32 dimension, u32 seed, eastl::vector<float> &output, ThreadPool *pPool = nullptr);
+    void GetPoissonDisc(u32 sampleCount, u32 seed, eastl::vector<XMFLOAT2> &output, ThreadPool *pPool = nullptr);
+
+private:
+    struct Header
+    {
+        static constexpr u32 kMagic = 0x53445350;  // PSDS
+        static constexpr u32 kVersion = 1;
+
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u32 SampleCount = 0;
+        u32 Dimension = 0;
+        u32 Seed = 0;
+        u32 _padding = 0;
+    };
+
+    bool Load(u32 sampleCount, u32 dimension, u32 seed, eastl::vector<float> &output);
+    void Store(u32 sampleCount, u32 dimension, u32 seed, const eastl::vector<float> &points);
+
+    eastl::string GetPath(u32 sampleCount, u32 dimension, u32 seed);
+
+    eastl::string m_Directory;
+};
\ No newline at end of file
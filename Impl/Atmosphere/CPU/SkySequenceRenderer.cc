@@ -0,0 +1,133 @@
+#include "SkySequenceRenderer.hh"
+
+#include "AtmosphereMath.hh"
+
+using namespace AtmosMath;
+
+void SkySequenceRenderer::Init(const SkySequenceSettings &settings)
+{
+    m_Settings = settings;
+
+    for (FrameSlot &slot : m_Slots)
+    {
+        slot.Baker.Init(settings.SkyViewWidth, settings.SkyViewHeight);
+        slot.Image.Resize(settings.ImageWidth, settings.ImageHeight);
+    }
+}
+
+void SkySequenceRenderer::Render(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT, const XMFLOAT2 *pRotations,
+                                 u32 frameCount, ThreadPool *pPool, const FrameFunc &onFrame)
+{
+    if (frameCount == 0) return;
+
+    m_pFrameFunc = &onFrame;
+    m_FrameCount = frameCount;
+    m_WriterThread.Begin(WriterEntry, this);
+
+    const u32 tileCount = m_Slots[0].Baker.GetTileCount();
+    const u32 rowJobCount = (m_Settings.ImageHeight + m_RowsPerJob - 1) / m_RowsPerJob;
+
+    // Batch `i` marches frame `i` and tone maps frame `i - 1`, one extra batch drains the pipeline
+    for (u32 i = 0; i <= frameCount; i++)
+    {
+        FrameSlot *pMarchSlot = nullptr;
+        FrameSlot *pToneMapSlot = i > 0 ? &m_Slots[(i - 1) % kSlotCount] : nullptr;
+
+        SkyViewSettings skyViewSettings = m_Settings.SkyView;
+        FinalPassSettings finalSettings;
+
+        if (i < frameCount)
+        {
+            // Slot of frame `i - 3` has to be released by the writer
+            m_FreeSema.Wait();
+
+            pMarchSlot = &m_Slots[i % kSlotCount];
+            pMarchSlot->Frame.Index = i;
+            pMarchSlot->Frame.SunDirection = GetSunDirection(pRotations[i]);
+            pMarchSlot->Frame.pSkyViewLUT = &pMarchSlot->Baker.GetLUT();
+            pMarchSlot->Frame.pImage = &pMarchSlot->Image;
+
+            skyViewSettings.SunDirection = pMarchSlot->Frame.SunDirection;
+        }
+
+        if (pToneMapSlot)
+        {
+            finalSettings.SunDirection = pToneMapSlot->Frame.SunDirection;
+            finalSettings.SunRadius = m_Settings.SunRadius;
+            finalSettings.SunIntensity = m_Settings.SkyView.SunIntensity;
+        }
+
+        u32 marchJobCount = pMarchSlot ? tileCount : 0;
+        u32 toneMapJobCount = pToneMapSlot ? rowJobCount : 0;
+
+        auto job = [&](u32 begin, u32 end, u32) {
+            for (u32 j = begin; j < end; j++)
+            {
+                if (j < marchJobCount)
+                {
+                    pMarchSlot->Baker.BakeTile(atmos, skyViewSettings, transmittanceLUT, multiScatterLUT, j);
+                    continue;
+                }
+
+                u32 rowBegin = (j - marchJobCount) * m_RowsPerJob;
+                u32 rowEnd = eastl::min(rowBegin + m_RowsPerJob, m_Settings.ImageHeight);
+                FinalPass::RenderPanoramaRows(pToneMapSlot->Baker.GetLUT(), finalSettings, pToneMapSlot->Image, rowBegin, rowEnd);
+            }
+        };
+
+        if (pPool)
+            pPool->ParallelFor(marchJobCount + toneMapJobCount, 1, job);
+        else
+            job(0, marchJobCount + toneMapJobCount, 0);
+
+        if (pToneMapSlot) m_ReadySema.Post();
+    }
+
+    // Writer releases every slot it consumed, semaphores are back to their initial state
+    m_WriterThread.WaitForEnd();
+
+    m_pFrameFunc = nullptr;
+}
+
+intptr_t SkySequenceRenderer::WriterEntry(void *pContext)
+{
+    SkySequenceRenderer *pRenderer = (SkySequenceRenderer *)pContext;
+
+    for (u32 i = 0; i < pRenderer->m_FrameCount; i++)
+    {
+        pRenderer->m_ReadySema.Wait();
+
+        FrameSlot &slot = pRenderer->m_Slots[i % kSlotCount];
+        if (*pRenderer->m_pFrameFunc) (*pRenderer->m_pFrameFunc)(slot.Frame);
+
+        pRenderer->m_FreeSema.Post();
+    }
+
+    return 0;
+}
+
+XMFLOAT3 SkySequenceRenderer::GetSunDirection(XMFLOAT2 rotation)
+{
+    float sunRadX = XMConvertToRadians(rotation.x);
+    float sunRadY = XMConvertToRadians(rotation.y);
+    XMVECTOR sunDirection = XMVectorSet(cos(sunRadX) * cos(sunRadY), sin(sunRadY), sin(sunRadX) * cos(sunRadY), 0);
+    sunDirection = XMVector3Normalize(sunDirection);
+
+    XMFLOAT3 direction;
+    XMStoreFloat3(&direction, sunDirection);
+
+    return direction;
+}
+
+void SkySequenceRenderer::GetDaySchedule(eastl::vector<XMFLOAT2> &rotations, u32 stepCount, float maxElevation)
+{
+    rotations.resize(stepCount);
+
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        float t = (float)i / stepCount;
+
+        rotations[i].x = 360.0f * t;
+        rotations[i].y = -maxElevation * cosf(2.0f * PI * t);
+    }
+}
\ No newline at end of file
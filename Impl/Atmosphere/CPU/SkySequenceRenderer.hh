@@ -0,0 +1,93 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include <EASTL/functional.h>
+
+#include <eathread/eathread_thread.h>
+#include <eathread/eathread_semaphore.h>
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "FinalPass.hh"
+#include "SkyViewBaker.hh"
+
+struct SkySequenceSettings
+{
+    SkyViewSettings SkyView;  // `SunDirection` is overwritten per frame
+
+    u32 SkyViewWidth = 200;
+    u32 SkyViewHeight = 100;
+
+    /// Equirectangular panorama
+    u32 ImageWidth = 1024;
+    u32 ImageHeight = 512;
+
+    float SunRadius = 0.4;  // degrees
+};
+
+struct SkySequenceFrame
+{
+    u32 Index = 0;
+    XMFLOAT3 SunDirection = { 0, 1, 0 };
+
+    LUT2D *pSkyViewLUT = nullptr;
+    ImageRGBA8 *pImage = nullptr;
+};
+
+/// Renders a sky-view LUT and a tone mapped panorama for every sun rotation of a schedule.
+/// Transmittance and multi scattering LUTs don't depend on the sun so they are baked once by the caller.
+///
+/// Frames are pipelined in three stages:
+///   1. Sky-view march of frame N+1 \ single `ParallelFor` on the pool,
+///   2. Tone map of frame N         / tiles and panorama rows are jobs of the same batch
+///   3. `FrameFunc` of frame N-1 on the writer thread (encoding, disk IO...)
+class SkySequenceRenderer
+{
+public:
+    /// Called in frame order on the writer thread, frame data is valid until the function returns
+    using FrameFunc = eastl::function<void(const SkySequenceFrame &frame)>;
+
+    void Init(const SkySequenceSettings &settings);
+
+    /// `pRotations` are in degrees, same as `AtmosphereApp::SetSunDirection`.
+    /// Blocks until every frame is passed to `onFrame`. Runs on the calling thread if `pPool` is null.
+    void Render(const Atmosphere &atmos, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT, const XMFLOAT2 *pRotations,
+                u32 frameCount, ThreadPool *pPool, const FrameFunc &onFrame);
+
+    static XMFLOAT3 GetSunDirection(XMFLOAT2 rotation);
+
+    /// One full day in `stepCount` steps (1440 for every minute), starts at midnight.
+    /// Sun goes around once and peaks at `maxElevation` degrees at noon.
+    static void GetDaySchedule(eastl::vector<XMFLOAT2> &rotations, u32 stepCount, float maxElevation = 60);
+
+private:
+    static intptr_t WriterEntry(void *pContext);
+
+    /// Sky-view LUT is read by the tone map of the next batch and the image by the writer,
+    /// so a slot is busy for three batches.
+    static constexpr u32 kSlotCount = 3;
+
+    struct FrameSlot
+    {
+        SkyViewBaker Baker;
+        ImageRGBA8 Image;
+        SkySequenceFrame Frame;
+    };
+
+    SkySequenceSettings m_Settings;
+    FrameSlot m_Slots[kSlotCount];
+
+    /// Rows of the panorama per tone map job
+    u32 m_RowsPerJob = 16;
+
+    EA::Thread::Thread m_WriterThread;
+    EA::Thread::Semaphore m_FreeSema{ kSlotCount };
+    EA::Thread::Semaphore m_ReadySema{ 0 };
+
+    const FrameFunc *m_pFrameFunc = nullptr;
+    u32 m_FrameCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "SkyViewBaker.hh"
+
+#include "AtmosphereMath.hh"
+#include "AtmosphereKernels.hh"
+
+using namespace AtmosMath;
+
+void SkyViewBaker::Init(u32 width, u32 height, u32 tileSize)
+{
+    m_LUT.Resize(width, height);
+
+    m_TileSize = eastl::max(tileSize, 1u);
+    m_TileCountX = (width + m_TileSize - 1) / m_TileSize;
+    m_TileCountY = (height + m_TileSize - 1) / m_TileSize;
+}
+
+void SkyViewBaker::Bake(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT,
+                        ThreadPool *pPool)
+{
+    u32 tileCount = m_TileCountX * m_TileCountY;
+
+    if (!pPool)
+    {
+        for (u32 i = 0; i < tileCount; i++) BakeTile(atmos, settings, transmittanceLUT, multiScatterLUT, i);
+        return;
+    }
+
+    pPool->ParallelFor(tileCount, 1, [&](u32 begin, u32 end, u32) {
+        for (u32 i = begin; i < end; i++) BakeTile(atmos, settings, transmittanceLUT, multiScatterLUT, i);
+    });
+}
+
+XMVECTOR SkyViewBaker::CalculateLuminance(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT,
+                                          const LUT2D &multiScatterLUT, XMVECTOR rayDirection)
+{
+    const AtmosKernels &kernels = GetAtmosKernels();
+    const u32 stepCount = settings.StepCount;
+
+    XMVECTOR eyePosition = XMLoadFloat3(&settings.EyePosition);
+    XMVECTOR sunDirection = XMLoadFloat3(&settings.SunDirection);
+
+    // Get Rayleigh + Mie phase
+    float cosTheta = XMVectorGetX(XMVector3Dot(rayDirection, sunDirection));
+    float rayleighPhase = GetRayleighPhase(-cosTheta);
+    float miePhase = GetMiePhase(atmos, cosTheta);
+
+    float maxDist = 0.0f;
+    if (!GetQuadraticIntersection3D(eyePosition, rayDirection, atmos.PlanetRadius, maxDist))
+        GetQuadraticIntersection3D(eyePosition, rayDirection, atmos.AtmosRadius, maxDist);
+
+    /// Gather step positions, density terms are evaluated in batches
+    thread_local eastl::vector<float> scratch;
+    scratch.resize(stepCount * 9);
+
+    float *pAltitude = scratch.data();
+    float *pSunTheta = pAltitude + stepCount;
+    float *pExtinctionR = pSunTheta + stepCount;
+    float *pExtinctionG = pExtinctionR + stepCount;
+    float *pExtinctionB = pExtinctionG + stepCount;
+    float *pRayleighR = pExtinctionB + stepCount;
+    float *pRayleighG = pRayleighR + stepCount;
+    float *pRayleighB = pRayleighG + stepCount;
+    float *pMie = pRayleighB + stepCount;
+
+    float stepSize = maxDist / stepCount;
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        XMVECTOR stepPosition = eyePosition + (stepSize * i) * rayDirection;
+        float h = XMVectorGetX(XMVector3Length(stepPosition));
+
+        pAltitude[i] = h - atmos.PlanetRadius;
+        pSunTheta[i] = XMVectorGetX(XMVector3Dot(sunDirection, stepPosition / h));
+    }
+
+    kernels.ExtinctionSum(atmos, pAltitude, pExtinctionR, pExtinctionG, pExtinctionB, stepCount);
+    kernels.Scattering(atmos, pAltitude, pRayleighR, pRayleighG, pRayleighB, pMie, stepCount);
+
+    // Raymarching
+    XMVECTOR luminance = XMVectorZero();
+    XMVECTOR transmittance = XMVectorReplicate(1.0f);
+
+    float t = 0.0f;
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        float nextT = stepSize * i;
+        float deltaT = nextT - t;
+        t = nextT;
+
+        XMVECTOR extinction = XMVectorSet(pExtinctionR[i], pExtinctionG[i], pExtinctionB[i], 1.0f);
+        XMVECTOR altitudeTrans = XMVectorExpE(extinction * -deltaT);
+
+        // Shadowing factor
+        XMVECTOR sunTrans = SampleLUT(transmittanceLUT, atmos, pAltitude[i], pSunTheta[i]);
+        XMVECTOR MS = SampleLUT(multiScatterLUT, atmos, pAltitude[i], pSunTheta[i]);
+
+        // Molecules scattered on ray's position
+        XMVECTOR rayleighInScat = XMVectorSet(pRayleighR[i], pRayleighG[i], pRayleighB[i], 0.0f) * (XMVectorReplicate(rayleighPhase) + MS);
+        XMVECTOR mieInScat = pMie[i] * (XMVectorReplicate(miePhase) + MS);
+        XMVECTOR scatteringPhase = (rayleighInScat + mieInScat) * sunTrans;
+
+        // https://www.ea.com/frostbite/news/physically-based-unified-volumetric-rendering-in-frostbite
+        // slide 28
+        XMVECTOR integral = (scatteringPhase - scatteringPhase * altitudeTrans) / extinction;
+
+        luminance += settings.SunIntensity * (integral * transmittance);
+        transmittance *= altitudeTrans;
+    }
+
+    return luminance;
+}
+
+XMVECTOR SkyViewBaker::GetRayDirection(const Atmosphere &atmos, XMVECTOR eyePosition, float u, float v)
+{
+    // Non-linear parameterization
+    if (v < 0.5f)
+    {
+        float coord = 1.0f - 2.0f * v;
+        v = coord * coord;
+    }
+    else
+    {
+        float coord = v * 2.0f - 1.0f;
+        v = -coord * coord;
+    }
+
+    float h = XMVectorGetX(XMVector3Length(eyePosition));
+
+    // https://en.wikipedia.org/wiki/Azimuth#/media/File:Azimuth-Altitude_schematic.svg
+    float azimuthAngle = 2.0f * PI * u;  // Consider 360 degrees.
+    float horizonAngle = acosf(sqrtf(h * h - atmos.PlanetRadius * atmos.PlanetRadius) / h) - 0.5f * PI;
+    float altitudeAngle = v * 0.5f * PI - horizonAngle;
+
+    float cosAltitude = cosf(altitudeAngle);
+    return XMVectorSet(cosAltitude * cosf(azimuthAngle), sinf(altitudeAngle), cosAltitude * sinf(azimuthAngle), 0.0f);
+}
+
+void SkyViewBaker::BakeTile(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT,
+                            const LUT2D &multiScatterLUT, u32 tile)
+{
+    u32 beginX = (tile % m_TileCountX) * m_TileSize;
+    u32 beginY = (tile / m_TileCountX) * m_TileSize;
+    u32 endX = eastl::min(beginX + m_TileSize, m_LUT.Width);
+    u32 endY = eastl::min(beginY + m_TileSize, m_LUT.Height);
+
+    // Horizon angle is NaN below the ground, eye is kept 2m above it like the app does
+    SkyViewSettings tileSettings = settings;
+    XMVECTOR eyePosition = XMLoadFloat3(&settings.EyePosition);
+    float eyeHeight = XMVectorGetX(XMVector3Length(eyePosition));
+    float minEyeHeight = atmos.PlanetRadius + 2.0f;
+
+    if (eyeHeight < minEyeHeight)
+    {
+        eyePosition = eyeHeight > 0.0f ? eyePosition * (minEyeHeight / eyeHeight) : XMVectorSet(0.0f, minEyeHeight, 0.0f, 0.0f);
+        XMStoreFloat3(&tileSettings.EyePosition, eyePosition);
+    }
+
+    for (u32 y = beginY; y < endY; y++)
+    {
+        // Full-screen triangle interpolates texcoords at pixel centers
+        float v = (y + 0.5f) / m_LUT.Height;
+
+        for (u32 x = beginX; x < endX; x++)
+        {
+            float u = (x + 0.5f) / m_LUT.Width;
+
+            XMVECTOR rayDirection = GetRayDirection(atmos, eyePosition, u, v);
+            XMVECTOR luminance = CalculateLuminance(atmos, tileSettings, transmittanceLUT, multiScatterLUT, rayDirection);
+
+            XMStoreFloat4(&m_LUT.At(x, y), XMVectorSetW(luminance, 1.0f));
+        }
+    }
+}
\ No newline at end of file
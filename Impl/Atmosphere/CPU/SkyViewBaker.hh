@@ -0,0 +1,61 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+
+struct SkyViewSettings
+{
+    /// In meters like `Atmosphere` after `ToMeters`, defaults to 2m above the ground of the default planet
+    XMFLOAT3 EyePosition = { 0, 6360e3f + 2.0f, 0 };
+    u32 StepCount = 48;
+    XMFLOAT3 SunDirection = { 0, 1, 0 };
+    float SunIntensity = 10;
+};
+
+/// CPU version of `Atmos/LUT.hlsl`, used by headless renderers.
+/// Image is split into tiles that fit in L1/L2, every tile is a job on the thread pool.
+class SkyViewBaker
+{
+public:
+    /// `tileSize` is in texels, 32x32 RGBA32F = 16KB
+    void Init(u32 width, u32 height, u32 tileSize = 32);
+
+    /// Tiles are split across `pPool`, runs on the calling thread if `pPool` is null
+    void Bake(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT,
+              ThreadPool *pPool);
+
+    /// Bakes a single tile, for callers that schedule tiles together with other work
+    void BakeTile(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT, const LUT2D &multiScatterLUT,
+                  u32 tile);
+
+    /// `RaymarchScattering` of `Atmos/Raymarch.hlsl` with `SunIntensity` applied, eye has to be inside the atmosphere
+    static XMVECTOR CalculateLuminance(const Atmosphere &atmos, const SkyViewSettings &settings, const LUT2D &transmittanceLUT,
+                                       const LUT2D &multiScatterLUT, XMVECTOR rayDirection);
+
+    /// Same as `PSMain`'s non-linear latitude parameterization, `uv` is texel center
+    static XMVECTOR GetRayDirection(const Atmosphere &atmos, XMVECTOR eyePosition, float u, float v);
+
+public:
+    LUT2D &GetLUT()
+    {
+        return m_LUT;
+    }
+
+    u32 GetTileCount()
+    {
+        return m_TileCountX * m_TileCountY;
+    }
+
+private:
+    LUT2D m_LUT;
+
+    u32 m_TileSize = 32;
+    u32 m_TileCountX = 0;
+    u32 m_TileCountY = 0;
+};
\ No newline at end of file
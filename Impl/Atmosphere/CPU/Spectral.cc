@@ -0,0 +1,535 @@
+#include "Spectral.hh"
+
+#include "AtmosphereMath.hh"
+
+using namespace AtmosMath;
+
+/// Tables below are from 360 to 830 nm in 10 nm steps, same data as Bruneton's precomputed atmospheric scattering demo
+static constexpr float kTableMinWavelength = 360.0f;
+static constexpr float kTableStep = 10.0f;
+static constexpr u32 kTableSize = 48;
+
+// Solar irradiance at the top of the atmosphere, W/m^2/nm
+static constexpr float kSolarIrradiance[kTableSize] = {
+    1.11776f, 1.14259f, 1.01249f, 1.14716f, 1.72765f, 1.73054f, 1.6887f,  1.61253f, 1.91198f, 2.03474f, 2.02042f, 2.02212f,
+    1.93377f, 1.95809f, 1.91686f, 1.8298f,  1.8685f,  1.8931f,  1.85149f, 1.8504f,  1.8341f,  1.8345f,  1.8147f,  1.78158f,
+    1.7533f,  1.6965f,  1.68194f, 1.64654f, 1.6048f,  1.52143f, 1.55622f, 1.5113f,  1.474f,   1.4482f,  1.41018f, 1.36775f,
+    1.34188f, 1.31429f, 1.28303f, 1.26758f, 1.2367f,  1.2082f,  1.18737f, 1.14683f, 1.12362f, 1.1058f,  1.07124f, 1.04992f,
+};
+
+// Ozone absorption cross section, m^2/molecule
+static constexpr float kOzoneCrossSection[kTableSize] = {
+    1.18e-27f,  2.182e-28f, 2.818e-28f, 6.636e-28f, 1.527e-27f, 2.763e-27f, 5.52e-27f,  8.451e-27f, 1.582e-26f, 2.316e-26f,
+    3.669e-26f, 4.924e-26f, 7.752e-26f, 9.016e-26f, 1.48e-25f,  1.602e-25f, 2.139e-25f, 2.755e-25f, 3.091e-25f, 3.5e-25f,
+    4.266e-25f, 4.672e-25f, 4.398e-25f, 4.701e-25f, 5.019e-25f, 4.305e-25f, 3.74e-25f,  3.215e-25f, 2.662e-25f, 2.238e-25f,
+    1.852e-25f, 1.473e-25f, 1.209e-25f, 9.423e-26f, 7.455e-26f, 6.566e-26f, 5.105e-26f, 4.15e-26f,  4.228e-26f, 3.237e-26f,
+    2.451e-26f, 2.801e-26f, 2.534e-26f, 1.624e-26f, 1.465e-26f, 2.078e-26f, 1.383e-26f, 7.105e-27f,
+};
+
+static constexpr float kMinWavelength = 380.0f;
+static constexpr float kMaxWavelength = 780.0f;
+static constexpr float kReferenceWavelength = 550.0f;  // green channel of `Atmosphere`
+
+static float SampleTable(const float *pTable, float wavelength)
+{
+    float x = bx::clamp((wavelength - kTableMinWavelength) / kTableStep, 0.0f, kTableSize - 1.0f);
+    u32 index = eastl::min((u32)x, kTableSize - 2);
+
+    float frac = x - index;
+    return pTable[index] * (1.0f - frac) + pTable[index + 1] * frac;
+}
+
+static float GetPiecewiseGaussian(float x, float mean, float sigmaLow, float sigmaHigh)
+{
+    float t = (x - mean) / (x < mean ? sigmaLow : sigmaHigh);
+    return expf(-0.5f * t * t);
+}
+
+// Multi-lobe fit of the CIE 1931 2 degree observer
+// https://jcgt.org/published/0002/02/01/
+static XMFLOAT3 GetCIE1931(float wavelength)
+{
+    XMFLOAT3 xyz;
+    xyz.x = 1.056f * GetPiecewiseGaussian(wavelength, 599.8f, 37.9f, 31.0f) + 0.362f * GetPiecewiseGaussian(wavelength, 442.0f, 16.0f, 26.7f)
+            - 0.065f * GetPiecewiseGaussian(wavelength, 501.1f, 20.4f, 26.2f);
+    xyz.y = 0.821f * GetPiecewiseGaussian(wavelength, 568.8f, 46.9f, 40.5f) + 0.286f * GetPiecewiseGaussian(wavelength, 530.9f, 16.3f, 31.1f);
+    xyz.z = 1.217f * GetPiecewiseGaussian(wavelength, 437.0f, 11.8f, 36.0f) + 0.681f * GetPiecewiseGaussian(wavelength, 459.0f, 26.0f, 13.8f);
+
+    return xyz;
+}
+
+static XMFLOAT3 XYZToLinearSRGB(const XMFLOAT3 &xyz)
+{
+    return XMFLOAT3(3.2404542f * xyz.x - 1.5371385f * xyz.y - 0.4985314f * xyz.z,
+                    -0.9692660f * xyz.x + 1.8760108f * xyz.y + 0.0415560f * xyz.z,
+                    0.0556434f * xyz.x - 0.2040259f * xyz.y + 1.0572252f * xyz.z);
+}
+
+void SpectralAtmosphere::Init(const Atmosphere &atmos, u32 binCount)
+{
+    GroupCount = bx::clamp((binCount + kSpectralBinsPerGroup - 1) / kSpectralBinsPerGroup, 1u, kMaxSpectralGroups);
+    BinCount = GroupCount * kSpectralBinsPerGroup;
+
+    if (BinCount != binCount) LOG_WARN("Spectral atmosphere takes multiples of 4 bins up to {}, using {} instead of {}.", kMaxSpectralBins, BinCount, binCount);
+
+    Base = atmos;
+
+    float binWidth = (kMaxWavelength - kMinWavelength) / BinCount;
+    float ozoneDensity = atmos.OzoneAbsorption.y / SampleTable(kOzoneCrossSection, kReferenceWavelength);
+
+    XMFLOAT3 white = { 0.0f, 0.0f, 0.0f };
+
+    for (u32 i = 0; i < BinCount; i++)
+    {
+        float wavelength = kMinWavelength + (i + 0.5f) * binWidth;
+        float rayleighRatio = kReferenceWavelength / wavelength;
+
+        Wavelengths[i] = wavelength;
+        RayleighScatter[i] = atmos.RayleighScatterVal.y * rayleighRatio * rayleighRatio * rayleighRatio * rayleighRatio;
+        OzoneAbsorption[i] = SampleTable(kOzoneCrossSection, wavelength) * ozoneDensity;
+        SolarIrradiance[i] = SampleTable(kSolarIrradiance, wavelength);
+
+        XMFLOAT3 rgb = XYZToLinearSRGB(GetCIE1931(wavelength));
+        float weight = SolarIrradiance[i] * binWidth;
+
+        ToRed[i] = rgb.x * weight;
+        ToGreen[i] = rgb.y * weight;
+        ToBlue[i] = rgb.z * weight;
+
+        white.x += ToRed[i];
+        white.y += ToGreen[i];
+        white.z += ToBlue[i];
+    }
+
+    for (u32 i = 0; i < BinCount; i++)
+    {
+        ToRed[i] /= white.x;
+        ToGreen[i] /= white.y;
+        ToBlue[i] /= white.z;
+    }
+}
+
+XMVECTOR SpectralAtmosphere::ToRGB(const float *pSpectrum) const
+{
+    XMVECTOR red = XMVectorZero();
+    XMVECTOR green = XMVectorZero();
+    XMVECTOR blue = XMVectorZero();
+
+    for (u32 i = 0; i < BinCount; i += kSpectralBinsPerGroup)
+    {
+        XMVECTOR spectrum = XMLoadFloat4((const XMFLOAT4 *)&pSpectrum[i]);
+
+        red += spectrum * XMLoadFloat4((const XMFLOAT4 *)&ToRed[i]);
+        green += spectrum * XMLoadFloat4((const XMFLOAT4 *)&ToGreen[i]);
+        blue += spectrum * XMLoadFloat4((const XMFLOAT4 *)&ToBlue[i]);
+    }
+
+    XMVECTOR rgb = XMVectorSet(XMVectorGetX(XMVectorSum(red)), XMVectorGetX(XMVectorSum(green)), XMVectorGetX(XMVectorSum(blue)), 0.0f);
+    return XMVectorMax(rgb, XMVectorZero());
+}
+
+void SpectralLUT2D::Resize(u32 width, u32 height, u32 binCount)
+{
+    Width = width;
+    Height = height;
+    BinCount = binCount;
+    GroupCount = (binCount + kSpectralBinsPerGroup - 1) / kSpectralBinsPerGroup;
+
+    Data.resize(width * height * GroupCount * kSpectralBinsPerGroup);
+}
+
+void SpectralLUT2D::Sample(float u, float v, XMVECTOR *pOutput) const
+{
+    float x = u * Width - 0.5f;
+    float y = v * Height - 0.5f;
+
+    float floorX = floorf(x);
+    float floorY = floorf(y);
+
+    float fracX = x - floorX;
+    float fracY = y - floorY;
+
+    i32 x0 = bx::clamp((i32)floorX, 0, (i32)Width - 1);
+    i32 y0 = bx::clamp((i32)floorY, 0, (i32)Height - 1);
+    i32 x1 = bx::clamp((i32)floorX + 1, 0, (i32)Width - 1);
+    i32 y1 = bx::clamp((i32)floorY + 1, 0, (i32)Height - 1);
+
+    const XMFLOAT4 *p00 = (const XMFLOAT4 *)At(x0, y0);
+    const XMFLOAT4 *p10 = (const XMFLOAT4 *)At(x1, y0);
+    const XMFLOAT4 *p01 = (const XMFLOAT4 *)At(x0, y1);
+    const XMFLOAT4 *p11 = (const XMFLOAT4 *)At(x1, y1);
+
+    for (u32 i = 0; i < GroupCount; i++)
+    {
+        XMVECTOR top = XMVectorLerp(XMLoadFloat4(&p00[i]), XMLoadFloat4(&p10[i]), fracX);
+        XMVECTOR bottom = XMVectorLerp(XMLoadFloat4(&p01[i]), XMLoadFloat4(&p11[i]), fracX);
+
+        pOutput[i] = XMVectorLerp(top, bottom, fracY);
+    }
+}
+
+void SpectralLUT2D::ToRGB(const SpectralAtmosphere &atmos, LUT2D &output) const
+{
+    output.Resize(Width, Height);
+
+    for (u32 y = 0; y < Height; y++)
+    {
+        for (u32 x = 0; x < Width; x++) XMStoreFloat4(&output.At(x, y), XMVectorSetW(atmos.ToRGB(At(x, y)), 1.0f));
+    }
+}
+
+struct LayerDensity
+{
+    float Rayleigh;
+    float Mie;
+    float Ozone;
+};
+
+static LayerDensity GetLayerDensity(const Atmosphere &atmos, float altitude)
+{
+    LayerDensity density;
+    density.Rayleigh = expf(-altitude / atmos.RayleighDensity);
+    density.Mie = expf(-altitude / atmos.MieDensity);
+    density.Ozone = bx::max(0.0f, 1.0f - fabsf(altitude - atmos.OzoneHeight) / atmos.OzoneThickness);
+
+    return density;
+}
+
+static void SampleLUT(const SpectralLUT2D &lut, const Atmosphere &atmos, float altitude, float theta, XMVECTOR *pOutput)
+{
+    float u = 0.5f + 0.5f * theta;
+    float v = bx::clamp(altitude / (atmos.AtmosRadius - atmos.PlanetRadius), 0.0f, 1.0f);
+
+    lut.Sample(u, v, pOutput);
+}
+
+/// Distance to the ground or the top of the atmosphere, true if it's the ground.
+/// `GetQuadraticIntersection3D` takes the far root for origins on the surface, which would march through the planet.
+static bool GetMarchDistance(const Atmosphere &atmos, XMVECTOR origin, XMVECTOR direction, float &distance)
+{
+    float height = XMVectorGetX(XMVector3Length(origin));
+    if (height <= atmos.PlanetRadius && XMVectorGetX(XMVector3Dot(origin, direction)) < 0.0f)
+    {
+        distance = 0.0f;
+        return true;
+    }
+
+    if (GetQuadraticIntersection3D(origin, direction, atmos.PlanetRadius, distance)) return true;
+
+    GetQuadraticIntersection3D(origin, direction, atmos.AtmosRadius, distance);
+    return false;
+}
+
+/// Everything a ray march needs at one step, group `i` covers bins [4i, 4i + 4)
+struct SpectralStep
+{
+    void Init(const SpectralAtmosphere &atmos, const LayerDensity &density, u32 group)
+    {
+        const Atmosphere &base = atmos.Base;
+        u32 bin = group * kSpectralBinsPerGroup;
+
+        XMVECTOR rayleighScatter = XMLoadFloat4((const XMFLOAT4 *)&atmos.RayleighScatter[bin]);
+        XMVECTOR ozoneAbsorption = XMLoadFloat4((const XMFLOAT4 *)&atmos.OzoneAbsorption[bin]);
+
+        Rayleigh = rayleighScatter * density.Rayleigh;
+        Mie = XMVectorReplicate(base.MieScatterVal * density.Mie);
+        Extinction = Rayleigh + XMVectorReplicate((base.MieScatterVal + base.MieAbsorptionVal) * density.Mie) + ozoneAbsorption * density.Ozone;
+    }
+
+    XMVECTOR Rayleigh;
+    XMVECTOR Mie;
+    XMVECTOR Extinction;
+};
+
+void SpectralBaker::Init(const SpectralBakeSettings &settings)
+{
+    m_Settings = settings;
+    m_SkyView.Resize(settings.SkyViewSize.x, settings.SkyViewSize.y);
+}
+
+void SpectralBaker::Bake(const Atmosphere &atmos, const XMFLOAT2 *pSamples, u32 sampleCount, ThreadPool *pPool)
+{
+    m_Atmos.Init(atmos, m_Settings.BinCount);
+
+    m_Transmittance.Resize(m_Settings.TransmittanceSize.x, m_Settings.TransmittanceSize.y, m_Atmos.BinCount);
+    m_MultiScatter.Resize(m_Settings.MultiScatterSize.x, m_Settings.MultiScatterSize.y, m_Atmos.BinCount);
+
+    BakeTransmittance(pPool);
+    BakeMultiScatter(pSamples, sampleCount, pPool);
+    BakeSkyView(m_Settings.SkyView, pPool);
+}
+
+void SpectralBaker::BakeTransmittance(ThreadPool *pPool)
+{
+    const Atmosphere &atmos = m_Atmos.Base;
+
+    auto bakeRows = [&](u32 begin, u32 end, u32) {
+        for (u32 y = begin; y < end; y++)
+        {
+            float v = (float)y / m_Transmittance.Height;
+            float h = atmos.PlanetRadius + (atmos.AtmosRadius - atmos.PlanetRadius) * v;
+            XMVECTOR rayPos = XMVectorSet(0.0f, h, 0.0f, 0.0f);
+
+            for (u32 x = 0; x < m_Transmittance.Width; x++)
+            {
+                float u = (float)x / m_Transmittance.Width;
+
+                float sunCosTheta = 2.0f * u - 1.0f;
+                XMVECTOR sunDir = XMVectorSet(0.0f, sunCosTheta, sinf(acosf(sunCosTheta)), 0.0f);
+
+                IntegrateTransmittance(rayPos, sunDir, m_Transmittance.At(x, y));
+            }
+        }
+    };
+
+    if (pPool)
+        pPool->ParallelFor(m_Transmittance.Height, 1, bakeRows);
+    else
+        bakeRows(0, m_Transmittance.Height, 0);
+}
+
+void SpectralBaker::BakeMultiScatter(const XMFLOAT2 *pSamples, u32 sampleCount, ThreadPool *pPool)
+{
+    auto bakeTexels = [&](u32 begin, u32 end, u32) {
+        for (u32 i = begin; i < end; i++)
+        {
+            u32 x = i % m_MultiScatter.Width;
+            u32 y = i / m_MultiScatter.Width;
+
+            IntegrateMultiScatter(x, y, pSamples, sampleCount, m_MultiScatter.At(x, y));
+        }
+    };
+
+    u32 texelCount = m_MultiScatter.Width * m_MultiScatter.Height;
+
+    if (pPool)
+        pPool->ParallelFor(texelCount, 4, bakeTexels);
+    else
+        bakeTexels(0, texelCount, 0);
+}
+
+void SpectralBaker::BakeSkyView(const SkyViewSettings &settings, ThreadPool *pPool)
+{
+    XMVECTOR eyePosition = XMLoadFloat3(&settings.EyePosition);
+
+    auto bakeRows = [&](u32 begin, u32 end, u32) {
+        float spectrum[kMaxSpectralBins];
+
+        for (u32 y = begin; y < end; y++)
+        {
+            float v = (y + 0.5f) / m_SkyView.Height;
+
+            for (u32 x = 0; x < m_SkyView.Width; x++)
+            {
+                float u = (x + 0.5f) / m_SkyView.Width;
+
+                XMVECTOR rayDir = SkyViewBaker::GetRayDirection(m_Atmos.Base, eyePosition, u, v);
+                IntegrateSkyView(settings, rayDir, spectrum);
+
+                XMVECTOR luminance = settings.SunIntensity * m_Atmos.ToRGB(spectrum);
+                XMStoreFloat4(&m_SkyView.At(x, y), XMVectorSetW(luminance, 1.0f));
+            }
+        }
+    };
+
+    if (pPool)
+        pPool->ParallelFor(m_SkyView.Height, 1, bakeRows);
+    else
+        bakeRows(0, m_SkyView.Height, 0);
+}
+
+void SpectralBaker::IntegrateTransmittance(XMVECTOR rayPos, XMVECTOR sunDir, float *pOutput)
+{
+    const Atmosphere &atmos = m_Atmos.Base;
+
+    if (SolveQuadratic(rayPos, sunDir, atmos.PlanetRadius))
+    {
+        memset(pOutput, 0, m_Atmos.BinCount * sizeof(float));
+        return;
+    }
+
+    float distance = 0.0f;
+    GetQuadraticIntersection3D(rayPos, sunDir, atmos.AtmosRadius, distance);
+
+    // Density integrals don't depend on the wavelength, bins only scale them
+    const u32 stepCount = m_Settings.TransmittanceStepCount;
+    float stepSize = distance / stepCount;
+
+    LayerDensity total = { 0.0f, 0.0f, 0.0f };
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        XMVECTOR position = rayPos + ((i + 0.5f) * stepSize) * sunDir;
+        LayerDensity density = GetLayerDensity(atmos, XMVectorGetX(XMVector3Length(position)) - atmos.PlanetRadius);
+
+        total.Rayleigh += density.Rayleigh * stepSize;
+        total.Mie += density.Mie * stepSize;
+        total.Ozone += density.Ozone * stepSize;
+    }
+
+    for (u32 i = 0; i < m_Atmos.GroupCount; i++)
+    {
+        SpectralStep step;
+        step.Init(m_Atmos, total, i);
+
+        XMStoreFloat4((XMFLOAT4 *)&pOutput[i * kSpectralBinsPerGroup], XMVectorExpE(-step.Extinction));
+    }
+}
+
+void SpectralBaker::IntegrateMultiScatter(u32 x, u32 y, const XMFLOAT2 *pSamples, u32 sampleCount, float *pOutput)
+{
+    const Atmosphere &atmos = m_Atmos.Base;
+    const u32 groupCount = m_Atmos.GroupCount;
+    const u32 stepCount = m_Settings.MultiScatterStepCount;
+
+    // Same texel mapping as `MultiScatterBaker`
+    float u = (float)x / m_MultiScatter.Width;
+    float v = (float)y / m_MultiScatter.Height;
+
+    float h = atmos.PlanetRadius + (atmos.AtmosRadius - atmos.PlanetRadius) * v;
+    XMVECTOR rayPos = XMVectorSet(0.0f, h, 0.0f, 0.0f);
+
+    float sunCosTheta = 2.0f * u - 1.0f;
+    XMVECTOR sunDir = XMVectorSet(0.0f, sunCosTheta, sinf(acosf(sunCosTheta)), 0.0f);
+
+    XMVECTOR totalL2[kMaxSpectralGroups];
+    XMVECTOR totalFms[kMaxSpectralGroups];
+    XMVECTOR sunTrans[kMaxSpectralGroups];
+
+    for (u32 i = 0; i < groupCount; i++) totalL2[i] = totalFms[i] = XMVectorZero();
+
+    for (u32 sample = 0; sample < sampleCount; sample++)
+    {
+        // Uniform sphere direction, see `GetUniformSphereSample`
+        float dirX = 1.0f - 2.0f * pSamples[sample].x;
+        float radius = sqrtf(bx::max(0.0f, 1.0f - dirX * dirX));
+        float phi = 2.0f * PI * pSamples[sample].y;
+        XMVECTOR sampleDir = XMVectorSet(radius * cosf(phi), radius * sinf(phi), dirX, 0.0f);
+
+        float maxDist = 0.0f;
+        bool planetHit = GetMarchDistance(atmos, rayPos, sampleDir, maxDist);
+
+        float cosTheta = XMVectorGetX(XMVector3Dot(sampleDir, sunDir));
+        XMVECTOR rayleighPhase = XMVectorReplicate(GetRayleighPhase(-cosTheta));
+        XMVECTOR miePhase = XMVectorReplicate(GetMiePhase(atmos, cosTheta));
+
+        XMVECTOR L2[kMaxSpectralGroups];
+        XMVECTOR Fms[kMaxSpectralGroups];
+        XMVECTOR transmittance[kMaxSpectralGroups];
+
+        for (u32 i = 0; i < groupCount; i++)
+        {
+            L2[i] = Fms[i] = XMVectorZero();
+            transmittance[i] = XMVectorReplicate(1.0f);
+        }
+
+        float stepSize = maxDist / stepCount;
+        for (u32 s = 0; s < stepCount; s++)
+        {
+            XMVECTOR stepPosition = rayPos + ((s + 0.5f) * stepSize) * sampleDir;
+            float stepHeight = XMVectorGetX(XMVector3Length(stepPosition));
+
+            float altitude = stepHeight - atmos.PlanetRadius;
+            float sunTheta = XMVectorGetX(XMVector3Dot(sunDir, stepPosition / stepHeight));
+
+            LayerDensity density = GetLayerDensity(atmos, altitude);
+            SampleLUT(m_Transmittance, atmos, altitude, sunTheta, sunTrans);
+
+            for (u32 i = 0; i < groupCount; i++)
+            {
+                SpectralStep step;
+                step.Init(m_Atmos, density, i);
+
+                XMVECTOR stepTrans = XMVectorExpE(step.Extinction * -stepSize);
+                XMVECTOR integral = (XMVectorReplicate(1.0f) - stepTrans) / step.Extinction * transmittance[i];
+
+                L2[i] += (step.Rayleigh * rayleighPhase + step.Mie * miePhase) * sunTrans[i] * integral;
+                Fms[i] += (step.Rayleigh + step.Mie) * integral;
+                transmittance[i] *= stepTrans;
+            }
+        }
+
+        if (planetHit)
+        {
+            XMVECTOR intersectPos = rayPos + maxDist * sampleDir;
+
+            float groundHeight = XMVectorGetX(XMVector3Length(intersectPos));
+            XMVECTOR up = intersectPos / groundHeight;
+
+            float theta = XMVectorGetX(XMVector3Dot(sunDir, up));
+            SampleLUT(m_Transmittance, atmos, groundHeight - atmos.PlanetRadius, theta, sunTrans);
+
+            float lightTheta = bx::clamp(theta, 0.0f, 1.0f);
+            for (u32 i = 0; i < groupCount; i++) L2[i] += sunTrans[i] * transmittance[i] * (lightTheta * m_Settings.TerrainAlbedo / PI);
+        }
+
+        for (u32 i = 0; i < groupCount; i++)
+        {
+            totalL2[i] += L2[i];
+            totalFms[i] += Fms[i];
+        }
+    }
+
+    for (u32 i = 0; i < groupCount; i++)
+    {
+        XMVECTOR L2 = totalL2[i] / (float)sampleCount;
+        XMVECTOR Fms = totalFms[i] / (float)sampleCount;
+
+        XMStoreFloat4((XMFLOAT4 *)&pOutput[i * kSpectralBinsPerGroup], L2 / (XMVectorReplicate(1.0f) - Fms));
+    }
+}
+
+void SpectralBaker::IntegrateSkyView(const SkyViewSettings &settings, XMVECTOR rayDir, float *pOutput)
+{
+    const Atmosphere &atmos = m_Atmos.Base;
+    const u32 groupCount = m_Atmos.GroupCount;
+    const u32 stepCount = settings.StepCount;
+
+    XMVECTOR eyePosition = XMLoadFloat3(&settings.EyePosition);
+    XMVECTOR sunDir = XMLoadFloat3(&settings.SunDirection);
+
+    float cosTheta = XMVectorGetX(XMVector3Dot(rayDir, sunDir));
+    XMVECTOR rayleighPhase = XMVectorReplicate(GetRayleighPhase(-cosTheta));
+    XMVECTOR miePhase = XMVectorReplicate(GetMiePhase(atmos, cosTheta));
+
+    float maxDist = 0.0f;
+    GetMarchDistance(atmos, eyePosition, rayDir, maxDist);
+
+    XMVECTOR luminance[kMaxSpectralGroups];
+    XMVECTOR transmittance[kMaxSpectralGroups];
+    XMVECTOR sunTrans[kMaxSpectralGroups];
+    XMVECTOR MS[kMaxSpectralGroups];
+
+    for (u32 i = 0; i < groupCount; i++)
+    {
+        luminance[i] = XMVectorZero();
+        transmittance[i] = XMVectorReplicate(1.0f);
+    }
+
+    float stepSize = maxDist / stepCount;
+    for (u32 s = 0; s < stepCount; s++)
+    {
+        XMVECTOR stepPosition = eyePosition + ((s + 0.5f) * stepSize) * rayDir;
+        float h = XMVectorGetX(XMVector3Length(stepPosition));
+
+        float altitude = h - atmos.PlanetRadius;
+        float sunTheta = XMVectorGetX(XMVector3Dot(sunDir, stepPosition / h));
+
+        LayerDensity density = GetLayerDensity(atmos, altitude);
+        SampleLUT(m_Transmittance, atmos, altitude, sunTheta, sunTrans);
+        SampleLUT(m_MultiScatter, atmos, altitude, sunTheta, MS);
+
+        for (u32 i = 0; i < groupCount; i++)
+        {
+            SpectralStep step;
+            step.Init(m_Atmos, density, i);
+
+            XMVECTOR stepTrans = XMVectorExpE(step.Extinction * -stepSize);
+            XMVECTOR inScattering = (step.Rayleigh * (rayleighPhase + MS[i]) + step.Mie * (miePhase + MS[i])) * sunTrans[i];
+
+            luminance[i] += inScattering * (XMVectorReplicate(1.0f) - stepTrans) / step.Extinction * transmittance[i];
+            transmittance[i] *= stepTrans;
+        }
+    }
+
+    for (u32 i = 0; i < groupCount; i++) XMStoreFloat4((XMFLOAT4 *)&pOutput[i * kSpectralBinsPerGroup], luminance[i]);
+}
\ No newline at end of file
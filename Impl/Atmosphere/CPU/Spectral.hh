@@ -0,0 +1,144 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+#include "SkyViewBaker.hh"
+
+/// Wavelength bins are integrated 4 at a time, one bin per XMVECTOR lane
+constexpr u32 kMaxSpectralBins = 32;
+constexpr u32 kSpectralBinsPerGroup = 4;
+constexpr u32 kMaxSpectralGroups = kMaxSpectralBins / kSpectralBinsPerGroup;
+
+/// `Atmosphere` resampled to `BinCount` equal width bins over [380, 780] nm.
+/// Only the green (`.y`) RGB coefficients are used, taken as 550 nm, red and blue are ignored. Rayleigh follows
+/// lambda^-4 from it, ozone follows its measured cross section scaled to it and Mie keeps its scalar values.
+struct SpectralAtmosphere
+{
+    /// `binCount` is rounded up to a multiple of 4 and clamped to `kMaxSpectralBins`
+    void Init(const Atmosphere &atmos, u32 binCount);
+
+    /// CIE 1931 -> linear sRGB of a `BinCount` spectrum lit by a unit sun.
+    /// Low sun horizons are more saturated than sRGB can hold, negative components are clamped to 0.
+    XMVECTOR ToRGB(const float *pSpectrum) const;
+
+    /// Geometry, density profiles, Mie and ozone layer parameters
+    Atmosphere Base;
+
+    u32 BinCount = 0;
+    u32 GroupCount = 0;
+
+    float Wavelengths[kMaxSpectralBins] = {};  // nm, bin centers
+    float RayleighScatter[kMaxSpectralBins] = {};
+    float OzoneAbsorption[kMaxSpectralBins] = {};
+    float SolarIrradiance[kMaxSpectralBins] = {};  // W/m^2/nm at the top of the atmosphere
+
+    /// Per bin weights of `ToRGB`, solar spectrum and bin width included. White balanced to the sun so
+    /// a flat spectrum comes out as (1, 1, 1) and results stay comparable to the RGB integrators.
+    float ToRed[kMaxSpectralBins] = {};
+    float ToGreen[kMaxSpectralBins] = {};
+    float ToBlue[kMaxSpectralBins] = {};
+};
+
+/// `BinCount` floats per texel, padded to whole groups
+struct SpectralLUT2D
+{
+    void Resize(u32 width, u32 height, u32 binCount);
+
+    /// Bilinear, clamped to edge like `LUT2D::Sample`. `pOutput` holds `GroupCount` vectors.
+    void Sample(float u, float v, XMVECTOR *pOutput) const;
+
+    /// Every texel through `SpectralAtmosphere::ToRGB`
+    void ToRGB(const SpectralAtmosphere &atmos, LUT2D &output) const;
+
+    float *At(u32 x, u32 y)
+    {
+        return &Data[(y * Width + x) * GroupCount * kSpectralBinsPerGroup];
+    }
+
+    const float *At(u32 x, u32 y) const
+    {
+        return &Data[(y * Width + x) * GroupCount * kSpectralBinsPerGroup];
+    }
+
+    u32 Width = 0;
+    u32 Height = 0;
+    u32 BinCount = 0;
+    u32 GroupCount = 0;
+
+    eastl::vector<float> Data;
+};
+
+struct SpectralBakeSettings
+{
+    u32 BinCount = 16;
+
+    XMUINT2 TransmittanceSize = { 256, 64 };
+    u32 TransmittanceStepCount = 256;
+
+    XMUINT2 MultiScatterSize = { 32, 32 };
+    u32 MultiScatterStepCount = 64;
+    float TerrainAlbedo = 0.3f;
+
+    XMUINT2 SkyViewSize = { 200, 100 };
+    SkyViewSettings SkyView;
+};
+
+/// Spectral version of the transmittance -> MS -> sky-view chain, for validating the RGB bakes.
+/// Same parameterizations as the RGB bakers so LUTs line up texel for texel, but none of the shader
+/// quirks: steps are sampled at their midpoints, every MS sample is integrated and Mie scattering doesn't
+/// include Mie absorption. Sky-view is converted to RGB at the end, intermediate LUTs stay spectral.
+class SpectralBaker
+{
+public:
+    void Init(const SpectralBakeSettings &settings);
+
+    /// Whole chain with `SpectralBakeSettings::SkyView`, `pSamples` are the MS directions like `MultiScatterBaker::Bake`
+    /// takes them. Rows/texels of each stage are split across `pPool`, runs on the calling thread if `pPool` is null.
+    void Bake(const Atmosphere &atmos, const XMFLOAT2 *pSamples, u32 sampleCount, ThreadPool *pPool);
+
+    /// Transmittance and MS don't depend on the sun or the eye, sweeps only need to redo the sky-view
+    void BakeSkyView(const SkyViewSettings &settings, ThreadPool *pPool);
+
+public:
+    const SpectralAtmosphere &GetAtmosphere()
+    {
+        return m_Atmos;
+    }
+
+    SpectralLUT2D &GetTransmittanceLUT()
+    {
+        return m_Transmittance;
+    }
+
+    SpectralLUT2D &GetMultiScatterLUT()
+    {
+        return m_MultiScatter;
+    }
+
+    /// Linear sRGB, `SkyViewSettings::SunIntensity` applied
+    LUT2D &GetSkyViewLUT()
+    {
+        return m_SkyView;
+    }
+
+private:
+    void BakeTransmittance(ThreadPool *pPool);
+    void BakeMultiScatter(const XMFLOAT2 *pSamples, u32 sampleCount, ThreadPool *pPool);
+
+    void IntegrateTransmittance(XMVECTOR rayPos, XMVECTOR sunDir, float *pOutput);
+    void IntegrateMultiScatter(u32 x, u32 y, const XMFLOAT2 *pSamples, u32 sampleCount, float *pOutput);
+    void IntegrateSkyView(const SkyViewSettings &settings, XMVECTOR rayDir, float *pOutput);
+
+    SpectralBakeSettings m_Settings;
+    SpectralAtmosphere m_Atmos;
+
+    SpectralLUT2D m_Transmittance;
+    SpectralLUT2D m_MultiScatter;
+    LUT2D m_SkyView;
+};
\ No newline at end of file
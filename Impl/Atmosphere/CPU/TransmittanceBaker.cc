@@ -0,0 +1,121 @@
+#include "TransmittanceBaker.hh"
+
+#include "AtmosphereMath.hh"
+#include "AtmosphereKernels.hh"
+
+using namespace AtmosMath;
+
+void TransmittanceBaker::Init(u32 width, u32 height, const IntegratorSettings &settings)
+{
+    m_LUT.Resize(width, height);
+    m_Settings = settings;
+}
+
+void TransmittanceBaker::Bake(const Atmosphere &atmos, ThreadPool *pPool)
+{
+    m_SampleCount = 0;
+
+    if (!pPool)
+    {
+        BakeRows(atmos, 0, m_LUT.Height);
+        return;
+    }
+
+    pPool->ParallelFor(m_LUT.Height, 1, [&](u32 begin, u32 end, u32) {
+        BakeRows(atmos, begin, end);
+    });
+}
+
+// https://cs.dartmouth.edu/wjarosz/publications/novak14residual.pdf
+XMVECTOR TransmittanceBaker::CalculateTransmittance(const Atmosphere &atmos, XMVECTOR rayPosition, XMVECTOR sunDirection, u32 *pSampleCount)
+{
+    if (pSampleCount) *pSampleCount = 0;
+
+    // We need to check if ray hits planet first.
+    if (SolveQuadratic(rayPosition, sunDirection, atmos.PlanetRadius))
+    {
+        return XMVectorZero();
+    }
+
+    float distance = 0.0f;
+    GetQuadraticIntersection3D(rayPosition, sunDirection, atmos.AtmosRadius, distance);
+
+    if (m_Settings.Mode == IntegratorMode::Chapman)
+    {
+        if (pSampleCount) *pSampleCount = 1;
+        return XMVectorExpE(-OpticalDepth::Chapman(atmos, rayPosition, sunDirection));
+    }
+
+    if (m_Settings.Mode == IntegratorMode::Adaptive)
+    {
+        XMVECTOR opticalDepth = OpticalDepth::IntegrateAdaptive(atmos, rayPosition, sunDirection, distance, m_Settings, pSampleCount);
+        return XMVectorExpE(-opticalDepth);
+    }
+
+    if (pSampleCount) *pSampleCount = m_Settings.StepCount;
+
+    return IntegrateUniform(atmos, rayPosition, sunDirection, distance);
+}
+
+XMVECTOR TransmittanceBaker::IntegrateUniform(const Atmosphere &atmos, XMVECTOR rayPosition, XMVECTOR sunDirection, float distance)
+{
+    const u32 stepCount = m_Settings.StepCount;
+    float distancePerStep = distance / stepCount;
+
+    // Shader offsets every step by 0.3m on each axis, keep it so LUTs match
+    XMFLOAT3 position, stepOffset;
+    XMStoreFloat3(&position, rayPosition);
+    XMStoreFloat3(&stepOffset, sunDirection * distancePerStep + XMVectorReplicate(0.3f));
+
+    // Gather altitudes first, extinction is evaluated in batches
+    thread_local eastl::vector<float> altitudes;
+    altitudes.resize(stepCount);
+
+    for (u32 i = 0; i < stepCount; i++)
+    {
+        position.x += stepOffset.x;
+        position.y += stepOffset.y;
+        position.z += stepOffset.z;
+
+        altitudes[i] = sqrtf(position.x * position.x + position.y * position.y + position.z * position.z) - atmos.PlanetRadius;
+    }
+
+    XMFLOAT3 transmittance = { 0.0f, 0.0f, 0.0f };
+    GetAtmosKernels().ExtinctionSumTotal(atmos, altitudes.data(), &transmittance.x, stepCount);
+
+    // transmittance = extinction coefficient
+    return XMVectorExpE(XMLoadFloat3(&transmittance) * -distancePerStep);  // equation 1 from jnovak
+}
+
+void TransmittanceBaker::BakeRows(const Atmosphere &atmos, u32 begin, u32 end)
+{
+    BakeTexels(atmos, begin * m_LUT.Width, end * m_LUT.Width);
+}
+
+void TransmittanceBaker::BakeTexels(const Atmosphere &atmos, u32 begin, u32 end)
+{
+    u64 totalSampleCount = 0;
+
+    for (u32 i = begin; i < end; i++)
+    {
+        u32 x = i % m_LUT.Width;
+        u32 y = i / m_LUT.Width;
+
+        float v = (float)y / m_LUT.Height;
+        float h = atmos.PlanetRadius + (atmos.AtmosRadius - atmos.PlanetRadius) * v;
+        XMVECTOR rayPosition = XMVectorSet(0.0f, h, 0.0f, 0.0f);
+
+        float u = (float)x / m_LUT.Width;
+
+        // https://www.desmos.com/calculator/guspypmdaa
+        float sunCosTheta = 2.0f * u - 1.0f;  // [0, 1] -> [-1, 1]
+        XMVECTOR sunDirection = XMVectorSet(0.0f, sunCosTheta, sinf(acosf(sunCosTheta)), 0.0f);
+
+        u32 sampleCount = 0;
+        XMStoreFloat4(&m_LUT.At(x, y), XMVectorSetW(CalculateTransmittance(atmos, rayPosition, sunDirection, &sampleCount), 1.0f));
+
+        totalSampleCount += sampleCount;
+    }
+
+    m_SampleCount += totalSampleCount;
+}
\ No newline at end of file
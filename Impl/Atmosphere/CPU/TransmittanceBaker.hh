@@ -0,0 +1,51 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Core/ThreadPool.hh"
+
+#include "Atmosphere.hh"
+#include "LUT.hh"
+#include "OpticalDepth.hh"
+
+/// CPU version of `Atmos/Transmittance.hlsl`, used when there is no D3D11 device around.
+class TransmittanceBaker
+{
+public:
+    void Init(u32 width, u32 height, const IntegratorSettings &settings = {});
+
+    /// Rows are split across `pPool`, runs on the calling thread if `pPool` is null
+    void Bake(const Atmosphere &atmos, ThreadPool *pPool);
+
+    /// Bakes rows [begin, end) into the LUT
+    void BakeRows(const Atmosphere &atmos, u32 begin, u32 end);
+
+    /// Bakes texels [begin, end) in row-major order, for callers that spread a bake across frames.
+    /// A row of the default LUT takes milliseconds, too long for one slice of a small frame budget.
+    void BakeTexels(const Atmosphere &atmos, u32 begin, u32 end);
+
+    /// `pSampleCount` receives the number of extinction evaluations if not null
+    XMVECTOR CalculateTransmittance(const Atmosphere &atmos, XMVECTOR rayPosition, XMVECTOR sunDirection, u32 *pSampleCount = nullptr);
+
+public:
+    LUT2D &GetLUT()
+    {
+        return m_LUT;
+    }
+
+    /// Extinction evaluations done by last `Bake`
+    u64 GetSampleCount()
+    {
+        return m_SampleCount.load();
+    }
+
+private:
+    XMVECTOR IntegrateUniform(const Atmosphere &atmos, XMVECTOR rayPosition, XMVECTOR sunDirection, float distance);
+
+    LUT2D m_LUT;
+    IntegratorSettings m_Settings;
+
+    eastl::atomic<u64> m_SampleCount = 0;
+};
\ No newline at end of file
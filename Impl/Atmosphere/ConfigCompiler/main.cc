@@ -0,0 +1,39 @@
+#include "Scripting/ffdDocument.hh"
+#include "Utils/Timer.hh"
+
+using namespace lr;
+
+/// Compiles a text ffd file into a blob that `ffdDocument::FromBinaryFile` maps without parsing.
+///
+/// Usage: AtmosphereConfigCompiler <input.ffd> <output.ffdb>
+
+int main(int argc, char **argv)
+{
+    Logger::Init();
+
+    if (argc < 3)
+    {
+        printf("Usage: %s <input.ffd> <output.ffdb>\n", argv[0]);
+        return 1;
+    }
+
+    Timer timer;
+
+    // A syntax error would otherwise compile the part before it
+    ffdDocument document;
+    if (!document.FromFile(argv[1]))
+    {
+        LOG_WARN("Couldn't load {}, nothing was written.", argv[1]);
+        return 1;
+    }
+
+    if (!document.WriteBinary(argv[2])) return 1;
+
+    // Load it back the same way the runtime does
+    ffdDocument compiled;
+    if (!compiled.FromBinaryFile(argv[2])) return 1;
+
+    LOG_INFO("Compiled {} into {} ({} bytes) in {:.2f}ms.", argv[1], argv[2], compiled.GetMemorySize(), timer.elapsed() * 1e3);
+
+    return 0;
+}
\ No newline at end of file
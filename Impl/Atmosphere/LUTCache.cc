@@ -0,0 +1,93 @@
+#include "LUTCache.hh"
+
+#include "Core/BaseApp.hh"
+
+#include "IO/BufferStream.hh"
+#include "IO/FileStream.hh"
+#include "IO/MappedFile.hh"
+
+#include <filesystem>
+
+void LUTCache::Init(eastl::string_view directory)
+{
+    m_Directory = directory;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory.c_str(), error);
+
+    if (error) LOG_WARN("Couldn't create LUT cache directory {}, LUTs won't be cached.", m_Directory);
+}
+
+bool LUTCache::Load(u64 key, Texture *pTexture)
+{
+    MappedFile file(GetPath(key));
+    if (!file.IsOK()) return false;
+
+    if (file.GetSize() < sizeof(Header)) return false;
+
+    const Header *pHeader = (const Header *)file.GetData();
+    if (pHeader->Magic != Header::kMagic || pHeader->Version != Header::kVersion || pHeader->Key != key) return false;
+    if (file.GetSize() < sizeof(Header) + pHeader->DataSize) return false;
+
+    TextureFormat format = (TextureFormat)pHeader->Format;
+    if (pHeader->DataSize != pHeader->Width * pHeader->Height * TextureFormatToSize(format)) return false;
+
+    LOG_TRACE("Loading LUT {:016x} from cache...", key);
+
+    TextureDesc desc;
+    desc.Type = TextureType::Default;
+
+    // Upload copies, texels don't need to outlive the mapping
+    TextureData data;
+    data.Width = pHeader->Width;
+    data.Height = pHeader->Height;
+    data.Format = format;
+    data.DataSize = pHeader->DataSize;
+    data.Data = (u8 *)(pHeader + 1);
+
+    pTexture->Delete();
+    pTexture->Init(&desc, &data);
+
+    return true;
+}
+
+void LUTCache::Store(u64 key, Texture *pTexture)
+{
+    if (m_Directory.empty()) return;
+
+    Header header;
+    header.Key = key;
+    header.Width = pTexture->GetWidth();
+    header.Height = pTexture->GetHeight();
+    header.Format = (u32)pTexture->GetFormat();
+    header.DataSize = header.Width * header.Height * TextureFormatToSize(pTexture->GetFormat());
+
+    BufferStream buffer(sizeof(Header) + header.DataSize);
+    buffer.Assign(header);
+
+    GetApp()->GetAPI()->ReadGPUTexture(pTexture, buffer.GetOffsetPtr());
+
+    // Write next to the entry and rename, a crash mid-write must not leave a valid looking entry
+    eastl::string path = GetPath(key);
+    eastl::string tempPath = path + ".tmp";
+
+    FileStream file(tempPath, true);
+    if (!file.IsOK())
+    {
+        LOG_WARN("Couldn't write LUT cache entry {}.", tempPath);
+        return;
+    }
+
+    file.WritePtr(buffer.GetData(), buffer.GetSize());
+    file.Close();
+
+    std::error_code error;
+    std::filesystem::rename(tempPath.c_str(), path.c_str(), error);
+
+    if (error) LOG_WARN("Couldn't write LUT cache entry {}.", path);
+}
+
+eastl::string LUTCache::GetPath(u64 key)
+{
+    return Format("{}/{:016x}.lut", m_Directory, key);
+}
\ No newline at end of file
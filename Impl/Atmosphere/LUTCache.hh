@@ -0,0 +1,44 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Graphics/D3D11/D3D11Texture.hh"
+
+using namespace lr;
+
+/// Content addressed store for baked LUTs, every entry is `<directory>/<key>.lut`.
+/// Key has to cover everything that affects the texels (params, resolution, shader source),
+/// entries are never overwritten or invalidated.
+class LUTCache
+{
+public:
+    void Init(eastl::string_view directory);
+
+    /// Maps the entry and uploads it into `pTexture`, returns false on miss
+    bool Load(u64 key, Texture *pTexture);
+
+    /// Reads `pTexture` back from GPU and writes it as a new entry
+    void Store(u64 key, Texture *pTexture);
+
+private:
+    struct Header
+    {
+        static constexpr u32 kMagic = 0x4354554c;  // LUTC
+        static constexpr u32 kVersion = 1;
+
+        u32 Magic = kMagic;
+        u32 Version = kVersion;
+        u64 Key = 0;
+
+        u32 Width = 0;
+        u32 Height = 0;
+        u32 Format = 0;
+        u32 DataSize = 0;
+    };
+
+    eastl::string GetPath(u64 key);
+
+    eastl::string m_Directory;
+};
\ No newline at end of file
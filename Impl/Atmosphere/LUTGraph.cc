@@ -0,0 +1,37 @@
+#include "LUTGraph.hh"
+
+#include "Utils/Hash.hh"
+
+using namespace lr;
+
+void LUTGraph::SetInputs(LUTStage stage, u64 inputHash)
+{
+    u32 index = (u32)stage;
+    u64 parentHash = index > 0 ? m_Hashes[index - 1] : Hash::kFNV64Offset;
+
+    m_Hashes[index] = Hash::FNV64(inputHash, parentHash);
+}
+
+bool LUTGraph::IsDirty(LUTStage stage)
+{
+    u32 index = (u32)stage;
+    return !m_Baked[index] || m_BakedHashes[index] != m_Hashes[index];
+}
+
+void LUTGraph::MarkBaked(LUTStage stage)
+{
+    MarkBaked(stage, m_Hashes[(u32)stage]);
+}
+
+void LUTGraph::MarkBaked(LUTStage stage, u64 hash)
+{
+    u32 index = (u32)stage;
+
+    m_Baked[index] = true;
+    m_BakedHashes[index] = hash;
+}
+
+void LUTGraph::Invalidate()
+{
+    m_Baked.fill(false);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+enum class LUTStage : u8
+{
+    Transmittance,
+    MultiScatter,
+    SkyView,
+
+    Count
+};
+
+/// Atmosphere params -> Transmittance -> MultiScatter -> SkyView
+/// Each stage's hash is its own inputs chained with the previous stage's hash, so a change
+/// dirties that stage and everything after it, never the ones before.
+class LUTGraph
+{
+public:
+    /// Has to be called for every stage in order, every time inputs may have changed
+    void SetInputs(LUTStage stage, u64 inputHash);
+
+    bool IsDirty(LUTStage stage);
+    void MarkBaked(LUTStage stage);
+
+    /// Records `hash` instead of the current one, for bakes spread over frames while inputs kept changing
+    void MarkBaked(LUTStage stage, u64 hash);
+
+    /// Forces every stage to rebake, ie. after resources are recreated
+    void Invalidate();
+
+public:
+    u64 GetHash(LUTStage stage)
+    {
+        return m_Hashes[(u32)stage];
+    }
+
+private:
+    eastl::array<u64, (u32)LUTStage::Count> m_Hashes = {};
+    eastl::array<u64, (u32)LUTStage::Count> m_BakedHashes = {};
+    eastl::array<bool, (u32)LUTStage::Count> m_Baked = {};
+};
\ No newline at end of file
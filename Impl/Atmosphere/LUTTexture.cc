@@ -0,0 +1,28 @@
+#include "LUTTexture.hh"
+
+void GetTextureData(LUT2D &lut, TextureData &data)
+{
+    data.Width = lut.Width;
+    data.Height = lut.Height;
+    data.Format = TextureFormat::RGBA32F;
+    data.DataSize = lut.Texels.size() * sizeof(XMFLOAT4);
+    data.Data = (u8 *)lut.Texels.data();
+}
+
+void GetTextureData(PackedLUT2D &lut, TextureData &data)
+{
+    data.Width = lut.Width;
+    data.Height = lut.Height;
+    data.Format = lut.Format;
+    data.DataSize = lut.Data.size();
+    data.Data = lut.Data.data();
+}
+
+void GetTextureData(ImageRGBA8 &image, TextureData &data)
+{
+    data.Width = image.Width;
+    data.Height = image.Height;
+    data.Format = TextureFormat::RGBA8;
+    data.DataSize = image.Pixels.size() * sizeof(u32);
+    data.Data = (u8 *)image.Pixels.data();
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+//
+// Created on Sunday 18th October 2026 by e-erdal
+//
+
+#pragma once
+
+#include "Graphics/D3D11/D3D11Texture.hh"
+
+#include "CPU/FinalPass.hh"
+#include "CPU/LUT.hh"
+#include "CPU/LUTFormat.hh"
+
+/// Upload views of the CPU side images, `AtmosphereCPU` itself doesn't know about textures.
+/// Data pointers are owned by the source, keep it alive until the texture is created.
+void GetTextureData(LUT2D &lut, TextureData &data);
+void GetTextureData(PackedLUT2D &lut, TextureData &data);
+void GetTextureData(ImageRGBA8 &image, TextureData &data);
\ No newline at end of file
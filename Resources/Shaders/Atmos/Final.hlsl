@@ -1,8 +1,10 @@
-#include "Resources/Shaders/Atmos/Common.hlsl"
+#include "Resources/Shaders/Atmos/Raymarch.hlsl"
 
 Texture2D       SkyLUT  : register(t0);
 Texture2D Transmittance : register(t1);
-SamplerState    SkySampler;
+Texture2D  MultiScatter : register(t2);
+SamplerState    SkySampler : register(s0);
+SamplerState LinearSampler : register(s1);
 
 cbuffer __ : register(b1)
 {
@@ -18,6 +20,7 @@ cbuffer _2 : register(b2)
     float SunRadius;
     float3 SunDirection;
     float SunIntensity;
+    float StepCount;
 }
 
 struct PSInput
@@ -78,15 +81,28 @@ float4 PSMain(PSInput input) : SV_TARGET
         input.TexCoord.y)
     );
 
-    float l = asin(direction.y);
-    float u = atan2(direction.z, direction.x) / (2.0 * PI);
-    float v = 0.5 - 0.5 * sign(l) * sqrt(abs(l) / (0.5 * PI));
+    float3 color = float3(0.0, 0.0, 0.0);
+
+    if (length(EyePosition) < AtmosRadius)
+    {
+        float l = asin(direction.y);
+        float u = atan2(direction.z, direction.x) / (2.0 * PI);
+        float v = 0.5 - 0.5 * sign(l) * sqrt(abs(l) / (0.5 * PI));
+
+        color = SkyLUT.Sample(SkySampler, float2(u, v)).rgb;
+    }
+    else
+    {
+        // Sky-view LUT is parameterized around an eye inside the atmosphere, march every pixel from the entry point instead
+        float3 origin = EyePosition;
+        if (MoveToTopAtmosphere(origin, direction))
+            color = SunIntensity * RaymarchScattering(Transmittance, MultiScatter, LinearSampler, origin, direction, SunDirection, StepCount);
+    }
 
-    float3 color = SkyLUT.Sample(SkySampler, float2(u, v)).rgb;
     color = ACES(color);
     color = FixHDR(input.TexCoord, color);
 
     color += GetSun(direction, SunDirection);
 
     return float4(color, 1.0);
-}
+}
\ No newline at end of file
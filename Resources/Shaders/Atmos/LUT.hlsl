@@ -1,4 +1,4 @@
-#include "Resources/Shaders/Atmos/Common.hlsl"
+#include "Resources/Shaders/Atmos/Raymarch.hlsl"
 
 Texture2D TransmittanceLut  : register(t0);
 Texture2D MultiScatterLut   : register(t1);
@@ -57,58 +57,7 @@ float4 PSMain(VSLayout input) : SV_TARGET
         cosAltitude * sin(azimuthAngle)
     );
     
-    // Get Rayleigh + Mie phase
-    float cosTheta = dot(rayDirection, SunDirection);
-    float rayleighPhase = GetRayleighPhase(-cosTheta);
-    float miePhase = GetMiePhase(cosTheta);
-    
-    float3 luminance = float3(0.0, 0.0, 0.0);
-    float3 transmittance = float3(1.0, 1.0, 1.0);
-    
-    // Raymarching
-    float maxDist = 0.0;
-    if (!GetQuadraticIntersection3D(EyePosition, rayDirection, PlanetRadius, maxDist))
-        GetQuadraticIntersection3D(EyePosition, rayDirection, AtmosRadius, maxDist);
-    
-    float stepSize = maxDist / StepCount;
-    float t = 0.0;
-    for (float i = 0.0; i < StepCount; i += 1.0)
-    {
-        float nextT = stepSize * i;
-        float deltaT = nextT - t;
-        t = nextT;
-        
-        float3 stepPosition = EyePosition + t * rayDirection;
-        
-        h = length(stepPosition);
-        
-        // Altitude from ground to top atmosphere
-        float altitude = h - PlanetRadius;
-        float3 extinction = GetExtinctionSum(altitude);
-        float3 altitudeTrans = exp(-deltaT * extinction);
-        
-        // Shadowing factor
-        float sunTheta = dot(SunDirection, stepPosition / h);
-        float3 sunTrans = SampleLUT(TransmittanceLut, LinearSampler, altitude, sunTheta);
-        float3 MS = SampleLUT(MultiScatterLut, LinearSampler, altitude, sunTheta);
-        
-        // Get scattering coefficient
-        float3 rayleighScat;
-        float mieScat;
-        GetScattering(altitude, rayleighScat, mieScat);
-        
-        // Molecules scattered on ray's position
-        float3 rayleighInScat = rayleighScat * (rayleighPhase + MS);
-        float3 mieInScat = mieScat * (miePhase + MS);
-        float3 scatteringPhase = (rayleighInScat + mieInScat) * sunTrans;
-
-        // https://www.ea.com/frostbite/news/physically-based-unified-volumetric-rendering-in-frostbite
-        // slide 28
-        float3 integral = (scatteringPhase - scatteringPhase * altitudeTrans) / extinction;
-
-        luminance += SunIntensity * (integral * transmittance);
-        transmittance *= altitudeTrans;
-    }
+    float3 luminance = RaymarchScattering(TransmittanceLut, MultiScatterLut, LinearSampler, EyePosition, rayDirection, SunDirection, StepCount);
 
-    return float4(luminance, 1.0);
+    return float4(SunIntensity * luminance, 1.0);
 }
\ No newline at end of file
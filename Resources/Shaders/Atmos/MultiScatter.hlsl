@@ -5,6 +5,7 @@ EntryCS = "CSMain"
 _OverrideSettings_
 
 #include "Resources/Shaders/Atmos/Common.hlsl"
+#include "Resources/Shaders/Atmos/Slice.hlsl"
 
 cbuffer ___ : register(b1)
 {
@@ -135,13 +136,17 @@ float3 ComputeSample(float3 rayPos, float3 sunDir)
 }
 
 [numthreads(16, 16, 1)]
-void CSMain(int3 threadID : SV_DISPATCHTHREADID)
+void CSMain(uint3 groupID : SV_GROUPID, uint3 groupThreadID : SV_GROUPTHREADID)
 {
-    int width, height;
+    uint width, height;
     MultiScattering.GetDimensions(width, height);
 
-    float u = float(threadID.x) / width;
-    float v = float(threadID.y) / height;
+    uint2 texel = GetSliceTexel(groupID, groupThreadID);
+    if (texel.x >= width || texel.y >= height)
+        return;
+
+    float u = float(texel.x) / width;
+    float v = float(texel.y) / height;
 
     float h = lerp(PlanetRadius, AtmosRadius, v);
     float3 rayPosition = float3(0.0, h, 0.0);
@@ -150,5 +155,5 @@ void CSMain(int3 threadID : SV_DISPATCHTHREADID)
     float sunCosTheta = 2.0 * u - 1.0;  // [0, 1] -> [-1, 1]
     float3 sunDirection = float3(0.0, sunCosTheta, sin(acos(sunCosTheta)));
 
-    MultiScattering[threadID.xy] = float4(ComputeSample(rayPosition, sunDirection), 1.0);
+    MultiScattering[texel] = float4(ComputeSample(rayPosition, sunDirection), 1.0);
 }
\ No newline at end of file
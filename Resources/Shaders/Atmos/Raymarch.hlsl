@@ -0,0 +1,83 @@
+#include "Resources/Shaders/Atmos/Common.hlsl"
+
+// Entry point is pushed this far below the top, so the march starts inside the atmosphere
+#define TOP_ATMOSPHERE_OFFSET 10.0
+
+// Moves `origin` to where `direction` enters the atmosphere, returns false if the ray misses it.
+// Origins already inside are left untouched.
+bool MoveToTopAtmosphere(inout float3 origin, float3 direction)
+{
+    float h = length(origin);
+    if (h < AtmosRadius)
+        return true;
+
+    float t = 0.0;
+    if (!GetQuadraticIntersection3D(origin, direction, AtmosRadius, t))
+        return false;
+
+    float3 up = origin / h;
+    origin += direction * t - up * TOP_ATMOSPHERE_OFFSET;
+
+    return true;
+}
+
+// Single scattering + multi scattering LUT along the ray, origin has to be inside the atmosphere.
+// Sun intensity is left to the caller.
+float3 RaymarchScattering(Texture2D transmittanceLut, Texture2D multiScatterLut, SamplerState linearSampler, float3 origin, float3 rayDirection,
+                          float3 sunDirection, float stepCount)
+{
+    // Get Rayleigh + Mie phase
+    float cosTheta = dot(rayDirection, sunDirection);
+    float rayleighPhase = GetRayleighPhase(-cosTheta);
+    float miePhase = GetMiePhase(cosTheta);
+
+    float3 luminance = float3(0.0, 0.0, 0.0);
+    float3 transmittance = float3(1.0, 1.0, 1.0);
+
+    // Raymarching
+    float maxDist = 0.0;
+    if (!GetQuadraticIntersection3D(origin, rayDirection, PlanetRadius, maxDist))
+        GetQuadraticIntersection3D(origin, rayDirection, AtmosRadius, maxDist);
+
+    float stepSize = maxDist / stepCount;
+    float t = 0.0;
+    for (float i = 0.0; i < stepCount; i += 1.0)
+    {
+        float nextT = stepSize * i;
+        float deltaT = nextT - t;
+        t = nextT;
+
+        float3 stepPosition = origin + t * rayDirection;
+
+        float h = length(stepPosition);
+
+        // Altitude from ground to top atmosphere
+        float altitude = h - PlanetRadius;
+        float3 extinction = GetExtinctionSum(altitude);
+        float3 altitudeTrans = exp(-deltaT * extinction);
+
+        // Shadowing factor
+        float sunTheta = dot(sunDirection, stepPosition / h);
+        float3 sunTrans = SampleLUT(transmittanceLut, linearSampler, altitude, sunTheta);
+        float3 MS = SampleLUT(multiScatterLut, linearSampler, altitude, sunTheta);
+
+        // Get scattering coefficient
+        float3 rayleighScat;
+        float mieScat;
+        GetScattering(altitude, rayleighScat, mieScat);
+
+        // Molecules scattered on ray's position
+        float3 rayleighInScat = rayleighScat * (rayleighPhase + MS);
+        float3 mieInScat = mieScat * (miePhase + MS);
+        float3 scatteringPhase = (rayleighInScat + mieInScat) * sunTrans;
+
+        // https://www.ea.com/frostbite/news/physically-based-unified-volumetric-rendering-in-frostbite
+        // slide 28
+        float3 integral = (scatteringPhase - scatteringPhase * altitudeTrans) / extinction;
+
+        luminance += integral * transmittance;
+        transmittance *= altitudeTrans;
+    }
+
+    return luminance;
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+// LUT compute passes are dispatched as a 1D range of 16x16 tiles, amortized updates
+// spread a bake across frames by dispatching a few tiles at a time (see `LUTUpdateScheduler`)
+#define SLICE_TILE_SIZE 16
+
+cbuffer _Slice : register(b2)
+{
+    uint TileOffset;
+    uint TileCountX;
+}
+
+// Texel of this thread, can be past the edge when the texture isn't a multiple of the tile size
+uint2 GetSliceTexel(uint3 groupID, uint3 groupThreadID)
+{
+    uint tile = TileOffset + groupID.x;
+    return uint2(tile % TileCountX, tile / TileCountX) * SLICE_TILE_SIZE + groupThreadID.xy;
+}
\ No newline at end of file
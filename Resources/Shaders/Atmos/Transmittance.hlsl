@@ -7,6 +7,7 @@ _OverrideSettings_
 #define STEP_COUNT 1000.0
 
 #include "Resources/Shaders/Atmos/Common.hlsl"
+#include "Resources/Shaders/Atmos/Slice.hlsl"
 
 RWTexture2D<float4> Transmittance : register(u0);
 
@@ -38,13 +39,17 @@ float3 CalculateTransmittance(float3 rayPosition, float3 sunDirection)
 }
 
 [numthreads(16, 16, 1)]
-void CSMain(int3 threadID : SV_DISPATCHTHREADID)
+void CSMain(uint3 groupID : SV_GROUPID, uint3 groupThreadID : SV_GROUPTHREADID)
 {
-    int width, height;
+    uint width, height;
     Transmittance.GetDimensions(width, height);
 
-    float u = float(threadID.x) / width;
-    float v = float(threadID.y) / height;
+    uint2 texel = GetSliceTexel(groupID, groupThreadID);
+    if (texel.x >= width || texel.y >= height)
+        return;
+
+    float u = float(texel.x) / width;
+    float v = float(texel.y) / height;
 
     float h = lerp(PlanetRadius, AtmosRadius, v);
     float3 rayPosition = float3(0.0, h, 0.0);
@@ -53,5 +58,5 @@ void CSMain(int3 threadID : SV_DISPATCHTHREADID)
     float sunCosTheta = 2.0 * u - 1.0;  // [0, 1] -> [-1, 1]
     float3 sunDirection = float3(0.0, sunCosTheta, sin(acos(sunCosTheta)));
 
-    Transmittance[threadID.xy] = float4(CalculateTransmittance(rayPosition, sunDirection), 1);
+    Transmittance[texel] = float4(CalculateTransmittance(rayPosition, sunDirection), 1);
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+_OverrideSettings_
+
+EntryCS = "CSMain"
+
+_OverrideSettings_
+
+#include "Resources/Shaders/Atmos/Common.hlsl"
+#include "Resources/Shaders/Atmos/Slice.hlsl"
+
+RWTexture2D<float4> Transmittance : register(u0);
+
+cbuffer __ : register(b1)
+{
+    float RelativeError;
+    uint MinSteps;
+    uint MaxSteps;
+    uint _padding;
+}
+
+// Extinction * dt/ds, t = denseT + dirSign * segmentLength * s^2 puts more samples at the low (dense) end
+float3 GetSegmentSample(float3 origin, float3 direction, float denseT, float segmentLength, float dirSign, float s)
+{
+    float t = denseT + dirSign * segmentLength * s * s;
+    float altitude = length(origin + t * direction) - PlanetRadius;
+
+    return GetExtinctionSum(altitude) * (2.0 * segmentLength * s);
+}
+
+// Trapezoid sums refined by doubling until Richardson error estimate is below RelativeError, returns Simpson value
+// Keep in sync with `CPU/OpticalDepth.cc`
+float3 IntegrateSegment(float3 origin, float3 direction, float denseT, float segmentLength, float dirSign)
+{
+    if (segmentLength <= 0.0)
+        return float3(0.0, 0.0, 0.0);
+
+    uint intervals = max(MinSteps, 1);
+
+    // f(0) = 0 because dt/ds = 0 there
+    float3 interior = float3(0.0, 0.0, 0.0);
+    for (uint i = 1; i < intervals; i++)
+        interior += GetSegmentSample(origin, direction, denseT, segmentLength, dirSign, float(i) / intervals);
+
+    float3 last = GetSegmentSample(origin, direction, denseT, segmentLength, dirSign, 1.0);
+
+    float3 trapezoid = (interior + 0.5 * last) / intervals;
+    float3 result = trapezoid;
+
+    while (intervals * 2 <= MaxSteps)
+    {
+        // New samples are midpoints of current intervals
+        for (uint j = 0; j < intervals; j++)
+            interior += GetSegmentSample(origin, direction, denseT, segmentLength, dirSign, (j + 0.5) / intervals);
+
+        intervals *= 2;
+
+        float3 refined = (interior + 0.5 * last) / intervals;
+        float3 error = abs(refined - trapezoid) / 3.0;
+
+        result = refined + (refined - trapezoid) / 3.0;
+        trapezoid = refined;
+
+        if (all(error <= RelativeError * refined))
+            break;
+    }
+
+    return result;
+}
+
+float3 CalculateTransmittance(float3 rayPosition, float3 sunDirection)
+{
+    // We need to check if ray hits planet first. 
+    if (SolveQuadratic(rayPosition, sunDirection, PlanetRadius))
+    {
+        return float3(0.0, 0.0, 0.0);
+    }
+
+    float distance = 0.0;
+    GetQuadraticIntersection3D(rayPosition, sunDirection, AtmosRadius, distance);
+
+    // Closest point to planet center, altitude is monotonic on both sides of it
+    float lowestT = clamp(-dot(rayPosition, sunDirection), 0.0, distance);
+
+    float3 opticalDepth = IntegrateSegment(rayPosition, sunDirection, lowestT, lowestT, -1.0);
+    opticalDepth += IntegrateSegment(rayPosition, sunDirection, lowestT, distance - lowestT, 1.0);
+
+    return exp(-opticalDepth);
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 groupID : SV_GROUPID, uint3 groupThreadID : SV_GROUPTHREADID)
+{
+    uint width, height;
+    Transmittance.GetDimensions(width, height);
+
+    uint2 texel = GetSliceTexel(groupID, groupThreadID);
+    if (texel.x >= width || texel.y >= height)
+        return;
+
+    float u = float(texel.x) / width;
+    float v = float(texel.y) / height;
+
+    float h = lerp(PlanetRadius, AtmosRadius, v);
+    float3 rayPosition = float3(0.0, h, 0.0);
+    
+    // https://www.desmos.com/calculator/guspypmdaa
+    float sunCosTheta = 2.0 * u - 1.0;  // [0, 1] -> [-1, 1]
+    float3 sunDirection = float3(0.0, sunCosTheta, sin(acos(sunCosTheta)));
+
+    Transmittance[texel] = float4(CalculateTransmittance(rayPosition, sunDirection), 1);
+}
\ No newline at end of file